@@ -20,6 +20,7 @@ public class ChannelMixer : ModuleRules
                 "RenderCore",
                 "EnchancedEditorLogging",
                 "InputCore", "MaskTools",
+                "MaskToolsCore",
             }
             );
 
@@ -35,6 +36,7 @@ public class ChannelMixer : ModuleRules
                 "ToolMenus",
                 "UnrealEd",
                 "Projects",
+                "DesktopPlatform",
                 "MaskTools"
             }
             );
@@ -2,10 +2,18 @@
 // All rights reserved.
 
 #include "ChannelMixer.h"
+#include "Algo/AllOf.h"
 
 #include "ChannelMixerUI.h"
 #include "ChannelMixerUtils.h"
+#include "MaskRecipe.h"
 #include "MaskToolsUtils.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsImageFiles.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsPipeline.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsStats.h"
 
 #include "ChannelMixerEnums.h"
 
@@ -14,9 +22,9 @@
 
 #include "ChannelMixerStyle.h"
 #include "ContentBrowserModule.h"
+#include "DesktopPlatformModule.h"
 #include "EnchancedNotifications.h"
 #include "IContentBrowserSingleton.h"
-#include "ImageUtils.h"
 #include "Kismet/KismetMaterialLibrary.h"
 #include "Kismet/KismetRenderingLibrary.h"
 
@@ -42,6 +50,12 @@ void FChannelMixer::StartupModule()
 void FChannelMixer::ShutdownModule()
 {
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner("TextureMixerTab");
+
+    if (PreviewRenderTarget && UObjectInitialized())
+    {
+        PreviewRenderTarget->RemoveFromRoot();
+        PreviewRenderTarget = nullptr;
+    }
     
     ChannelMixerStyle::ShutDown();
 }
@@ -98,9 +112,7 @@ void FChannelMixer::InitializeData()
     NameHintText = TextureName;
     SuffixHintText = Config->DefaultMaskSuffix;
 
-    const UEnum* EnumPtr = StaticEnum<EMaskResolutions>();
-    FText defaultResString = EnumPtr->GetDisplayNameTextByValue(static_cast<int64>(Config->DefaultMaskResolution));
-    TextureResolution = FChannelMixerUtils::ResFinder(defaultResString.ToString());
+    TextureSizeX = TextureSizeY = FMaskToolsPrivateHelpers::FindResolution(Config->DefaultMaskResolution);
     
     RedBrush = MakeShared<FSlateBrush>();
     GreenBrush = MakeShared<FSlateBrush>();
@@ -189,6 +201,123 @@ FReply FChannelMixer::TryImportTexture(EChannelMixerChannel Channel)
     return FReply::Handled();
 }
 
+FReply FChannelMixer::TryImportFile(EChannelMixerChannel Channel)
+{
+    TArray<FString> FilePaths;
+    if (OpenImageFileDialog(false, FilePaths))
+    {
+        SetChannelSourceFiles(FilePaths, Channel);
+    }
+
+    return FReply::Handled();
+}
+
+FReply FChannelMixer::ImportFilesToSlots()
+{
+    TArray<FString> FilePaths;
+    if (!OpenImageFileDialog(true, FilePaths))
+    {
+        return FReply::Handled();
+    }
+
+    if (FilePaths.Num() > 4)
+    {
+        UEnchancedNotifications::LaunchNotification(FString::Printf(TEXT("Only the first 4 of %d selected files were imported"), FilePaths.Num()));
+        FilePaths.SetNum(4);
+    }
+
+    SetChannelSourceFiles(FilePaths, EChannelMixerChannel::Red);
+    return FReply::Handled();
+}
+
+bool FChannelMixer::OpenImageFileDialog(bool bMultiple, TArray<FString>& OutFilePaths)
+{
+    IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+    if (!DesktopPlatform)
+    {
+        return false;
+    }
+
+    const void* ParentWindowHandle = FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr);
+    return DesktopPlatform->OpenFileDialog(
+        ParentWindowHandle,
+        bMultiple ? TEXT("Import image files") : TEXT("Import image file"),
+        FPaths::ProjectDir(),
+        TEXT(""),
+        TEXT("Image files (*.png;*.tga;*.exr;*.jpg;*.jpeg;*.bmp;*.tif;*.tiff)|*.png;*.tga;*.exr;*.jpg;*.jpeg;*.bmp;*.tif;*.tiff"),
+        bMultiple ? EFileDialogFlags::Multiple : EFileDialogFlags::None,
+        OutFilePaths) && OutFilePaths.Num() > 0;
+}
+
+void FChannelMixer::SetChannelSourceFiles(TArrayView<const FString> FilePaths, EChannelMixerChannel FirstChannel)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelMixer::SetChannelSourceFiles);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    // Every file is decoded at once, each on its own worker
+    TArray<FImage> Images;
+    const int32 NumLoaded = FMaskToolsImageFiles::LoadImages(FilePaths, Images);
+
+    for (int32 FileIndex = 0; FileIndex < FilePaths.Num(); ++FileIndex)
+    {
+        const int32 SlotIndex = static_cast<int32>(FirstChannel) + FileIndex;
+        if (SlotIndex > static_cast<int32>(EChannelMixerChannel::Alpha))
+        {
+            break;
+        }
+
+        if (Images[FileIndex].RawData.IsEmpty())
+        {
+            UEnchancedNotifications::LaunchNotification(FString::Printf(TEXT("Failed to read %s"), *FPaths::GetCleanFilename(FilePaths[FileIndex])));
+            continue;
+        }
+
+        const EChannelMixerChannel Channel = static_cast<EChannelMixerChannel>(SlotIndex);
+        ClearChannelSourceFile(Channel);
+
+        SetNewChannelTexture(FChannelMixerUtils::CreateThumbnailTexture(Images[FileIndex]), Channel);
+        SetChannelAssetData(FAssetData(), Channel);
+
+        ChannelSourceFiles[SlotIndex] = FilePaths[FileIndex];
+        ChannelSourceImages[SlotIndex] = MoveTemp(Images[FileIndex]);
+    }
+
+    UE_LOG(LogChannelMixer, Log, TEXT("Imported %d of %d image files"), NumLoaded, FilePaths.Num());
+
+    if (NumLoaded > 0)
+    {
+        RegeneratePreviewTexture();
+    }
+}
+
+void FChannelMixer::ClearChannelSourceFile(EChannelMixerChannel Channel)
+{
+    const int32 SlotIndex = static_cast<int32>(Channel);
+    if (SlotIndex > static_cast<int32>(EChannelMixerChannel::Alpha) || ChannelSourceFiles[SlotIndex].IsEmpty())
+    {
+        return;
+    }
+
+    // The slot texture is the rooted thumbnail of the file
+    if (UTexture2D* Thumbnail = GetChannelTexture(Channel))
+    {
+        Thumbnail->RemoveFromRoot();
+    }
+
+    ChannelSourceFiles[SlotIndex].Empty();
+    ChannelSourceImages[SlotIndex] = FImage();
+}
+
+bool FChannelMixer::HasChannelSourceFiles() const
+{
+    for (const FString& SourceFile : ChannelSourceFiles)
+    {
+        if (!SourceFile.IsEmpty()) return true;
+    }
+
+    return false;
+}
+
 bool FChannelMixer::ImportTextureFromCB(EChannelMixerChannel Channel)
 {
 
@@ -233,8 +362,27 @@ bool FChannelMixer::ImportTextureFromAssetPicker(EChannelMixerChannel Channel)
     return false;
 }
 
+EResizeMethod& FChannelMixer::GetResizeMethod(EChannelMixerTextureChannel Channel)
+{
+    switch (Channel)
+    {
+    case EChannelMixerTextureChannel::Green:
+        return GreenResizeMethod;
+    case EChannelMixerTextureChannel::Blue:
+        return BlueResizeMethod;
+    case EChannelMixerTextureChannel::Alpha:
+        return AlphaResizeMethod;
+    case EChannelMixerTextureChannel::Red:
+    default:
+        return RedResizeMethod;
+    }
+}
+
 void FChannelMixer::RegeneratePreviewTexture()
 {
+    LLM_SCOPE_BYTAG(MaskTools);
+    FMaskToolsPeakMemoryTracker MemoryTracker;
+
     // const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
     // switch (Config->MixerCreationMethod)
     EMaskCreationMethod TempFixedMethod = EMaskCreationMethod::PixelData;
@@ -245,104 +393,161 @@ void FChannelMixer::RegeneratePreviewTexture()
             break;
 
         case EMaskCreationMethod::Material:
-            RegeneratePreviewTextureMaterial();
+            // Image file slots only have a thumbnail texture to sample
+            if (HasChannelSourceFiles())
+            {
+                RegeneratePreviewTexturePixelData();
+            }
+            else
+            {
+                RegeneratePreviewTextureMaterial();
+            }
             break;
         
         default:
             RegeneratePreviewTexturePixelData();
     }
-    
+
+    const int64 PeakMemoryBytes = MemoryTracker.Stop();
+    UE_LOG(LogChannelMixer, Log, TEXT("Preview packed at %dx%d in %.2f s, peak working set %.1f MB"),
+        TextureSizeX, TextureSizeY, MemoryTracker.GetElapsedSeconds(), PeakMemoryBytes / (1024.0 * 1024.0));
 }
 
 void FChannelMixer::RegeneratePreviewTexturePixelData()
 {
-    TArray<FColor> RChannel, GChannel, BChannel, AChannel;
-    TArray<TArray<FColor>> ChannelData;
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelMixer::RegeneratePreviewTexturePixelData);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Pack preview %dx%d"), TextureSizeX, TextureSizeY);
 
-    auto GetTextureChannelData = [this] (UTexture2D* Texture, EChannelMixerTextureChannel SelectedChannel, EResizeMethod SelectedResizeMethod,  TArray<FColor>& ChannelData)
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    const EMaskPlaneFormat PlaneFormat = FMaskToolsPrivateHelpers::FindPlaneFormat(Config->MaskPrecision);
+
+    struct FSlotJob : public FMaskToolsPipelineJob
     {
-        TArray<FLinearColor> TexturePixelValues;
+        int32 SlotIndex = 0;
+        EMaskChannel Channel = EMaskChannel::Red;
+        EResizeMethod ResizeMethod = EResizeMethod::Default;
+        FString CacheKey;
+        FImage Image;
+        FImageView SourceView;
+        FMaskPlane* OutPlane = nullptr;
+        bool* bOutRead = nullptr;
+    };
 
-        EResizeMethod ResizeMethod;
-        if (SelectedResizeMethod == EResizeMethod::Default)
-        {
-            const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
-            ResizeMethod = Config->MixerResizeMethod;
-        }
-        else
-        {
-            ResizeMethod = SelectedResizeMethod;
-        }
-        
-        if (!FMaskToolsUtils::GetTexturePixelData(Texture, TextureResolution,  ResizeMethod, TexturePixelValues))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("Failed to get texture pixel data"));
-            return;
-        }
-        for (FLinearColor LinearPixelData : TexturePixelValues)
+    FMaskPlane Planes[4];
+    bool bPlanesRead[4] = {};
+
+    UTexture2D* SlotTextures[4] = { RedTexture, GreenTexture, BlueTexture, AlphaTexture };
+    const EChannelMixerTextureChannel SlotChannels[4] = { RedTextureSelectedChannel, GreenTextureSelectedChannel, BlueTextureSelectedChannel, AlphaTextureSelectedChannel };
+    const EResizeMethod SlotResizeMethods[4] = { RedResizeMethod, GreenResizeMethod, BlueResizeMethod, AlphaResizeMethod };
+
+    /*
+    * Source reads and cache lookups stay on the game thread while the slots already read are extracted on workers.
+    * The preview is needed right away, so the game thread waits for the pipeline instead of ticking it.
+    */
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Preview"));
+
+    Pipeline->AddStage(TEXT("Gather"), EMaskPipelineThread::GameThread, [this, &SlotTextures, PlaneFormat, InputColorSpace = Config->InputColorSpace](FMaskToolsPipelineJob& PipelineJob)
         {
-            FColor Color = LinearPixelData.ToFColor(true);
-            switch (SelectedChannel)
+            FSlotJob& Job = static_cast<FSlotJob&>(PipelineJob);
+
+            // Image files are already decoded in memory, the cache would only add a hash of the whole file
+            const FImage& SourceImage = ChannelSourceImages[Job.SlotIndex];
+            if (!ChannelSourceFiles[Job.SlotIndex].IsEmpty())
             {
-            case EChannelMixerTextureChannel::Red:
-                ChannelData.Add(FColor(Color.R, 0 ,0 ,0));
-                break;
-            case EChannelMixerTextureChannel::Green:
-                ChannelData.Add(FColor(Color.G, 0 ,0 ,0));
-                break;
-            case EChannelMixerTextureChannel::Blue:
-                ChannelData.Add(FColor(Color.B, 0 ,0 ,0));
-                break;
-            case EChannelMixerTextureChannel::Alpha:
-                ChannelData.Add(FColor(Color.A, 0 ,0 ,0));
-                break;
+                Job.SourceView = SourceImage;
+                Job.SourceView.GammaSpace = FMaskToolsPrivateHelpers::FindGammaSpace(InputColorSpace, SourceImage.GammaSpace);
+                return true;
+            }
+
+            // Masks are always packed linear, sRGB inputs are decoded while extracting
+            UTexture2D* Texture = SlotTextures[Job.SlotIndex];
+            const EGammaSpace SourceGamma = FMaskToolsPrivateHelpers::FindGammaSpace(InputColorSpace, FMaskToolsPrivateHelpers::FindTextureGammaSpace(Texture));
+            Job.CacheKey = FMaskToolsUtils::GetPlaneCacheKey(Texture, Job.Channel, TextureSizeX, TextureSizeY, Job.ResizeMethod,
+                PlaneFormat, EGammaSpace::Linear, SourceGamma);
+            if (FMaskToolsDiskCache::Get().Load(Job.CacheKey, *Job.OutPlane))
+            {
+                // Nothing left to extract, the job leaves the pipeline here
+                *Job.bOutRead = true;
+                return false;
             }
-        }
-    };
-    
-    GetTextureChannelData(RedTexture, RedTextureSelectedChannel, RedResizeMethod, RChannel);
-    GetTextureChannelData(GreenTexture, GreenTextureSelectedChannel, GreenResizeMethod, GChannel);
-    GetTextureChannelData(BlueTexture, BlueTextureSelectedChannel, BlueResizeMethod, BChannel);
-    GetTextureChannelData(AlphaTexture, AlphaTextureSelectedChannel, AlphaResizeMethod, AChannel);
-    
-    ChannelData.Add(RChannel);
-    ChannelData.Add(GChannel);
-    ChannelData.Add(BChannel);
-    ChannelData.Add(AChannel);
 
-    int32 PixelCount = TextureResolution*TextureResolution;
+            if (!FMaskToolsUtils::GetTextureSourceImage(Texture, Job.Image))
+            {
+                UE_LOG(LogChannelMixer, Warning, TEXT("Failed to get texture pixel data"));
+                return false;
+            }
 
-    TArray<FColor> FinalTextureData;
-    FinalTextureData.Reserve(PixelCount);
+            Job.Image.GammaSpace = SourceGamma;
+            Job.SourceView = Job.Image;
+            return true;
+        });
+
+    Pipeline->AddStage(TEXT("Extract"), EMaskPipelineThread::Worker, [this, PlaneFormat](FMaskToolsPipelineJob& PipelineJob)
+        {
+            FSlotJob& Job = static_cast<FSlotJob&>(PipelineJob);
+            FMaskToolsKernels::ExtractResizedPlane(Job.SourceView, Job.Channel, PlaneFormat, EGammaSpace::Linear,
+                TextureSizeX, TextureSizeY, FMaskToolsPrivateHelpers::FindResizeMethod(Job.ResizeMethod), *Job.OutPlane);
 
-    for (int32 i = 0; i < PixelCount; ++i)
+            if (!Job.CacheKey.IsEmpty())
+            {
+                FMaskToolsDiskCache::Get().Store(Job.CacheKey, *Job.OutPlane, FMaskToolsKernels::ComputeStats(*Job.OutPlane));
+            }
+            *Job.bOutRead = true;
+            return true;
+        });
+
+    for (int32 SlotIndex = 0; SlotIndex < 4; ++SlotIndex)
+    {
+        // Empty slots are packed black, there is nothing to read
+        if (!SlotTextures[SlotIndex] && ChannelSourceFiles[SlotIndex].IsEmpty()) continue;
+
+        TUniquePtr<FSlotJob> Job = MakeUnique<FSlotJob>();
+        Job->SlotIndex = SlotIndex;
+        Job->Channel = static_cast<EMaskChannel>(SlotChannels[SlotIndex]);
+
+        // Default follows the project settings, the tiling flags of the slot are kept either way
+        Job->ResizeMethod = FMaskToolsPrivateHelpers::ResolveResizeMethod(SlotResizeMethods[SlotIndex], Config->MixerResizeMethod);
+        Job->OutPlane = &Planes[SlotIndex];
+        Job->bOutRead = &bPlanesRead[SlotIndex];
+        Pipeline->AddJob(MoveTemp(Job));
+    }
+    Pipeline->Wait();
+
+    const FMaskPlane* PackPlanes[4] =
     {
-        uint8 R = RChannel.IsValidIndex(i) ? RChannel[i].R : 0;
-        uint8 G = GChannel.IsValidIndex(i) ? GChannel[i].R : 0;
-        uint8 B = BChannel.IsValidIndex(i) ? BChannel[i].R : 0;
-        uint8 A = AChannel.IsValidIndex(i) ? AChannel[i].R : 255;
+        bPlanesRead[0] ? &Planes[0] : nullptr,
+        bPlanesRead[1] ? &Planes[1] : nullptr,
+        bPlanesRead[2] ? &Planes[2] : nullptr,
+        bPlanesRead[3] ? &Planes[3] : nullptr
+    };
 
-        FinalTextureData.Add(FColor(R, G, B, A));
+    // Keep a black preview if no slot could be read
+    if (!PackPlanes[0] && !PackPlanes[1] && !PackPlanes[2] && !PackPlanes[3])
+    {
+        Planes[0].Init(TextureSizeX, TextureSizeY, PlaneFormat);
+        FMemory::Memzero(Planes[0].RawData.GetData(), Planes[0].RawData.Num());
+        PackPlanes[0] = &Planes[0];
     }
 
-    FCreateTexture2DParameters TextureParameters;
-    TextureParameters.TextureGroup = TextureGroup::TEXTUREGROUP_World;
-    TextureParameters.bSRGB = false;
-    TextureParameters.CompressionSettings = TC_Masks;
-    TextureParameters.bUseAlpha = true;
-    TextureParameters.bDeferCompression = true;
-    TextureParameters.bVirtualTexture = false;
+    FImage FinalImage;
+    if (!FMaskToolsKernels::Pack(PackPlanes, FinalImage))
+    {
+        UE_LOG(LogChannelMixer, Warning, TEXT("Failed to pack preview texture"));
+        return;
+    }
 
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    UTexture2D* NewTexture = FImageUtils::CreateTexture2D(TextureResolution, TextureResolution, FinalTextureData, World, TEXT(""), EObjectFlags::RF_KeepForCooker, TextureParameters);
-    PreviewTexture = NewTexture;
+    PreviewTexture = FMaskToolsUtils::CreateTransientTexture(FinalImage, TC_Masks, TMGS_FromTextureGroup);
     FMaskToolsUtils::ForceTextureCompilation(PreviewTexture);
     UpdateSlateChannel(EChannelMixerChannel::Result);
 }
 
 void FChannelMixer::RegeneratePreviewTextureMaterial()
 {
-    
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelMixer::RegeneratePreviewTextureMaterial);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Pack preview %dx%d (material)"), TextureSizeX, TextureSizeY);
+
     UWorld* World = GEditor->GetEditorWorldContext().World();
     UMaterialInterface* BaseMaterial = FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureMixer"));
     if (BaseMaterial == nullptr)
@@ -352,10 +557,20 @@ void FChannelMixer::RegeneratePreviewTextureMaterial()
     }
     
     UMaterialInstanceDynamic* BlendMaterial = UKismetMaterialLibrary::CreateDynamicMaterialInstance(World, BaseMaterial);
-    UTextureRenderTarget2D* CombinedTexture = UKismetRenderingLibrary::CreateRenderTarget2D(World, TextureResolution, TextureResolution);
+
+    // Creating and rooting a new target on every regeneration leaked one per preview
+    if (!PreviewRenderTarget)
+    {
+        PreviewRenderTarget = UKismetRenderingLibrary::CreateRenderTarget2D(World, TextureSizeX, TextureSizeY);
+        PreviewRenderTarget->AddToRoot();
+    }
+    else if (PreviewRenderTarget->SizeX != TextureSizeX || PreviewRenderTarget->SizeY != TextureSizeY)
+    {
+        PreviewRenderTarget->ResizeTarget(TextureSizeX, TextureSizeY);
+    }
+    UTextureRenderTarget2D* CombinedTexture = PreviewRenderTarget;
 
     PreviewBrush = MakeShared<FSlateBrush>();
-    CombinedTexture->AddToRoot();
     PreviewBrush->SetResourceObject(CombinedTexture);
 
     if (RedTexture) RedTexture->UpdateResource();
@@ -513,16 +728,218 @@ FReply FChannelMixer::ExportTexture()
 
     FString PackageName = BuildPackagePath();
 
-    UTexture2D* SavedTexture = FMaskToolsUtils::CreateStaticTextureEditorOnly(PreviewTexture, PackageName, TC_Masks, TMGS_FromTextureGroup);
-    SavedTexture->MarkPackageDirty();
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelMixer::ExportTexture);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Export %s"), *PackageName);
+
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+
+    // Written from a copy of the preview so an existing mask can be updated in place, or skipped when identical
+    FImage PreviewImage;
+    const bool bHasPreviewImage = FMaskToolsUtils::GetTextureSourceImage(PreviewTexture, PreviewImage);
+
+    const TArray<FIntPoint> ResizedSizes = bHasPreviewImage
+        ? FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(FIntPoint(PreviewImage.SizeX, PreviewImage.SizeY), Config->AdditionalOutputResolutions)
+        : TArray<FIntPoint>();
+
+    // Channels that carry no data decide how cheaply the mask can be compressed, and smaller copies are resized from them
+    const EMaskPlaneFormat PlaneFormat = FMaskToolsPrivateHelpers::FindPlaneFormat(Config->MaskPrecision);
+    TArray<FMaskPlane> Planes;
+    if (bHasPreviewImage && (Config->ExportsAssets() || ResizedSizes.Num() > 0))
+    {
+        FMaskToolsKernels::Unpack(PreviewImage, PlaneFormat, EGammaSpace::Linear, Planes);
+    }
+
+    // Mips are only stored in assets
+    const FMaskMipSettings MipSettings = FMaskToolsPrivateHelpers::FindMipSettings();
+    const bool bBuildMips = MipSettings.bEnabled && Config->ExportsAssets();
+
+    /*
+    * Every size is computed from the preview channels, each from the previous one, and packed back.
+    * Each channel is resized with the filter and edge mode of its slot, as the preview was.
+    */
+    TArray<FImage> ResizedImages;
+    TArray<TArray<FMaskPlaneStats>> ResizedStats;
+    TArray<TArray<FImage>> ResizedMips;
+    if (ResizedSizes.Num() > 0)
+    {
+        const EResizeMethod SlotResizeMethods[4] = { RedResizeMethod, GreenResizeMethod, BlueResizeMethod, AlphaResizeMethod };
+
+        TArray<TArray<FMaskPlane>> ChannelChains;
+        ChannelChains.SetNum(Planes.Num());
+        for (int32 ChannelIndex = 0; ChannelIndex < Planes.Num(); ++ChannelIndex)
+        {
+            const EResizeMethod ResizeMethod = FMaskToolsPrivateHelpers::ResolveResizeMethod(SlotResizeMethods[ChannelIndex], Config->MixerResizeMethod);
+            FMaskToolsKernels::ResizePlaneChain(Planes[ChannelIndex], ResizedSizes, FMaskToolsPrivateHelpers::FindResizeMethod(ResizeMethod), ChannelChains[ChannelIndex]);
+        }
+
+        ResizedImages.SetNum(ResizedSizes.Num());
+        ResizedStats.SetNum(ResizedSizes.Num());
+        ResizedMips.SetNum(ResizedSizes.Num());
+        for (int32 SizeIndex = 0; SizeIndex < ResizedSizes.Num(); ++SizeIndex)
+        {
+            TArray<const FMaskPlane*> LevelPlanes;
+            for (const TArray<FMaskPlane>& Chain : ChannelChains)
+            {
+                LevelPlanes.Add(&Chain[SizeIndex]);
+                ResizedStats[SizeIndex].Add(FMaskToolsKernels::ComputeStats(Chain[SizeIndex]));
+            }
+            FMaskToolsKernels::Pack(LevelPlanes, ResizedImages[SizeIndex]);
+
+            if (bBuildMips)
+            {
+                FMaskToolsKernels::BuildMipImages(LevelPlanes, MipSettings.Reductions, MipSettings.CoverageThreshold, ResizedMips[SizeIndex]);
+            }
+        }
+    }
+
+    if (Config->ExportsImageFiles())
+    {
+        const FString FilePath = FMaskToolsUtils::GetImageFilePath(PackageName);
+        const EMaskImageFileFormat FileFormat = FMaskToolsPrivateHelpers::FindImageFileFormat(Config->ImageFileFormat);
+        if (bHasPreviewImage && FMaskToolsImageFiles::SaveImage(PreviewImage, FilePath, FileFormat))
+        {
+            UEnchancedNotifications::LaunchNotification(FString::Printf(TEXT("Successfully exported combined texture to %s"), *FilePath));
+        }
+        else
+        {
+            UE_LOG(LogChannelMixer, Warning, TEXT("Failed to export combined texture to %s"), *FilePath);
+        }
+
+        if (ResizedImages.Num() > 0)
+        {
+            TArray<FString> ResizedFilePaths;
+            for (const FIntPoint& Size : ResizedSizes)
+            {
+                ResizedFilePaths.Add(FMaskToolsUtils::GetImageFilePath(FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, Size)));
+            }
 
-    UEnchancedNotifications::OpenCBDirNotification(FString::Printf(TEXT("Successfully exported combined texture to /Content/%s"), *ExportPath), FString::Printf(TEXT("/Game/%s"), *ExportPath));
+            const TArray<FImageView> ResizedViews(ResizedImages);
+            const int32 NumSaved = FMaskToolsImageFiles::SaveImages(ResizedViews, ResizedFilePaths, FileFormat);
+            if (NumSaved != ResizedImages.Num())
+            {
+                UE_LOG(LogChannelMixer, Warning, TEXT("Failed to export %d of the %d resized copies of %s"), ResizedImages.Num() - NumSaved, ResizedImages.Num(), *FilePath);
+            }
+        }
+    }
+
+    if (!Config->ExportsAssets())
+    {
+        return FReply::Handled();
+    }
+
+    bool bUnchanged = false;
+    UTexture2D* SavedTexture = nullptr;
+    TArray<UTexture2D*> ResizedTextures;
+    if (bHasPreviewImage)
+    {
+        TArray<FMaskPlaneStats> ChannelStats;
+        TArray<const FMaskPlane*> PlanePointers;
+        for (const FMaskPlane& Plane : Planes)
+        {
+            ChannelStats.Add(FMaskToolsKernels::ComputeStats(Plane));
+            PlanePointers.Add(&Plane);
+        }
+
+        TArray<FImage> Mips;
+        if (bBuildMips)
+        {
+            FMaskToolsKernels::BuildMipImages(PlanePointers, MipSettings.Reductions, MipSettings.CoverageThreshold, Mips);
+        }
+        PlanePointers.Empty();
+        Planes.Empty();
+
+        const EMaskBlockFormat BlockFormat = FMaskToolsPrivateHelpers::FindMaskBlockFormat(ChannelStats, PlaneFormat, Config->bChooseCompressionFromChannels);
+        UE_LOG(LogChannelMixer, Log, TEXT("Exporting %s with block format %s"), *PackageName, LexToString(BlockFormat));
+
+        SavedTexture = FMaskToolsUtils::WriteOutputTexture(PreviewImage, PackageName, BlockFormat, nullptr, nullptr, &bUnchanged, Mips);
+
+        // Copies are created in the same pass, their textures compile alongside the main one
+        for (int32 SizeIndex = 0; SizeIndex < ResizedImages.Num(); ++SizeIndex)
+        {
+            const EMaskBlockFormat ResizedBlockFormat = FMaskToolsPrivateHelpers::FindMaskBlockFormat(ResizedStats[SizeIndex], PlaneFormat, Config->bChooseCompressionFromChannels);
+            UTexture2D* ResizedTexture = FMaskToolsUtils::WriteOutputTexture(ResizedImages[SizeIndex], FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, ResizedSizes[SizeIndex]),
+                ResizedBlockFormat, nullptr, nullptr, nullptr, ResizedMips[SizeIndex]);
+            if (ResizedTexture)
+            {
+                ResizedTextures.Add(ResizedTexture);
+            }
+        }
+    }
+    else
+    {
+        SavedTexture = FMaskToolsUtils::CreateStaticTextureEditorOnly(PreviewTexture, PackageName, TC_Masks, TMGS_FromTextureGroup);
+        if (SavedTexture)
+        {
+            SavedTexture->MarkPackageDirty();
+        }
+    }
+
+    if (!SavedTexture)
+    {
+        return FReply::Handled();
+    }
+
+    // Recipes reference texture assets, a mask built from image files can't be rebuilt from one
+    if (Config->bSaveMaskRecipes && HasChannelSourceFiles())
+    {
+        UE_LOG(LogChannelMixer, Log, TEXT("No recipe saved for %s, some of its inputs are image files"), *PackageName);
+    }
+    else if (Config->bSaveMaskRecipes)
+    {
+        SaveRecipe(SavedTexture, ResizedTextures, bUnchanged);
+    }
+
+    const FString Message = bUnchanged
+        ? FString::Printf(TEXT("Combined texture in /Content/%s is already up to date"), *ExportPath)
+        : FString::Printf(TEXT("Successfully exported combined texture to /Content/%s"), *ExportPath);
+    UEnchancedNotifications::OpenCBDirNotification(Message, FString::Printf(TEXT("/Game/%s"), *ExportPath));
 
     return FReply::Handled();
 }
 
+void FChannelMixer::SaveRecipe(UTexture2D* MaskTexture, TConstArrayView<UTexture2D*> ResizedTextures, bool bMaskUnchanged)
+{
+    const FString RecipePackageName = FMaskToolsUtils::GetCleanPathName(MaskTexture) + TEXT("_Recipe");
+    const FString RecipeObjectPath = RecipePackageName + TEXT(".") + FPackageName::GetShortName(RecipePackageName);
+
+    // Re-exporting reuses the recipe of the mask, and leaves it untouched along with the mask and its copies
+    UMaskRecipe* Recipe = LoadObject<UMaskRecipe>(nullptr, *RecipeObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+    if (Recipe && bMaskUnchanged && Recipe->ResizedOutputTextures.Num() == ResizedTextures.Num()
+        && Algo::AllOf(ResizedTextures, [Recipe](const UTexture2D* ResizedTexture) { return Recipe->IsOutput(ResizedTexture); }))
+    {
+        return;
+    }
+
+    if (!Recipe)
+    {
+        Recipe = UMaskRecipe::CreateRecipeAsset(RecipePackageName);
+    }
+
+    auto FillSlot = [this](FMaskRecipeSlot& Slot, UTexture2D* Texture, EChannelMixerTextureChannel Channel, EResizeMethod ResizeMethod)
+    {
+        // The fallback texture is transient and stands for an empty slot
+        Slot.Texture = Texture != FallbackTexture ? Texture : nullptr;
+        Slot.SourceChannel = static_cast<EMaskTextureChannel>(Channel);
+        Slot.ResizeMethod = FMaskToolsPrivateHelpers::FindBaseResizeMethod(ResizeMethod);
+        Slot.EdgeMode = FMaskToolsPrivateHelpers::FindEdgeMode(ResizeMethod);
+        Slot.ColorSpace = GetDefault<UMaskToolsConfig>()->InputColorSpace;
+    };
+
+    FillSlot(Recipe->Red, RedTexture, RedTextureSelectedChannel, RedResizeMethod);
+    FillSlot(Recipe->Green, GreenTexture, GreenTextureSelectedChannel, GreenResizeMethod);
+    FillSlot(Recipe->Blue, BlueTexture, BlueTextureSelectedChannel, BlueResizeMethod);
+    FillSlot(Recipe->Alpha, AlphaTexture, AlphaTextureSelectedChannel, AlphaResizeMethod);
+    Recipe->Resolution = FMaskToolsPrivateHelpers::FindMaskResolution(TextureSizeX, TextureSizeY);
+    Recipe->CustomResolution = FIntPoint(TextureSizeX, TextureSizeY);
+
+    Recipe->MarkAsBuilt(MaskTexture, ResizedTextures);
+}
+
 FReply FChannelMixer::RestoreSlotDefaultTexture(EChannelMixerChannel Channel)
 {
+    ClearChannelSourceFile(Channel);
+
     switch (Channel)
     {
     case EChannelMixerChannel::Red:
@@ -549,6 +966,8 @@ FReply FChannelMixer::RestoreSlotDefaultTexture(EChannelMixerChannel Channel)
 
 void FChannelMixer::SetNewChannelTexture(UTexture2D* NewTexture, EChannelMixerChannel Channel)
 {
+    ClearChannelSourceFile(Channel);
+
     switch (Channel)
     {
     case EChannelMixerChannel::Red:
@@ -571,6 +990,12 @@ void FChannelMixer::SetNewChannelTexture(UTexture2D* NewTexture, EChannelMixerCh
 
 FReply FChannelMixer::BrowseToAsset(EChannelMixerChannel Channel)
 {
+    if (Channel <= EChannelMixerChannel::Alpha && !ChannelSourceFiles[static_cast<int32>(Channel)].IsEmpty())
+    {
+        FPlatformProcess::ExploreFolder(*ChannelSourceFiles[static_cast<int32>(Channel)]);
+        return FReply::Handled();
+    }
+
     FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
     ContentBrowserModule.Get().FocusPrimaryContentBrowser(false);
     FAssetData AssetToFocus;
@@ -7,6 +7,7 @@
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "MaskToolsConfig.h"
+#include "MaskToolsUtils.h"
 #include "Editor/ContentBrowser/Private/SContentBrowser.h"
 
 #include "Widgets/SWindow.h"
@@ -14,6 +15,8 @@
 #include "Widgets/Layout/SUniformGridPanel.h"
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSpinBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/Paths.h"
@@ -90,6 +93,17 @@ TSharedRef<SWidget> FChannelMixerUI::CreateMainLayout(FChannelMixer* Mixer)
                     })
             ]
             + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                    .Text(FText::FromString(TEXT("Import Files")))
+                    .ToolTipText(FText::FromString(TEXT("Fill the slots in RGBA order with up to 4 image files from disk")))
+                    .OnClicked_Lambda([Mixer]() -> FReply
+                    {
+                        return Mixer->ImportFilesToSlots();
+                    })
+            ]
+            + SHorizontalBox::Slot()
            .FillWidth(0.1f)
            [
                SNew(SButton)
@@ -184,6 +198,18 @@ TSharedRef<SWidget> FChannelMixerUI::CreateChannelWidget(const FString& ChannelN
                             return Mixer->TryImportTexture(Channel);
                         })
 
+                ]
+                +SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                        .Text(FText::FromString(TEXT("File")))
+                        .ToolTipText(FText::FromString(TEXT("Use an image file from disk")))
+                        .OnClicked_Lambda([Channel, Mixer]() -> FReply
+                        {
+                            return Mixer->TryImportFile(Channel);
+                        })
+
                 ]
                 +SHorizontalBox::Slot()
                 .AutoWidth()
@@ -291,6 +317,42 @@ TSharedRef<SWidget> FChannelMixerUI::CreateTexResSelectionComboBox(FChannelMixer
                         ]
 
                 ]
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                [
+                    SNew(SHorizontalBox)
+                        + SHorizontalBox::Slot()[CreateTexSizeSpinBox(Mixer, TEXT("Width"), Mixer->TextureSizeX)]
+                        + SHorizontalBox::Slot()[CreateTexSizeSpinBox(Mixer, TEXT("Height"), Mixer->TextureSizeY)]
+                ]
+        ];
+}
+
+TSharedRef<SWidget> FChannelMixerUI::CreateTexSizeSpinBox(FChannelMixer* Mixer, const FString& Name, int32& Size)
+{
+    return SNew(SHorizontalBox)
+        + SHorizontalBox::Slot()
+        .AutoWidth()
+        .VAlign(VAlign_Center)
+        .Padding(4.f, 0.f)
+        [
+            SNew(STextBlock).Text(FText::FromString(Name))
+        ]
+        + SHorizontalBox::Slot()
+        [
+            SNew(SSpinBox<int32>)
+                .ToolTipText(FText::FromString(TEXT("Any size up to 16384, width and height don't need to match")))
+                .MinValue(1)
+                .MaxValue(FMaskPlane::MaxSize)
+                .MinSliderValue(1)
+                .MaxSliderValue(FMaskPlane::MaxSize)
+                .Value_Lambda([&Size]() { return Size; })
+                .OnValueCommitted_Lambda([Mixer, &Size](int32 NewSize, ETextCommit::Type CommitType)
+                    {
+                        if (NewSize == Size) return;
+
+                        Size = NewSize;
+                        Mixer->RegeneratePreviewTexture();
+                    })
         ];
 }
 
@@ -335,6 +397,26 @@ TSharedRef<SWidget> FChannelMixerUI::CreateResizeMethodSelectionComboBox(FChanne
                         ]
 
                 ]
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                [
+                    SNew(SCheckBox)
+                        .ToolTipText(FText::FromString(TEXT("Wrap around the edges when resizing, keeps tiling textures seamless")))
+                        .IsChecked_Lambda([Mixer, Channel]()
+                            {
+                                return FMaskToolsPrivateHelpers::FindEdgeMode(Mixer->GetResizeMethod(Channel)) == EMaskEdgeMode::Wrap ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+                            })
+                        .OnCheckStateChanged_Lambda([Mixer, Channel](ECheckBoxState NewState)
+                            {
+                                EResizeMethod& ResizeMethod = Mixer->GetResizeMethod(Channel);
+                                const EMaskEdgeMode EdgeMode = NewState == ECheckBoxState::Checked ? EMaskEdgeMode::Wrap : EMaskEdgeMode::Clamp;
+                                ResizeMethod = FMaskToolsPrivateHelpers::CombineResizeMethod(FMaskToolsPrivateHelpers::FindBaseResizeMethod(ResizeMethod), EdgeMode);
+                                Mixer->RegeneratePreviewTexture();
+                            })
+                        [
+                            SNew(STextBlock).Text(FText::FromString(TEXT("Tiling")))
+                        ]
+                ]
         ];
 }
 
@@ -378,6 +460,9 @@ void STexResComboBox::Construct(const FArguments& InArgs)
     ComboBoxOptions.Add(MakeShared<FString>(TEXT("2048")));
     ComboBoxOptions.Add(MakeShared<FString>(TEXT("4096")));
     ComboBoxOptions.Add(MakeShared<FString>(TEXT("8192")));
+    ComboBoxOptions.Add(MakeShared<FString>(TEXT("16384")));
+    // Keeps the width and height typed next to the presets
+    ComboBoxOptions.Add(MakeShared<FString>(TEXT("Custom")));
 
     const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
     int32 EnumIndex = StaticEnum<EMaskResolutions>()->GetIndexByValue(static_cast<int64>(Config->DefaultMaskResolution));
@@ -405,8 +490,14 @@ void STexResComboBox::OnSelectionChanged(TSharedPtr<FString> NewSelection, ESele
     }
 
     SelectedOption = NewSelection;
+    if (*NewSelection == TEXT("Custom"))
+    {
+        return;
+    }
+
     int32 newSize = FChannelMixerUtils::ResFinder(*NewSelection.Get());
-    Mixer->TextureResolution = newSize;
+    Mixer->TextureSizeX = newSize;
+    Mixer->TextureSizeY = newSize;
 
     Mixer->RegeneratePreviewTexture();
 }
@@ -418,6 +509,12 @@ TSharedRef<SWidget> STexResComboBox::MakeWidgetForOption(TSharedPtr<FString> InO
 
 FText STexResComboBox::GetComboBoxSelection() const
 {
+    // Editing the width or height turns any preset into a custom size
+    if (Mixer && FMaskToolsPrivateHelpers::FindMaskResolution(Mixer->TextureSizeX, Mixer->TextureSizeY) == EMaskResolutions::Custom)
+    {
+        return FText::FromString(TEXT("Custom"));
+    }
+
     return FText::FromString(*SelectedOption);
 }
 
@@ -529,23 +626,10 @@ void SResizeAlgorithmComboBox::OnSelectionChanged(TSharedPtr<FString> NewSelecti
 
     SelectedOption = NewSelection;
     EResizeMethod newResizeMethod = FChannelMixerUtils::ResizeFilterFinder(*NewSelection);
-    switch (Channel)
-    {
-    case EChannelMixerTextureChannel::Red:
-        Mixer->RedResizeMethod = newResizeMethod;
-        break;
-    case EChannelMixerTextureChannel::Green:
-        Mixer->GreenResizeMethod = newResizeMethod;
-        break;
-    case EChannelMixerTextureChannel::Blue:
-        Mixer->BlueResizeMethod = newResizeMethod;
-        break;
-    case EChannelMixerTextureChannel::Alpha:
-        Mixer->AlphaResizeMethod = newResizeMethod;
-        break;
-    default:
-        UE_LOG(LogChannelMixer, Warning, TEXT("No channel assigned to resize method combo box"))
-    }
+
+    // Changing the filter keeps the tiling of the slot
+    EResizeMethod& ResizeMethod = Mixer->GetResizeMethod(Channel);
+    ResizeMethod = FMaskToolsPrivateHelpers::CombineResizeMethod(newResizeMethod, FMaskToolsPrivateHelpers::FindEdgeMode(ResizeMethod));
     
     Mixer->RegeneratePreviewTexture();
 }
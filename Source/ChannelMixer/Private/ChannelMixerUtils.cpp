@@ -4,6 +4,7 @@
 #include "ChannelMixerUtils.h"
 #include "ChannelMixer.h"
 #include <MaskToolsUtils.h>
+#include "MaskToolsKernels.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Kismet/KismetRenderingLibrary.h"
 #include "Kismet/KismetMaterialLibrary.h"
@@ -38,6 +39,35 @@ UTexture2D* FChannelMixerUtils::CreateFallbackTexture()
     return Texture;
 }
 
+UTexture2D* FChannelMixerUtils::CreateThumbnailTexture(const FImageView& Image)
+{
+    constexpr int32 ThumbnailSize = 128;
+
+    const float Scale = FMath::Min(1.f, static_cast<float>(ThumbnailSize) / FMath::Max(Image.SizeX, Image.SizeY));
+    const int32 SizeX = FMath::Max(1, FMath::RoundToInt(Image.SizeX * Scale));
+    const int32 SizeY = FMath::Max(1, FMath::RoundToInt(Image.SizeY * Scale));
+
+    FImage ResizedImage;
+    FMaskToolsKernels::ResizeImage(Image, SizeX, SizeY, FImageCore::EResizeImageFilter::Default, ResizedImage);
+
+    FImage ThumbnailImage;
+    FMaskToolsKernels::ConvertImage(ResizedImage, ERawImageFormat::BGRA8, EGammaSpace::sRGB, ThumbnailImage);
+
+    UTexture2D* Texture = UTexture2D::CreateTransient(SizeX, SizeY, PF_B8G8R8A8);
+    Texture->MipGenSettings = TMGS_NoMipmaps;
+    Texture->SRGB = true;
+
+    FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+    void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(Data, ThumbnailImage.RawData.GetData(), ThumbnailImage.RawData.Num());
+    Mip.BulkData.Unlock();
+
+    Texture->AddToRoot();
+    Texture->UpdateResource();
+
+    return Texture;
+}
+
 int32 FChannelMixerUtils::ResFinder(FString SelectedOption)
 {
     static TMap<FString, int32> ResMap
@@ -50,7 +80,8 @@ int32 FChannelMixerUtils::ResFinder(FString SelectedOption)
         {TEXT("1024"), 1024},
         {TEXT("2048"), 2048},
         {TEXT("4096"), 4096},
-        {TEXT("8192"), 8192}
+        {TEXT("8192"), 8192},
+        {TEXT("16384"), 16384}
     };
 
     return *ResMap.Find(SelectedOption);
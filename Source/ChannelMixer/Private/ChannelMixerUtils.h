@@ -17,6 +17,9 @@ struct  FChannelMixerUtils
 
     static UTexture2D* CreateFallbackTexture();
 
+    // Small transient texture showing Image in a slot, written straight to its platform data without a texture build
+    static UTexture2D* CreateThumbnailTexture(const FImageView& Image);
+
     static int32 ResFinder(FString SelectedOption);
 
     static EChannelMixerTextureChannel ChannelFinder(FString SelectedOption);
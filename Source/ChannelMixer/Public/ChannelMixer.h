@@ -4,10 +4,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ImageCore.h"
 #include "Logging.h"
 #include "ChannelMixerEnums.h"
 #include "MaskToolsEnums.h"
 
+class UTextureRenderTarget2D;
+
 /**
  * Main module class that holds state and initializes the texture mixer.
  */
@@ -48,16 +51,25 @@ public:
     FAssetData AlphaAssetData;
     UTexture2D* AlphaTexture;
     
+    // Image files used instead of a texture asset, indexed by EChannelMixerChannel. Empty for texture slots
+    FString ChannelSourceFiles[4];
+    FImage ChannelSourceImages[4];
+
     UTexture2D* PreviewTexture;
 
     UTexture2D* FallbackTexture;
 
+    // Reused by every material based preview, rooted once and released on shutdown
+    UTextureRenderTarget2D* PreviewRenderTarget = nullptr;
+
     // Final mask package settings
     FString TexturePrefix;
     FString TextureName = TEXT("GeneratedTexture");
     FString TextureSuffix;
     FString ExportPath = TEXT("GeneratedMasks");
-    int32 TextureResolution = 512;
+    // Any size up to FMaskPlane::MaxSize, the resolution presets only set both to the same value
+    int32 TextureSizeX = 512;
+    int32 TextureSizeY = 512;
 
     // Stores what channel to use for each channel
     EChannelMixerTextureChannel RedTextureSelectedChannel;
@@ -84,8 +96,17 @@ public:
 
     FReply TryImportTexture(EChannelMixerChannel Channel);
 
+    // Picks an image file on disk for a single slot
+    FReply TryImportFile(EChannelMixerChannel Channel);
+
+    // Picks up to four image files on disk, assigned to the slots in RGBA order
+    FReply ImportFilesToSlots();
+
     FReply ToggleContentBrowser(EChannelMixerCBAction Action = EChannelMixerCBAction::Default);
 
+    // Resize method of a slot, its wrap flags are set for tiling textures
+    EResizeMethod& GetResizeMethod(EChannelMixerTextureChannel Channel);
+
     void RegeneratePreviewTexture();
     
     void SetSelectedAsset(const FAssetData& NewSelectedAsset);
@@ -107,5 +128,11 @@ private:
     void RegeneratePreviewTextureMaterial();
     void UpdateSlateChannel(EChannelMixerChannel Channel);
     void SetChannelAssetData(const FAssetData& NewAssetData, EChannelMixerChannel Channel);
+    // ResizedTextures are the copies written with the mask, registered as outputs of the recipe
+    void SaveRecipe(UTexture2D* MaskTexture, TConstArrayView<UTexture2D*> ResizedTextures, bool bMaskUnchanged);
+    bool OpenImageFileDialog(bool bMultiple, TArray<FString>& OutFilePaths);
+    void SetChannelSourceFiles(TArrayView<const FString> FilePaths, EChannelMixerChannel FirstChannel);
+    void ClearChannelSourceFile(EChannelMixerChannel Channel);
+    bool HasChannelSourceFiles() const;
     FAssetData SelectedAsset;
 };
@@ -36,6 +36,7 @@ public class ChannelSplitter : ModuleRules
                 "UnrealEd",
                 "Projects",
                 "MaskTools",
+                "MaskToolsCore",
 
 			}
             );
@@ -3,8 +3,19 @@
 
 #include "ChannelSplitter.h"
 #include "Logging.h"
+#include "EnchancedNotifications.h"
 #include "MaskToolsEnums.h"
 #include "MaskToolsUtils.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsImageFiles.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsPipeline.h"
+#include "MaskToolsProgress.h"
+#include "MaskToolsProgressNotification.h"
+#include "MaskToolsStats.h"
+#include "MaskToolsWorkerPool.h"
+#include "MaskToolsWorkerProtocol.h"
 
 #include "Modules/ModuleManager.h"
 
@@ -17,16 +28,89 @@
 
 #include "UObject/Package.h"
 #include "UObject/SavePackage.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
 
 #include "ChannelSpliterStyle.h"
-#include "ImageUtils.h"
 #include "MaterialDomain.h"
 #include "MaskTools/Public/MaskToolsConfig.h"
 
-#include "Misc/EngineVersionComparison.h"
 
 #define LOCTEXT_NAMESPACE "FChannelSplitter"
 
+struct FMaterialSplitJob : public FMaskToolsPipelineJob
+{
+    FAssetData AssetData;
+    TStrongObjectPtr<UTexture2D> Texture;
+};
+
+/**
+ * Settings and counters shared by every texture of a pixel data split.
+ */
+struct FPixelSplitBatch
+{
+    EMaskPlaneFormat PlaneFormat = EMaskPlaneFormat::U8;
+    FMaskMipSettings MipSettings;
+    EMaskImageFileFormat ImageFileFormat = EMaskImageFileFormat::PNG8;
+    EResizeMethod ResizeMethod = EResizeMethod::Default;
+    TArray<EMaskResolutions> AdditionalOutputResolutions;
+    bool bDiscardEmptyChannels = false;
+    bool bSkipDuplicateChannels = false;
+    bool bRedirectDuplicateChannels = false;
+    bool bExportAssets = true;
+    bool bExportImageFiles = false;
+    bool bUseWorkerProcesses = false;
+    TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> Progress;
+
+    // Written by the encode stage workers
+    std::atomic<int32> NumFilesSaved { 0 };
+    std::atomic<int32> NumFilesFailed { 0 };
+
+    // Game thread only
+    int32 CreatedTextures = 0;
+};
+
+struct FPixelSplitOutput
+{
+    int32 ChannelIndex = 0;
+    FString PackageName;
+    FString FilePath;
+    FImage Image;
+    TArray<FImage> Mips;
+    EMaskBlockFormat BlockFormat = EMaskBlockFormat::BC4;
+    bool bResized = false;
+};
+
+/**
+ * One texture of a pixel data split, carried from its load to the creation of its channel textures.
+ */
+struct FPixelSplitJob : public FMaskToolsPipelineJob
+{
+    FAssetData AssetData;
+    TStrongObjectPtr<UTexture2D> Texture;
+    FString PathName;
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    EGammaSpace SourceGamma = EGammaSpace::Linear;
+    EGammaSpace PlaneGamma = EGammaSpace::Linear;
+    TArray<FIntPoint> ResizedSizes;
+
+    // Per channel, then FilePaths holds the full size file followed by the resized ones for each channel
+    TArray<FString> PackageNames;
+    TArray<FString> FilePaths;
+    TArray<FString> CacheKeys;
+
+    // Source image, only read when a channel is missing from the cache
+    bool bCached = false;
+    FImage Image;
+
+    TArray<FMaskPlane> ChannelPlanes;
+    TArray<FMaskPlaneStats> ChannelStats;
+    TArray<int32> DuplicateOf;
+    TArray<FPixelSplitOutput> Outputs;
+};
+
 void FChannelSplitter::StartupModule()
 {
     InitCBMenuExtension();
@@ -35,6 +119,16 @@ void FChannelSplitter::StartupModule()
 
 void FChannelSplitter::ShutdownModule()
 {
+    // Stages call back into the module, the textures already started are written and the rest is dropped
+    if (ActivePipeline.IsValid() && !ActivePipeline->IsDone())
+    {
+        UE_LOG(LogChannelSplitter, Log, TEXT("Stopping the running split before shutting down"));
+        ActiveProgress->Cancel();
+        ActivePipeline->Wait();
+    }
+    ActivePipeline.Reset();
+    ActiveProgress.Reset();
+
     ChannelSpliterStyle::ShutDown();
 }
 
@@ -74,259 +168,434 @@ void FChannelSplitter::AddCBMenuExtension(FMenuBuilder& MenuBuilder)
 
 void FChannelSplitter::SplitTextures()
 {
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    // AssetsSelected and the module state are shared by the stages, a second split would change them under the first
+    if (ActivePipeline.IsValid() && !ActivePipeline->IsDone())
+    {
+        UE_LOG(LogChannelSplitter, Warning, TEXT("A split is already running, wait for it to finish or cancel it before starting another"));
+        UEnchancedNotifications::LaunchNotification(TEXT("A split is already running"));
+        return;
+    }
+
     const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
 
+    // The split keeps running over the next editor frames, the summary is logged once its last output is created
+    TSharedRef<FMaskToolsPeakMemoryTracker> MemoryTracker = MakeShared<FMaskToolsPeakMemoryTracker>();
+    TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe> Progress = MakeShared<FMaskToolsProgress, ESPMode::ThreadSafe>();
+    TSharedRef<FMaskToolsProgressNotification> Notification = FMaskToolsProgressNotification::Open(LOCTEXT("SplittingTextures", "Splitting textures"), Progress);
+    ActiveProgress = Progress;
+
+    // Textures a stage dropped failed to load or decode, each one was logged
+    auto OnCompleted = [this, MemoryTracker, Progress, Notification](int32 CreatedTextures)
+        {
+            Notification->Close(ActivePipeline.IsValid() ? ActivePipeline->GetNumDropped() : 0);
+
+            const int64 PeakMemoryBytes = MemoryTracker->Stop();
+            UE_LOG(LogChannelSplitter, Log, TEXT("Split %screated %d textures in %.2f s, peak working set %.1f MB"),
+                Progress->IsCancelled() ? TEXT("cancelled, ") : TEXT(""), CreatedTextures, MemoryTracker->GetElapsedSeconds(), PeakMemoryBytes / (1024.0 * 1024.0));
+        };
+
     switch (Config->SplitterCreationMethod)
     {
         case EMaskCreationMethod::Material:
-            SplitTexturesMaterialBased();
+            SplitTexturesMaterialBased(Progress, OnCompleted);
             break;
         case EMaskCreationMethod::PixelData:
-            SplitTexturesPixelData();
+            SplitTexturesPixelData(Progress, OnCompleted);
             break;
 
     }
+}
+
+void FChannelSplitter::SplitTexturesMaterialBased(const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& Progress, TFunction<void(int32)> OnCompleted)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelSplitter::SplitTexturesMaterialBased);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Split %d textures (material)"), AssetsSelected.Num());
+
+    // Every stage renders or creates assets, so they all run on the game thread, a few textures per frame
+    TSharedRef<int32> CreatedTextures = MakeShared<int32>(0);
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Split (material)"));
+    Pipeline->SetProgress(Progress);
+    ActivePipeline = Pipeline;
+
+    Pipeline->AddStage(TEXT("Load"), EMaskPipelineThread::GameThread, [Progress](FMaskToolsPipelineJob& PipelineJob)
+        {
+            FMaterialSplitJob& Job = static_cast<FMaterialSplitJob&>(PipelineJob);
+            UTexture2D* Texture = FMaskToolsUtils::LoadTextureFromAssetData(Job.AssetData, &Progress.Get());
+            Job.Texture.Reset(Texture);
+            return Texture != nullptr;
+        });
 
+    Pipeline->AddStage(TEXT("Render"), EMaskPipelineThread::GameThread, [this, CreatedTextures](FMaskToolsPipelineJob& PipelineJob)
+        {
+            FMaterialSplitJob& Job = static_cast<FMaterialSplitJob&>(PipelineJob);
+            *CreatedTextures += SplitTextureMaterialBased(Job.Texture.Get());
+            return true;
+        });
+
+    for (const FAssetData& AssetData : AssetsSelected)
+    {
+        TUniquePtr<FMaterialSplitJob> Job = MakeUnique<FMaterialSplitJob>();
+        Job->AssetData = AssetData;
+        Pipeline->AddJob(MoveTemp(Job));
+    }
+
+    Pipeline->Start([CreatedTextures, OnCompleted = MoveTemp(OnCompleted)]()
+        {
+            OnCompleted(*CreatedTextures);
+        });
 }
 
-void FChannelSplitter::SplitTexturesMaterialBased()
+int32 FChannelSplitter::SplitTextureMaterialBased(UTexture2D* Texture)
 {
     // General setup
     const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
     UWorld* World = GEditor->GetEditorWorldContext().World();
     bool _bDiscardEmptyChannels = Config->bDiscardEmptyChannels;
+    int32 CreatedTextures = 0;
 
-    // Cast and store selected content browser assets if textures
-    TArray<FAssetData> AssetData;
-    const TArray<UTexture2D*> SelectedTextures = FMaskToolsUtils::SyncronousLoadCBTextures(AssetData);
+    TArray<UMaterialInstanceDynamic*> SplitMaterialsArray;
 
-    for (UTexture2D* Texture : SelectedTextures)
-    {
-        TArray<UMaterialInstanceDynamic*> SplitMaterialsArray;
-
-        SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_R")), World, FName("Red")));
-        SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_G")), World, FName("Green")));
-        SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_B")), World, FName("Blue")));
-        SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_A")), World, FName("Alpha")));
-
-        // Copy original texture values and settings
-        const int32 OgTexResX = Texture->GetImportedSize().X;
-        const int32 OgTexResY = Texture->GetImportedSize().Y;
-        const TEnumAsByte<TextureMipGenSettings> MipGenSettings = Texture->MipGenSettings;
-        const int32 LodBias = Texture->LODBias;
-        const int32 MaxTextureSize = Texture->MaxTextureSize;
-        const bool bPreserveBorders = Texture->bPreserveBorder;
-        const uint8 NeverStream = Texture->NeverStream;
-
-#if UE_VERSION_NEWER_THAN(5, 2, 0)
-        const TEnumAsByte<TextureCookPlatformTilingSettings> CookPlatformTilingSettings = Texture->CookPlatformTilingSettings;
-#endif // UE_VERSION_NEWER_THAN(5, 2, 0)
-
-#if UE_VERSION_NEWER_THAN(5, 4, 0)
-        const bool bOodlePreserveExtremes = Texture->bOodlePreserveExtremes;
-#endif // UE_VERSION_NEWER_THAN(5, 4, 0)
-
-        // Iterator for the suffixes
-        int i = 0;
-
-        // Export each one of the channels
-        for (UMaterialInstanceDynamic* Material : SplitMaterialsArray)
-        {
-            Material->SetTextureParameterValue(TEXT("Texture"), Texture);
-            Material->EnsureIsComplete();
-
-            // Try discarting current iteration if channel is empty
-            if (_bDiscardEmptyChannels)
-            {
-                if (IsChannelEmpty(Material))
-                {
-                    i++;
-                    continue;
-                }
+    SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_R")), World, FName("Red")));
+    SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_G")), World, FName("Green")));
+    SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_B")), World, FName("Blue")));
+    SplitMaterialsArray.Add(UMaterialInstanceDynamic::Create(FMaskToolsPrivateHelpers::LoadPluginMaterial(TEXT("MM_TextureSplitter_A")), World, FName("Alpha")));
 
-            }
+    // Copy original texture values and settings
+    const int32 OgTexResX = Texture->GetImportedSize().X;
+    const int32 OgTexResY = Texture->GetImportedSize().Y;
+    const TEnumAsByte<TextureMipGenSettings> MipGenSettings = Texture->MipGenSettings;
 
-            // I'm using GetPathName because it returns editor content folder relative path
-            // It must be cleaned afterwards
-            const FString PathName = FMaskToolsUtils::GetCleanPathName(Texture);
-            const FString PackageName = FString::Printf(TEXT("%s%s"), *PathName, *SuffixArray[i]);
+    // Iterator for the suffixes
+    int i = 0;
 
-            // Create and draw material to render target
-            UTextureRenderTarget2D* tempRT = UKismetRenderingLibrary::CreateRenderTarget2D(World, OgTexResX, OgTexResY, RTF_R16f);
-            UKismetRenderingLibrary::DrawMaterialToRenderTarget(World, tempRT, Material);
+    // Export each one of the channels
+    for (UMaterialInstanceDynamic* Material : SplitMaterialsArray)
+    {
+        Material->SetTextureParameterValue(TEXT("Texture"), Texture);
+        Material->EnsureIsComplete();
 
-            // Export the texture
-            UTexture2D* ExportedTexture = UKismetRenderingLibrary::RenderTargetCreateStaticTexture2DEditorOnly(
-                tempRT,
-                PackageName,
-                TextureCompressionSettings::TC_Grayscale,
-                MipGenSettings);
+        // Try discarting current iteration if channel is empty
+        if (_bDiscardEmptyChannels)
+        {
+            if (IsChannelEmpty(Material))
+            {
+                i++;
+                continue;
+            }
 
-            // Notify the editor about changes for safety
-            ExportedTexture->PreEditChange(nullptr);
+        }
 
-            // Paste original texture values
-            ExportedTexture->LODBias = LodBias;
-            ExportedTexture->MaxTextureSize = MaxTextureSize;
-            ExportedTexture->bPreserveBorder = bPreserveBorders;
-            ExportedTexture->NeverStream = NeverStream;
+        // I'm using GetPathName because it returns editor content folder relative path
+        // It must be cleaned afterwards
+        const FString PathName = FMaskToolsUtils::GetCleanPathName(Texture);
+        const FString PackageName = FString::Printf(TEXT("%s%s"), *PathName, *SuffixArray[i]);
 
-#if UE_VERSION_NEWER_THAN(5, 2, 0)
-            ExportedTexture->CookPlatformTilingSettings = CookPlatformTilingSettings;
-#endif // UE_VERSION_NEWER_THAN(5, 2, 0)
+        // Create and draw material to render target
+        UTextureRenderTarget2D* tempRT = UKismetRenderingLibrary::CreateRenderTarget2D(World, OgTexResX, OgTexResY, RTF_R16f);
+        UKismetRenderingLibrary::DrawMaterialToRenderTarget(World, tempRT, Material);
 
-#if UE_VERSION_NEWER_THAN(5, 4, 0)
-            ExportedTexture->bOodlePreserveExtremes = bOodlePreserveExtremes;
-#endif // UE_VERSION_NEWER_THAN(5, 4, 0)
+        // Export the texture
+        UTexture2D* ExportedTexture = UKismetRenderingLibrary::RenderTargetCreateStaticTexture2DEditorOnly(
+            tempRT,
+            PackageName,
+            TextureCompressionSettings::TC_Grayscale,
+            MipGenSettings);
 
-            // Notify the editor changes finished
-            ExportedTexture->PostEditChange();
-            ExportedTexture->MarkPackageDirty();
+        // Notify the editor about changes for safety
+        ExportedTexture->PreEditChange(nullptr);
 
-            i++;
-        }
+        // Paste original texture values
+        FMaskToolsUtils::CopyTextureSettings(Texture, ExportedTexture);
 
-        i = 0;
+        // Notify the editor changes finished
+        ExportedTexture->PostEditChange();
+        ExportedTexture->MarkPackageDirty();
+        CreatedTextures++;
 
+        i++;
     }
+
+    return CreatedTextures;
 }
 
-void FChannelSplitter::SplitTexturesPixelData()
+void FChannelSplitter::SplitTexturesPixelData(const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& Progress, TFunction<void(int32)> OnCompleted)
 {
-    // General setup
+    TRACE_CPUPROFILER_EVENT_SCOPE(FChannelSplitter::SplitTexturesPixelData);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Split %d textures"), AssetsSelected.Num());
+
+    // General setup, settings are read once for the whole batch
     const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    bool _bDiscardEmptyChannels = Config->bDiscardEmptyChannels;
+    TSharedRef<FPixelSplitBatch> Batch = MakeShared<FPixelSplitBatch>();
+    Batch->Progress = Progress;
+    Batch->PlaneFormat = FMaskToolsPrivateHelpers::FindPlaneFormat(Config->MaskPrecision);
+    Batch->MipSettings = FMaskToolsPrivateHelpers::FindMipSettings();
+    Batch->ImageFileFormat = FMaskToolsPrivateHelpers::FindImageFileFormat(Config->ImageFileFormat);
+    Batch->ResizeMethod = FMaskToolsPrivateHelpers::CombineResizeMethod(Config->SplitterResizeMethod, Config->SplitterEdgeMode);
+    Batch->AdditionalOutputResolutions = Config->AdditionalOutputResolutions;
+    Batch->bDiscardEmptyChannels = Config->bDiscardEmptyChannels;
+    Batch->bSkipDuplicateChannels = Config->bSkipDuplicateChannels;
+    Batch->bRedirectDuplicateChannels = Config->bRedirectDuplicateChannels;
+    Batch->bExportAssets = Config->ExportsAssets();
+    Batch->bExportImageFiles = Config->ExportsImageFiles();
+    Batch->bUseWorkerProcesses = Config->bUseWorkerProcesses && FMaskToolsWorkerPool::Get().Configure(Config->NumWorkerProcesses, Config->WorkerTaskTimeoutSeconds);
+
+    /*
+    * Loading and asset creation stay on the game thread while the pixel work and file encoding of other textures run
+    * on workers. Only a few textures are in flight at once, so a batch of hundreds holds as much memory as a handful,
+    * and fewer when their estimated working sets would go over the memory budget.
+    */
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Split"), Config->MaxTexturesInFlight);
+    Pipeline->SetMemoryBudget(Config->GetMemoryBudget());
+    Pipeline->SetProgress(Progress);
+    ActivePipeline = Pipeline;
+
+    Pipeline->AddStage(TEXT("Load"), EMaskPipelineThread::GameThread, [this, Batch](FMaskToolsPipelineJob& PipelineJob)
+        {
+            return LoadSplitJob(*Batch, static_cast<FPixelSplitJob&>(PipelineJob));
+        });
 
-    // Cast and store selected content browser assets if textures
-    TArray<FAssetData> AssetData;
-    const TArray<UTexture2D*> SelectedTextures = FMaskToolsUtils::SyncronousLoadCBTextures(AssetData);
+    Pipeline->AddStage(TEXT("Decode"), EMaskPipelineThread::Worker, [this, Batch](FMaskToolsPipelineJob& PipelineJob)
+        {
+            return DecodeSplitJob(*Batch, static_cast<FPixelSplitJob&>(PipelineJob));
+        });
+
+    Pipeline->AddStage(TEXT("Encode"), EMaskPipelineThread::Worker, [Batch](FMaskToolsPipelineJob& PipelineJob)
+        {
+            FPixelSplitJob& Job = static_cast<FPixelSplitJob&>(PipelineJob);
+            if (!Batch->bExportImageFiles || Job.Outputs.Num() == 0) return true;
 
-    for (UTexture2D* Texture : SelectedTextures)
+            TArray<FImageView> Images;
+            TArray<FString> FilePaths;
+            for (const FPixelSplitOutput& Output : Job.Outputs)
+            {
+                Images.Add(Output.Image);
+                FilePaths.Add(Output.FilePath);
+            }
+
+            const int32 NumSaved = FMaskToolsImageFiles::SaveImages(Images, FilePaths, Batch->ImageFileFormat);
+            Batch->NumFilesSaved += NumSaved;
+            Batch->NumFilesFailed += Images.Num() - NumSaved;
+            return true;
+        });
+
+    Pipeline->AddStage(TEXT("Create"), EMaskPipelineThread::GameThread, [this, Batch](FMaskToolsPipelineJob& PipelineJob)
+        {
+            CreateSplitOutputs(*Batch, static_cast<FPixelSplitJob&>(PipelineJob));
+            return true;
+        });
+
+    for (const FAssetData& AssetData : AssetsSelected)
     {
+        TUniquePtr<FPixelSplitJob> Job = MakeUnique<FPixelSplitJob>();
+        Job->AssetData = AssetData;
+        Pipeline->AddJob(MoveTemp(Job), FMaskToolsUtils::EstimateSplitMemory(AssetData, Batch->PlaneFormat,
+            Batch->MipSettings.bEnabled, Batch->AdditionalOutputResolutions));
+    }
 
-        // Copy original texture values and settings
-        const FString PathName = FMaskToolsUtils::GetCleanPathName(Texture);
-        
-        const TEnumAsByte<TextureMipGenSettings> MipGenSettings = Texture->MipGenSettings;
-        const int32 LodBias = Texture->LODBias;
-        const int32 MaxTextureSize = Texture->MaxTextureSize;
-        const bool bPreserveBorders = Texture->bPreserveBorder;
-        const uint8 NeverStream = Texture->NeverStream;
-        const uint32 Size = Texture ->GetSizeX();
-
-        if (Size != Texture->GetSizeY())
+    Pipeline->Start([Batch, OnCompleted = MoveTemp(OnCompleted)]()
         {
-            UE_LOG(LogTemp, Warning, TEXT("Texture width and height mismatch, currently not supported"))
-            return;
-        }
-#if UE_VERSION_NEWER_THAN(5, 2, 0)
-        const TEnumAsByte<TextureCookPlatformTilingSettings> CookPlatformTilingSettings = Texture->CookPlatformTilingSettings;
-#endif // UE_VERSION_NEWER_THAN(5, 2, 0)
+            if (Batch->bExportImageFiles)
+            {
+                UE_LOG(LogChannelSplitter, Log, TEXT("Split wrote %d image files to %s, %d failed"),
+                    Batch->NumFilesSaved.load(), *GetDefault<UMaskToolsConfig>()->GetImageFileDirectory(), Batch->NumFilesFailed.load());
+            }
+            OnCompleted(Batch->CreatedTextures);
+        });
+}
+
+bool FChannelSplitter::LoadSplitJob(const FPixelSplitBatch& Batch, FPixelSplitJob& Job)
+{
+    UTexture2D* Texture = FMaskToolsUtils::LoadTextureFromAssetData(Job.AssetData, Batch.Progress.Get());
+    if (!IsValid(Texture))
+    {
+        return false;
+    }
+    Job.Texture.Reset(Texture);
 
-#if UE_VERSION_NEWER_THAN(5, 4, 0)
-        const bool bOodlePreserveExtremes = Texture->bOodlePreserveExtremes;
-#endif // UE_VERSION_NEWER_THAN(5, 4, 0)
+    Job.PathName = FMaskToolsUtils::GetCleanPathName(Texture);
+    Job.SizeX = Texture->GetSizeX();
+    Job.SizeY = Texture->GetSizeY();
 
-        TArray<FLinearColor> TexturePixelValues;
-        EResizeMethod ResizeMethod = Config->SplitterResizeMethod;
-        if (!FMaskToolsUtils::GetTexturePixelData(Texture, Size, ResizeMethod,TexturePixelValues))
+    FMaskToolsPrivateHelpers::FindSplitGammaSpaces(Texture, Batch.PlaneFormat, Job.SourceGamma, Job.PlaneGamma);
+    Job.ResizedSizes = FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(FIntPoint(Job.SizeX, Job.SizeY), Batch.AdditionalOutputResolutions);
+
+    // Output names are settled here, the config and asset paths are only read on the game thread
+    for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+    {
+        const FString PackageName = Job.PathName + SuffixArray[ChannelIndex];
+        Job.PackageNames.Add(PackageName);
+        Job.FilePaths.Add(FMaskToolsUtils::GetImageFilePath(PackageName));
+        for (const FIntPoint& Size : Job.ResizedSizes)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Failed to get texture pixel data"));
-            return;
+            Job.FilePaths.Add(FMaskToolsUtils::GetImageFilePath(FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, Size)));
         }
-        if (TexturePixelValues.Num() <= 0)
+    }
+
+    // Reuse the planes of a previous split of the same source, the decode is skipped only if all four are cached
+    Job.ChannelPlanes.SetNum(4);
+    Job.ChannelStats.SetNum(4);
+
+    Job.bCached = true;
+    for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+    {
+        Job.CacheKeys.Add(FMaskToolsUtils::GetPlaneCacheKey(Texture, static_cast<EMaskChannel>(ChannelIndex), Job.SizeX, Job.SizeY,
+            Batch.ResizeMethod, Batch.PlaneFormat, Job.PlaneGamma, Job.SourceGamma));
+        Job.bCached = Job.bCached && FMaskToolsDiskCache::Get().Load(Job.CacheKeys[ChannelIndex], Job.ChannelPlanes[ChannelIndex], &Job.ChannelStats[ChannelIndex]);
+    }
+
+    if (!Job.bCached)
+    {
+        if (!FMaskToolsUtils::GetTextureSourceImage(Texture, Job.Image))
         {
-            // UE_LOG(LogTemp, Warning, TEXT("Empty pixel data array"));
-            return;
+            UE_LOG(LogChannelSplitter, Warning, TEXT("Failed to get texture pixel data of %s"), *Job.PathName);
+            return false;
         }
-        TArray<FColor> RChannel, GChannel, BChannel, AChannel;
-
-        bool bExportRed = false;
-        bool bExportGreen = false;
-        bool bExportBlue = false;
-        bool bExportAlpha = false;
+        Job.Image.GammaSpace = Job.SourceGamma;
+    }
+    return true;
+}
 
-        auto AddPixelToArray = [](const uint8& ColorValue, bool& bExportColor, TArray<FColor>& OutPixelValues)
+bool FChannelSplitter::DecodeSplitJob(const FPixelSplitBatch& Batch, FPixelSplitJob& Job)
+{
+    if (!Job.bCached)
+    {
+        FMaskToolsSplitTask Task;
+        Task.Image = MoveTemp(Job.Image);
+        Task.PlaneFormat = Batch.PlaneFormat;
+        Task.PlaneGamma = Job.PlaneGamma;
+        Task.SizeX = Job.SizeX;
+        Task.SizeY = Job.SizeY;
+        Task.Filter = FMaskToolsPrivateHelpers::FindResizeMethod(Batch.ResizeMethod);
+
+        // A worker that crashes only loses this texture, it is not retried in the editor where it would crash again
+        FMaskToolsSplitResult Result;
+        const EMaskWorkerTaskResult WorkerResult = Batch.bUseWorkerProcesses
+            ? FMaskToolsWorkerPool::Get().RunSplitTask(Task, Result)
+            : EMaskWorkerTaskResult::Unavailable;
+        if (WorkerResult == EMaskWorkerTaskResult::Failed)
         {
-            if (!bExportColor)
-            {
-                bExportColor = ColorValue != 0 && ColorValue != 255;
-            }
-            OutPixelValues.Add(FColor(ColorValue, 0, 0, 0));
-        };
-        
-        for (FLinearColor LinearPixel : TexturePixelValues)
+            UE_LOG(LogChannelSplitter, Error, TEXT("MaskToolsWorker failed to split %s, the texture is skipped"), *Job.PathName);
+            return false;
+        }
+        if (WorkerResult == EMaskWorkerTaskResult::Unavailable)
         {
+            FMaskToolsWorkerProtocol::RunSplitTask(Task, Result);
+        }
 
-            FColor Pixel = LinearPixel.ToFColor(false);
-            
-            AddPixelToArray(Pixel.R, bExportRed, RChannel);
-            AddPixelToArray(Pixel.G, bExportGreen, GChannel);
-            AddPixelToArray(Pixel.B, bExportBlue, BChannel);
-            AddPixelToArray(Pixel.A, bExportAlpha, AChannel);
-            
+        Job.ChannelPlanes = MoveTemp(Result.Planes);
+        Job.ChannelStats = MoveTemp(Result.Stats);
+        for (int32 ChannelIndex = 0; ChannelIndex < Job.ChannelPlanes.Num(); ++ChannelIndex)
+        {
+            FMaskToolsDiskCache::Get().Store(Job.CacheKeys[ChannelIndex], Job.ChannelPlanes[ChannelIndex], Job.ChannelStats[ChannelIndex]);
         }
-        
-        TArray<bool> bExportChannel;
-        bExportChannel.Add(bExportRed);
-        bExportChannel.Add(bExportGreen);
-        bExportChannel.Add(bExportBlue);
-        bExportChannel.Add(bExportAlpha);
-
-        TArray<TArray<FColor>> ChannelPixelValues;
-        ChannelPixelValues.Add(RChannel);
-        ChannelPixelValues.Add(GChannel);
-        ChannelPixelValues.Add(BChannel);
-        ChannelPixelValues.Add(AChannel);
-
-        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+    }
+
+    // Grayscale textures stored as RGB would otherwise give three identical outputs
+    FMaskToolsKernels::FindDuplicatePlanes(Job.ChannelPlanes, Job.DuplicateOf);
+
+    const int32 NumFilesPerChannel = 1 + Job.ResizedSizes.Num();
+    for (int32 ChannelIndex = 0; ChannelIndex < Job.ChannelPlanes.Num(); ++ChannelIndex)
+    {
+        if (Batch.bDiscardEmptyChannels && !Job.ChannelStats[ChannelIndex].bHasData) continue;
+        if (Job.DuplicateOf[ChannelIndex] != INDEX_NONE && Batch.bSkipDuplicateChannels) continue;
+
+        // G16 or R16F for 16 bit and float precision, which are never block compressed
+        const EMaskBlockFormat BlockFormat = FMaskToolsKernels::ChooseBlockFormat({ Job.ChannelStats[ChannelIndex] }, Batch.PlaneFormat);
+
+        // Smaller copies are resized from the channel already in memory, each from the previous size
+        TArray<FMaskPlane> ResizedPlanes;
+        if (Job.ResizedSizes.Num() > 0)
         {
-            if (_bDiscardEmptyChannels)
+            FMaskToolsKernels::ResizePlaneChain(Job.ChannelPlanes[ChannelIndex], Job.ResizedSizes, FMaskToolsPrivateHelpers::FindResizeMethod(Batch.ResizeMethod), ResizedPlanes);
+        }
+
+        auto AddOutput = [&Batch, &Job, ChannelIndex, BlockFormat](FMaskPlane& Plane, const FString& PackageName, const FString& FilePath, bool bResized)
             {
-                if (!bExportChannel[ChannelIndex])
+                FPixelSplitOutput& Output = Job.Outputs.AddDefaulted_GetRef();
+                Output.ChannelIndex = ChannelIndex;
+                Output.PackageName = PackageName;
+                Output.FilePath = FilePath;
+                Output.BlockFormat = BlockFormat;
+                Output.bResized = bResized;
+
+                // Split channels keep the mip filter of the channel they come from
+                if (Batch.MipSettings.bEnabled && Batch.bExportAssets)
                 {
-                    FString DebugLine = FString::Printf(TEXT("%s channel discarded in texture %s"), *SuffixArray[ChannelIndex], *PathName);
-                    UE_LOG(LogTemp, Warning, TEXT("%s"), *DebugLine);
-                    continue;
+                    const FMaskPlane* ChannelPlane = &Plane;
+                    FMaskToolsKernels::BuildMipImages(MakeArrayView(&ChannelPlane, 1), MakeArrayView(&Batch.MipSettings.Reductions[ChannelIndex], 1),
+                        Batch.MipSettings.CoverageThreshold, Output.Mips);
                 }
-            }
-
-            FCreateTexture2DParameters TextureParameters;
-            TextureParameters.TextureGroup = TextureGroup::TEXTUREGROUP_World;
-            TextureParameters.bSRGB = false;
-            TextureParameters.CompressionSettings = TC_Grayscale;
-            TextureParameters.MipGenSettings = MipGenSettings;
-            TextureParameters.bUseAlpha = false;
-            
-            UTexture2D* NewTexture = FImageUtils::CreateTexture2D(Size, Size, ChannelPixelValues[ChannelIndex], World, TEXT(""), EObjectFlags::RF_KeepForCooker, TextureParameters);
 
-            const FString PackageName = FString::Printf(TEXT("%s%s"), *PathName, *SuffixArray[ChannelIndex]);
-            UTexture2D* SavedTexture = FMaskToolsUtils::CreateStaticTextureEditorOnly(NewTexture, PackageName, TC_Grayscale, TMGS_FromTextureGroup);
+                Plane.MoveToImage(Output.Image);
+                Output.Image.GammaSpace = Job.PlaneGamma;
+            };
 
-            // Notify the editor about changes for safety
-            SavedTexture->PreEditChange(nullptr);
+        AddOutput(Job.ChannelPlanes[ChannelIndex], Job.PackageNames[ChannelIndex], Job.FilePaths[ChannelIndex * NumFilesPerChannel], false);
+        for (int32 SizeIndex = 0; SizeIndex < ResizedPlanes.Num(); ++SizeIndex)
+        {
+            AddOutput(ResizedPlanes[SizeIndex], FMaskToolsPrivateHelpers::GetResizedOutputName(Job.PackageNames[ChannelIndex], Job.ResizedSizes[SizeIndex]),
+                Job.FilePaths[ChannelIndex * NumFilesPerChannel + 1 + SizeIndex], true);
+        }
+    }
 
-            // Paste original texture values
-            SavedTexture->LODBias = LodBias;
-            SavedTexture->MaxTextureSize = MaxTextureSize;
-            SavedTexture->bPreserveBorder = bPreserveBorders;
-            SavedTexture->NeverStream = NeverStream;
+    // Planes that were not exported are no longer needed
+    Job.ChannelPlanes.Empty();
+    return true;
+}
 
-#if UE_VERSION_NEWER_THAN(5, 2, 0)
-            SavedTexture->CookPlatformTilingSettings = CookPlatformTilingSettings;
-#endif // UE_VERSION_NEWER_THAN(5, 2, 0)
+void FChannelSplitter::CreateSplitOutputs(FPixelSplitBatch& Batch, FPixelSplitJob& Job)
+{
+    UTexture2D* Texture = Job.Texture.Get();
+    FMaskToolsUtils::ReportDuplicateChannels(Texture, Job.DuplicateOf);
 
-#if UE_VERSION_NEWER_THAN(5, 4, 0)
-            SavedTexture->bOodlePreserveExtremes = bOodlePreserveExtremes;
-#endif // UE_VERSION_NEWER_THAN(5, 4, 0)
+    UTexture2D* ChannelTextures[4] = {};
+    int32 OutputIndex = 0;
+    for (int32 ChannelIndex = 0; ChannelIndex < Job.DuplicateOf.Num(); ++ChannelIndex)
+    {
+        if (Batch.bDiscardEmptyChannels && !Job.ChannelStats[ChannelIndex].bHasData)
+        {
+            UE_LOG(LogChannelSplitter, Log, TEXT("%s channel discarded in texture %s"), *SuffixArray[ChannelIndex], *Job.PathName);
+            continue;
+        }
 
-            // Notify the editor changes finished
-            SavedTexture->PostEditChange();
-            SavedTexture->MarkPackageDirty();
+        const int32 OriginalChannel = Job.DuplicateOf[ChannelIndex];
+        if (OriginalChannel != INDEX_NONE && Batch.bSkipDuplicateChannels)
+        {
+            UE_LOG(LogChannelSplitter, Log, TEXT("%s channel of texture %s is identical to %s, not exported"),
+                *SuffixArray[ChannelIndex], *Job.PathName, *SuffixArray[OriginalChannel]);
 
+            if (Batch.bExportAssets)
+            {
+                FMaskToolsUtils::ReplaceDuplicateOutput(Job.PackageNames[ChannelIndex], ChannelTextures[OriginalChannel], Batch.bRedirectDuplicateChannels);
+            }
+            continue;
         }
 
+        for (; OutputIndex < Job.Outputs.Num() && Job.Outputs[OutputIndex].ChannelIndex == ChannelIndex; ++OutputIndex)
+        {
+            FPixelSplitOutput& Output = Job.Outputs[OutputIndex];
+            if (!Batch.bExportAssets) continue;
+
+            // Splitting again updates the previous outputs, or leaves them alone when the channel did not change
+            bool bUnchanged = false;
+            UTexture2D* OutputTexture = FMaskToolsUtils::WriteOutputTexture(Output.Image, Output.PackageName, Output.BlockFormat, Texture, nullptr, &bUnchanged, Output.Mips);
+            if (OutputTexture && !bUnchanged)
+            {
+                Batch.CreatedTextures++;
+            }
+            if (!Output.bResized)
+            {
+                ChannelTextures[ChannelIndex] = OutputTexture;
+            }
+
+            // Freed as soon as written, the job stays alive until the pipeline retires it
+            Output.Image = FImage();
+            Output.Mips.Empty();
+        }
     }
 }
 
@@ -8,6 +8,11 @@
 #include <Kismet/KismetMaterialLibrary.h>
 #include <Kismet/KismetRenderingLibrary.h>
 
+class FMaskToolsPipeline;
+class FMaskToolsProgress;
+struct FPixelSplitBatch;
+struct FPixelSplitJob;
+
 class FChannelSplitter : public IModuleInterface
 {
 public:
@@ -22,11 +27,25 @@ private:
 	void AddCBMenuExtension(FMenuBuilder& MenuBuilder);
 	void SplitTextures();
 
-	void SplitTexturesMaterialBased();
-	void SplitTexturesPixelData();
+	/*
+	* Both start a pipeline that keeps running over the next editor frames, counting one unit of Progress per texture.
+	* OnCompleted gets the number of channel textures created.
+	*/
+	void SplitTexturesMaterialBased(const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& Progress, TFunction<void(int32)> OnCompleted);
+	void SplitTexturesPixelData(const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& Progress, TFunction<void(int32)> OnCompleted);
+	int32 SplitTextureMaterialBased(UTexture2D* Texture);
+
+	// Pixel data stages, see SplitTexturesPixelData
+	bool LoadSplitJob(const FPixelSplitBatch& Batch, FPixelSplitJob& Job);
+	bool DecodeSplitJob(const FPixelSplitBatch& Batch, FPixelSplitJob& Job);
+	void CreateSplitOutputs(FPixelSplitBatch& Batch, FPixelSplitJob& Job);
 	void SplitTexturesShaderBased();
 
 	TArray<FAssetData> AssetsSelected;
+
+	// Split still running, its stages call into this module. Only one runs at a time
+	TSharedPtr<FMaskToolsPipeline, ESPMode::ThreadSafe> ActivePipeline;
+	TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> ActiveProgress;
 	const TArray<FString> SuffixArray = { TEXT("_R"), TEXT("_G") ,TEXT("_B"), TEXT("_A") };
 
 	/*
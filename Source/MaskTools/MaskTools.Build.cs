@@ -15,7 +15,9 @@ public class MaskTools : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
-                "ContentBrowser"
+                "ContentBrowser",
+                "ImageCore",
+                "MaskToolsCore"
 			}
 			);
 		
@@ -28,7 +30,6 @@ public class MaskTools : ModuleRules
                 "EditorFramework",
                 "ToolMenus",
                 "UnrealEd",
-                "ImageCore",
                 "Projects"
 			}
 			);
@@ -0,0 +1,231 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskRecipe.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "IAssetTools.h"
+#include "Logging.h"
+#include "MaskToolsAsyncOperation.h"
+#include "MaskToolsBlueprintLibrary.h"
+#include "MaskToolsConfig.h"
+#include "MaskToolsUtils.h"
+#include "Misc/SecureHash.h"
+
+bool UMaskRecipe::NeedsRebuild() const
+{
+    if (OutputTexture.IsNull() || !OutputTexture.LoadSynchronous())
+    {
+        return true;
+    }
+
+    if (BuiltParametersHash != ComputeParametersHash())
+    {
+        return true;
+    }
+
+    for (const TSoftObjectPtr<UTexture2D>& ResizedOutput : ResizedOutputTextures)
+    {
+        if (!ResizedOutput.LoadSynchronous())
+        {
+            return true;
+        }
+    }
+
+    for (const FMaskRecipeSlot* Slot : GetSlots())
+    {
+        if (Slot->BuiltInputHash != FMaskToolsUtils::GetTextureContentHash(Slot->Texture.LoadSynchronous()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+UMaskToolsAsyncOperation* UMaskRecipe::Rebuild(bool bForce)
+{
+    if (PendingOperation && !PendingOperation->IsDone())
+    {
+        UE_LOG(LogMaskTools, Log, TEXT("Recipe %s is already rebuilding"), *GetPathName());
+        return PendingOperation;
+    }
+
+    if (!bForce && !NeedsRebuild())
+    {
+        UE_LOG(LogMaskTools, Verbose, TEXT("Recipe %s is up to date"), *GetPathName());
+        return nullptr;
+    }
+
+    TArray<FMaskPackSlot> PackSlots;
+    PendingInputHashes.Empty();
+    for (const FMaskRecipeSlot* Slot : GetSlots())
+    {
+        FMaskPackSlot& PackSlot = PackSlots.AddDefaulted_GetRef();
+        PackSlot.Texture = Slot->Texture.LoadSynchronous();
+        PackSlot.SourceChannel = Slot->SourceChannel;
+        PackSlot.ResizeMethod = Slot->ResizeMethod;
+        PackSlot.EdgeMode = Slot->EdgeMode;
+        PackSlot.ColorSpace = Slot->ColorSpace;
+
+        PendingInputHashes.Add(FMaskToolsUtils::GetTextureContentHash(PackSlot.Texture));
+    }
+    PendingParametersHash = ComputeParametersHash();
+
+    UTexture2D* ExistingOutput = OutputTexture.LoadSynchronous();
+    const FString PackageName = ExistingOutput ? FMaskToolsUtils::GetCleanPathName(ExistingOutput) : FMaskToolsUtils::GetCleanPathName(this) + TEXT("_Mask");
+
+    // Copies follow the project settings like the mixer export, the ones already built are updated in place
+    const FIntPoint Size = FMaskToolsPrivateHelpers::FindResolutionSize(Resolution, CustomResolution);
+    const TArray<FIntPoint> ResizedSizes = FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(Size, GetDefault<UMaskToolsConfig>()->AdditionalOutputResolutions);
+    TArray<UTexture2D*> ExistingResizedOutputs;
+    for (const FIntPoint& ResizedSize : ResizedSizes)
+    {
+        const FString ResizedName = FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, ResizedSize);
+        const TSoftObjectPtr<UTexture2D>* ResizedOutput = ResizedOutputTextures.FindByPredicate([&ResizedName](const TSoftObjectPtr<UTexture2D>& Output)
+            {
+                return Output.ToSoftObjectPath().GetLongPackageName() == ResizedName;
+            });
+        ExistingResizedOutputs.Add(ResizedOutput ? ResizedOutput->LoadSynchronous() : nullptr);
+    }
+
+    PendingOperation = UMaskToolsBlueprintLibrary::StartPack(PackSlots, Size, PackageName, ExistingOutput, ResizedSizes, ExistingResizedOutputs);
+    PendingOperation->OnCompleted.AddDynamic(this, &UMaskRecipe::OnRebuildCompleted);
+    return PendingOperation;
+}
+
+TArray<UMaskToolsAsyncOperation*> UMaskRecipe::RebuildAllRecipes(bool bForce)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    TArray<FAssetData> RecipeAssets;
+    AssetRegistry.GetAssetsByClass(UMaskRecipe::StaticClass()->GetClassPathName(), RecipeAssets);
+
+    // One pipeline and one notification for the whole project instead of one task per recipe
+    FMaskToolsOperationBatch Batch(TEXT("MaskTools Rebuild recipes"));
+
+    TArray<UMaskToolsAsyncOperation*> Operations;
+    for (const FAssetData& RecipeAsset : RecipeAssets)
+    {
+        UMaskRecipe* Recipe = Cast<UMaskRecipe>(RecipeAsset.GetAsset());
+        if (!Recipe) continue;
+
+        if (UMaskToolsAsyncOperation* Operation = Recipe->Rebuild(bForce))
+        {
+            Operations.Add(Operation);
+        }
+    }
+
+    UE_LOG(LogMaskTools, Log, TEXT("Rebuilding %d of %d mask recipes"), Operations.Num(), RecipeAssets.Num());
+    Batch.RunWithNotification(NSLOCTEXT("MaskRecipe", "RebuildingRecipes", "Rebuilding mask recipes"));
+    return Operations;
+}
+
+void UMaskRecipe::MarkAsBuilt(UTexture2D* InOutputTexture, TConstArrayView<UTexture2D*> InResizedOutputTextures)
+{
+    Modify();
+
+    OutputTexture = InOutputTexture;
+    ResizedOutputTextures.Reset();
+    for (UTexture2D* ResizedOutput : InResizedOutputTextures)
+    {
+        if (ResizedOutput)
+        {
+            ResizedOutputTextures.Add(ResizedOutput);
+        }
+    }
+    BuiltParametersHash = ComputeParametersHash();
+    for (FMaskRecipeSlot* Slot : GetSlots())
+    {
+        Slot->BuiltInputHash = FMaskToolsUtils::GetTextureContentHash(Slot->Texture.LoadSynchronous());
+    }
+
+    MarkPackageDirty();
+}
+
+bool UMaskRecipe::IsOutput(const UTexture2D* Texture) const
+{
+    if (!Texture) return false;
+
+    const FSoftObjectPath TexturePath(Texture);
+    return OutputTexture.ToSoftObjectPath() == TexturePath
+        || ResizedOutputTextures.ContainsByPredicate([&TexturePath](const TSoftObjectPtr<UTexture2D>& Output) { return Output.ToSoftObjectPath() == TexturePath; });
+}
+
+UMaskRecipe* UMaskRecipe::CreateRecipeAsset(const FString& PackageName)
+{
+    IAssetTools& AssetTools = FModuleManager::Get().LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+
+    FString UniquePackageName;
+    FString Name;
+    AssetTools.CreateUniqueAssetName(PackageName, TEXT(""), UniquePackageName, Name);
+
+    UPackage* Package = CreatePackage(*UniquePackageName);
+    UMaskRecipe* Recipe = NewObject<UMaskRecipe>(Package, *Name, RF_Public | RF_Standalone | RF_Transactional);
+
+    FAssetRegistryModule::AssetCreated(Recipe);
+    Recipe->MarkPackageDirty();
+    return Recipe;
+}
+
+TArray<FMaskRecipeSlot*> UMaskRecipe::GetSlots()
+{
+    return { &Red, &Green, &Blue, &Alpha };
+}
+
+TArray<const FMaskRecipeSlot*> UMaskRecipe::GetSlots() const
+{
+    return { &Red, &Green, &Blue, &Alpha };
+}
+
+FString UMaskRecipe::ComputeParametersHash() const
+{
+    const EResizeMethod DefaultResizeMethod = GetDefault<UMaskToolsConfig>()->MixerResizeMethod;
+
+    const FIntPoint Size = FMaskToolsPrivateHelpers::FindResolutionSize(Resolution, CustomResolution);
+    FString Parameters = FString::Printf(TEXT("%dx%d"), Size.X, Size.Y);
+    for (const FMaskRecipeSlot* Slot : GetSlots())
+    {
+        // Default follows the project settings, so the resolved method is what matters
+        const EResizeMethod ResizeMethod = FMaskToolsPrivateHelpers::ResolveResizeMethod(Slot->ResizeMethod, DefaultResizeMethod);
+
+        Parameters += FString::Printf(TEXT("|%s,%d,%u,%d,%d"), *Slot->Texture.ToString(), static_cast<int32>(Slot->SourceChannel), static_cast<uint32>(ResizeMethod),
+            static_cast<int32>(Slot->ColorSpace), static_cast<int32>(Slot->EdgeMode));
+    }
+
+    return FMD5::HashAnsiString(*Parameters);
+}
+
+void UMaskRecipe::OnRebuildCompleted(UMaskToolsAsyncOperation* Operation)
+{
+    if (Operation != PendingOperation) return;
+    PendingOperation = nullptr;
+
+    const TArray<UTexture2D*> Outputs = Operation->GetOutputTextures();
+    if (Operation->GetState() != EMaskToolsOperationState::Succeeded || Outputs.Num() == 0)
+    {
+        UE_LOG(LogMaskTools, Warning, TEXT("Failed to rebuild recipe %s: %s"), *GetPathName(), *Operation->GetErrorMessage());
+        return;
+    }
+
+    Modify();
+
+    // The mask is written first, then its resized copies
+    OutputTexture = Outputs[0];
+    ResizedOutputTextures.Reset();
+    for (int32 OutputIndex = 1; OutputIndex < Outputs.Num(); ++OutputIndex)
+    {
+        ResizedOutputTextures.Add(Outputs[OutputIndex]);
+    }
+    BuiltParametersHash = PendingParametersHash;
+
+    TArray<FMaskRecipeSlot*> Slots = GetSlots();
+    for (int32 SlotIndex = 0; SlotIndex < Slots.Num() && PendingInputHashes.IsValidIndex(SlotIndex); ++SlotIndex)
+    {
+        Slots[SlotIndex]->BuiltInputHash = PendingInputHashes[SlotIndex];
+    }
+
+    MarkPackageDirty();
+    UE_LOG(LogMaskTools, Log, TEXT("Rebuilt recipe %s into %s"), *GetPathName(), *Outputs[0]->GetPathName());
+}
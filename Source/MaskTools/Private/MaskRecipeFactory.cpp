@@ -0,0 +1,18 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskRecipeFactory.h"
+
+#include "MaskRecipe.h"
+
+UMaskRecipeFactory::UMaskRecipeFactory()
+{
+    SupportedClass = UMaskRecipe::StaticClass();
+    bCreateNew = true;
+    bEditAfterNew = true;
+}
+
+UObject* UMaskRecipeFactory::FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn)
+{
+    return NewObject<UMaskRecipe>(InParent, InClass, InName, Flags | RF_Transactional);
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Factories/Factory.h"
+#include "MaskRecipeFactory.generated.h"
+
+/**
+ * Lets mask recipes be created from the content browser.
+ */
+UCLASS()
+class UMaskRecipeFactory : public UFactory
+{
+	GENERATED_BODY()
+
+public:
+	UMaskRecipeFactory();
+
+	virtual UObject* FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn) override;
+};
@@ -2,7 +2,9 @@
 // All rights reserved.
 
 #include "MaskTools.h"
+#include "MaskToolsAutoRebuilder.h"
 #include "MaskToolsConfig.h"
+#include "MaskToolsWorkerPool.h"
 #include "ISettingsModule.h"
 
 #define LOCTEXT_NAMESPACE "FMaskToolsModule"
@@ -10,10 +12,22 @@
 void FMaskToolsModule::StartupModule()
 {
     RegisterSettings();
+    GetDefault<UMaskToolsConfig>()->ApplyDiskCacheSettings();
+
+    AutoRebuilder = MakeUnique<FMaskToolsAutoRebuilder>();
+    AutoRebuilder->Register();
 }
 
 void FMaskToolsModule::ShutdownModule()
 {
+    if (AutoRebuilder)
+    {
+        AutoRebuilder->Unregister();
+        AutoRebuilder.Reset();
+    }
+
+    FMaskToolsWorkerPool::Get().Shutdown();
+
     UnregisterSettings();
 }
 
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsAsyncActions.h"
+
+#include "MaskToolsAsyncOperation.h"
+
+UMaskToolsAsyncAction* UMaskToolsAsyncAction::PackTexturesAsync(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue,
+    const FMaskPackSlot& Alpha, int32 Resolution, const FString& PackageName)
+{
+    UMaskToolsAsyncAction* Action = NewObject<UMaskToolsAsyncAction>();
+    Action->StartOperation = [Red, Green, Blue, Alpha, Resolution, PackageName]()
+        {
+            return UMaskToolsBlueprintLibrary::PackTextures(Red, Green, Blue, Alpha, Resolution, PackageName);
+        };
+    return Action;
+}
+
+UMaskToolsAsyncAction* UMaskToolsAsyncAction::SplitTextureAsync(UTexture2D* Texture, bool bDiscardEmptyChannels)
+{
+    UMaskToolsAsyncAction* Action = NewObject<UMaskToolsAsyncAction>();
+    Action->StartOperation = [Texture, bDiscardEmptyChannels]()
+        {
+            return UMaskToolsBlueprintLibrary::SplitTexture(Texture, bDiscardEmptyChannels);
+        };
+    return Action;
+}
+
+UMaskToolsAsyncAction* UMaskToolsAsyncAction::ComputeChannelStatsAsync(UTexture2D* Texture)
+{
+    UMaskToolsAsyncAction* Action = NewObject<UMaskToolsAsyncAction>();
+    Action->StartOperation = [Texture]()
+        {
+            return UMaskToolsBlueprintLibrary::ComputeChannelStats(Texture);
+        };
+    return Action;
+}
+
+void UMaskToolsAsyncAction::Activate()
+{
+    if (!StartOperation)
+    {
+        SetReadyToDestroy();
+        return;
+    }
+
+    // Editor scripts have no game instance to register with, keep the node alive until the operation reports back
+    AddToRoot();
+
+    Operation = StartOperation();
+    StartOperation.Reset();
+    Operation->OnCompleted.AddDynamic(this, &UMaskToolsAsyncAction::HandleOperationCompleted);
+}
+
+void UMaskToolsAsyncAction::HandleOperationCompleted(UMaskToolsAsyncOperation* CompletedOperation)
+{
+    if (CompletedOperation->GetState() == EMaskToolsOperationState::Succeeded)
+    {
+        OnSucceeded.Broadcast(CompletedOperation);
+    }
+    else
+    {
+        OnFailed.Broadcast(CompletedOperation);
+    }
+
+    RemoveFromRoot();
+    SetReadyToDestroy();
+}
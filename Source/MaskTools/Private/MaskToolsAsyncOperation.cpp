@@ -0,0 +1,264 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsAsyncOperation.h"
+
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "Logging.h"
+#include "MaskToolsConfig.h"
+#include "MaskToolsProgress.h"
+#include "MaskToolsProgressNotification.h"
+#include "MaskToolsStats.h"
+#include "MaskToolsUtils.h"
+
+void UMaskToolsAsyncOperation::Start(const TArray<UTexture2D*>& Inputs, FWorkerFunction&& Worker, const FString& InDescription)
+{
+    check(IsInGameThread());
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Async operation, %d inputs"), Inputs.Num());
+
+    InputTextures.Append(Inputs);
+    Description = InDescription;
+    AddToRoot();
+
+    if (FMaskToolsOperationBatch* Batch = FMaskToolsOperationBatch::Current)
+    {
+        BatchWorker = MoveTemp(Worker);
+        Batch->Operations.Add(this);
+        return;
+    }
+
+    MemoryTracker = MakeUnique<FMaskToolsPeakMemoryTracker>();
+
+    TWeakObjectPtr<UMaskToolsAsyncOperation> WeakThis(this);
+    FMaskToolsOperationResult* WorkerResult = &Result;
+    bool* WorkerSucceeded = &bWorkerSucceeded;
+
+    WorkerFuture = Async(EAsyncExecution::ThreadPool, [Worker = MoveTemp(Worker), WorkerResult, WorkerSucceeded]() mutable
+        {
+            TRACE_CPUPROFILER_EVENT_SCOPE(UMaskToolsAsyncOperation::Worker);
+            LLM_SCOPE_BYTAG(MaskTools);
+            *WorkerSucceeded = Worker(*WorkerResult);
+            return *WorkerSucceeded;
+        },
+        [WeakThis]()
+        {
+            AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+                {
+                    if (UMaskToolsAsyncOperation* Operation = WeakThis.Get())
+                    {
+                        Operation->FinishOnGameThread();
+                    }
+                });
+        });
+}
+
+void UMaskToolsAsyncOperation::WaitForCompletion()
+{
+    check(IsInGameThread());
+
+    if (IsDone()) return;
+
+    // A batched operation finishes through its pipeline, which then also runs the rest of the batch
+    if (const TSharedPtr<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = BatchPipeline.Pin())
+    {
+        Pipeline->Wait();
+    }
+    if (WorkerFuture.IsValid())
+    {
+        WorkerFuture.Wait();
+    }
+    FinishOnGameThread();
+}
+
+void UMaskToolsAsyncOperation::FinishOnGameThread()
+{
+    // Both the completion task and WaitForCompletion can land here
+    if (IsDone()) return;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMaskToolsAsyncOperation::FinishOnGameThread);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    if (WorkerFuture.IsValid())
+    {
+        WorkerFuture.Wait();
+    }
+
+    int32 UnchangedTextures = 0;
+    for (FMaskToolsPendingTexture& PendingTexture : Result.Textures)
+    {
+        bool bUnchanged = false;
+        UTexture2D* SavedTexture = FMaskToolsUtils::WriteOutputTexture(PendingTexture.Image, PendingTexture.PackageName, PendingTexture.BlockFormat,
+            PendingTexture.SettingsSource, PendingTexture.ExistingTexture, &bUnchanged, PendingTexture.Mips);
+        if (!SavedTexture)
+        {
+            continue;
+        }
+
+        UnchangedTextures += bUnchanged ? 1 : 0;
+        OutputTextures.Add(SavedTexture);
+    }
+
+    OutputFiles = MoveTemp(Result.Files);
+    ChannelStats = MoveTemp(Result.ChannelStats);
+    ErrorMessage = MoveTemp(Result.ErrorMessage);
+    Result = FMaskToolsOperationResult();
+
+    // Asset creation is part of the operation, so the tracker is only stopped now
+    if (MemoryTracker)
+    {
+        PeakMemoryBytes = MemoryTracker->Stop();
+        ElapsedSeconds = static_cast<float>(MemoryTracker->GetElapsedSeconds());
+        MemoryTracker.Reset();
+    }
+
+    State = bWorkerSucceeded ? EMaskToolsOperationState::Succeeded : EMaskToolsOperationState::Failed;
+    if (!bWorkerSucceeded)
+    {
+        UE_LOG(LogMaskToolsUtils, Warning, TEXT("Mask tools operation failed: %s"), *ErrorMessage);
+    }
+
+    UE_LOG(LogMaskToolsUtils, Log, TEXT("Mask tools operation wrote %d textures, %d already up to date, in %.2f s, peak working set %.1f MB"),
+        OutputTextures.Num() - UnchangedTextures, UnchangedTextures, ElapsedSeconds, PeakMemoryBytes / (1024.0 * 1024.0));
+
+    InputTextures.Empty();
+    RemoveFromRoot();
+
+    OnCompleted.Broadcast(this);
+}
+
+FMaskToolsOperationBatch* FMaskToolsOperationBatch::Current = nullptr;
+
+namespace MaskToolsAsyncOperation
+{
+    struct FBatchJob : public FMaskToolsPipelineJob
+    {
+        UMaskToolsAsyncOperation* Operation = nullptr;
+    };
+}
+
+FMaskToolsOperationBatch::FMaskToolsOperationBatch(const FString& InName)
+    : Name(InName)
+{
+    check(IsInGameThread());
+    check(!Current);
+    Current = this;
+}
+
+FMaskToolsOperationBatch::~FMaskToolsOperationBatch()
+{
+    // Collected operations are rooted, they have to finish one way or another
+    Run();
+}
+
+void FMaskToolsOperationBatch::Run(TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> Progress, TFunction<void(int32)> OnCompleted)
+{
+    using namespace MaskToolsAsyncOperation;
+    check(IsInGameThread());
+
+    if (bRun) return;
+    bRun = true;
+    if (Current == this)
+    {
+        Current = nullptr;
+    }
+
+    if (Operations.Num() == 0)
+    {
+        if (OnCompleted)
+        {
+            OnCompleted(0);
+        }
+        return;
+    }
+
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Batch %s, %d operations"), *Name, Operations.Num());
+
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(Name, Config->MaxTexturesInFlight);
+    Pipeline->SetMemoryBudget(Config->GetMemoryBudget());
+    Pipeline->SetProgress(Progress);
+
+    Pipeline->AddStage(TEXT("Compute"), EMaskPipelineThread::Worker, [Progress](FMaskToolsPipelineJob& Job)
+        {
+            TRACE_CPUPROFILER_EVENT_SCOPE(UMaskToolsAsyncOperation::Worker);
+            LLM_SCOPE_BYTAG(MaskTools);
+
+            UMaskToolsAsyncOperation* Operation = static_cast<FBatchJob&>(Job).Operation;
+            if (Progress && !Operation->Description.IsEmpty())
+            {
+                Progress->SetStatus(Operation->Description);
+            }
+            Operation->bWorkerSucceeded = Operation->BatchWorker(Operation->Result);
+            Operation->BatchWorker.Reset();
+            return true;
+        });
+
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [](FMaskToolsPipelineJob& Job)
+        {
+            UMaskToolsAsyncOperation* Operation = static_cast<FBatchJob&>(Job).Operation;
+            Operation->FinishOnGameThread();
+            return Operation->GetState() == EMaskToolsOperationState::Succeeded;
+        });
+
+    for (UMaskToolsAsyncOperation* Operation : Operations)
+    {
+        Operation->BatchPipeline = Pipeline;
+
+        TUniquePtr<FBatchJob> Job = MakeUnique<FBatchJob>();
+        Job->Operation = Operation;
+        Pipeline->AddJob(MoveTemp(Job));
+    }
+
+    TSharedRef<FMaskToolsPeakMemoryTracker> MemoryTracker = MakeShared<FMaskToolsPeakMemoryTracker>();
+    Pipeline->Start([Operations = Operations, MemoryTracker, OnCompleted = MoveTemp(OnCompleted), BatchName = Name]()
+        {
+            // Jobs dropped by a cancel never reached a stage
+            int32 NumSucceeded = 0;
+            for (UMaskToolsAsyncOperation* Operation : Operations)
+            {
+                if (!Operation->IsDone())
+                {
+                    Operation->BatchWorker.Reset();
+                    Operation->Result.ErrorMessage = TEXT("Cancelled before it started");
+                    Operation->FinishOnGameThread();
+                }
+                NumSucceeded += Operation->GetState() == EMaskToolsOperationState::Succeeded ? 1 : 0;
+            }
+
+            const int64 PeakMemoryBytes = MemoryTracker->Stop();
+            UE_LOG(LogMaskToolsUtils, Log, TEXT("%s ran %d of %d operations successfully in %.2f s, peak working set %.1f MB"),
+                *BatchName, NumSucceeded, Operations.Num(), MemoryTracker->GetElapsedSeconds(), PeakMemoryBytes / (1024.0 * 1024.0));
+
+            if (OnCompleted)
+            {
+                OnCompleted(NumSucceeded);
+            }
+        });
+}
+
+void FMaskToolsOperationBatch::RunWithNotification(const FText& Title, TFunction<void(int32)> OnCompleted)
+{
+    check(IsInGameThread());
+
+    if (bRun || Operations.Num() == 0)
+    {
+        Run(nullptr, MoveTemp(OnCompleted));
+        return;
+    }
+
+    TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe> Progress = MakeShared<FMaskToolsProgress, ESPMode::ThreadSafe>();
+    TSharedRef<FMaskToolsProgressNotification> Notification = FMaskToolsProgressNotification::Open(Title, Progress);
+
+    // Operations cancelled before they started fail too, the notification shows those as cancelled instead
+    Run(Progress, [Notification, NumOperations = Operations.Num(), OnCompleted = MoveTemp(OnCompleted)](int32 NumSucceeded)
+        {
+            Notification->Close(NumOperations - NumSucceeded);
+            if (OnCompleted)
+            {
+                OnCompleted(NumSucceeded);
+            }
+        });
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsAutoRebuilder.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "Engine/Texture2D.h"
+#include "Logging.h"
+#include "MaskRecipe.h"
+#include "MaskToolsAsyncOperation.h"
+#include "MaskToolsBlueprintLibrary.h"
+#include "MaskToolsConfig.h"
+#include "MaskToolsStats.h"
+#include "Misc/CoreDelegates.h"
+#include "Subsystems/ImportSubsystem.h"
+
+FMaskToolsAutoRebuilder::~FMaskToolsAutoRebuilder()
+{
+    Unregister();
+}
+
+void FMaskToolsAutoRebuilder::Register()
+{
+    if (GIsRunning)
+    {
+        RegisterImportDelegates();
+    }
+    else if (!PostEngineInitHandle.IsValid())
+    {
+        PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FMaskToolsAutoRebuilder::RegisterImportDelegates);
+    }
+}
+
+void FMaskToolsAutoRebuilder::RegisterImportDelegates()
+{
+    FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+    PostEngineInitHandle.Reset();
+
+    if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FMaskToolsAutoRebuilder::OnAssetReimport);
+        PostImportHandle = ImportSubsystem->OnAssetPostImport.AddRaw(this, &FMaskToolsAutoRebuilder::OnAssetPostImport);
+    }
+}
+
+void FMaskToolsAutoRebuilder::Unregister()
+{
+    FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+    PostEngineInitHandle.Reset();
+
+    if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+        ImportSubsystem->OnAssetPostImport.Remove(PostImportHandle);
+    }
+    ReimportHandle.Reset();
+    PostImportHandle.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+    FlushHandle.Reset();
+    PendingTextures.Empty();
+}
+
+void FMaskToolsAutoRebuilder::OnAssetReimport(UObject* Asset)
+{
+    QueueTexture(Asset);
+}
+
+void FMaskToolsAutoRebuilder::OnAssetPostImport(UFactory* Factory, UObject* Asset)
+{
+    // Importing over an existing texture does not go through the reimport path
+    QueueTexture(Asset);
+}
+
+void FMaskToolsAutoRebuilder::QueueTexture(UObject* Asset)
+{
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    if (!Config->bAutoRebuildOnReimport || !Cast<UTexture2D>(Asset))
+    {
+        return;
+    }
+
+    PendingTextures.Add(FSoftObjectPath(Asset));
+
+    // Restart the delay on every import so a burst ends up in a single flush
+    FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+    FlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMaskToolsAutoRebuilder::Flush), Config->AutoRebuildDelay);
+}
+
+bool FMaskToolsAutoRebuilder::Flush(float DeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsAutoRebuilder::Flush);
+    LLM_SCOPE_BYTAG(MaskTools);
+    TRACE_BOOKMARK(TEXT("MaskTools Auto rebuild, %d textures"), PendingTextures.Num());
+
+    FlushHandle.Reset();
+    const TSet<FSoftObjectPath> Textures = MoveTemp(PendingTextures);
+    PendingTextures.Reset();
+
+    const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    const bool bDiscardEmptyChannels = GetDefault<UMaskToolsConfig>()->bDiscardEmptyChannels;
+
+    // Several reimported textures often feed the same recipe, rebuild it once
+    TSet<UMaskRecipe*> Recipes;
+    int32 SplitOperations = 0;
+
+    // Every rebuild started below joins one pipeline run
+    FMaskToolsOperationBatch Batch(TEXT("MaskTools Auto rebuild"));
+
+    for (const FSoftObjectPath& TexturePath : Textures)
+    {
+        UTexture2D* Texture = Cast<UTexture2D>(TexturePath.ResolveObject());
+        if (!IsValid(Texture)) continue;
+
+        TArray<FName> Referencers;
+        AssetRegistry.GetReferencers(Texture->GetOutermost()->GetFName(), Referencers);
+        for (const FName& Referencer : Referencers)
+        {
+            TArray<FAssetData> ReferencerAssets;
+            AssetRegistry.GetAssetsByPackageName(Referencer, ReferencerAssets);
+            for (const FAssetData& ReferencerAsset : ReferencerAssets)
+            {
+                if (ReferencerAsset.IsInstanceOf(UMaskRecipe::StaticClass()))
+                {
+                    // Recipes also reference their outputs and resized copies, only inputs trigger a rebuild
+                    UMaskRecipe* Recipe = Cast<UMaskRecipe>(ReferencerAsset.GetAsset());
+                    if (Recipe && !Recipe->IsOutput(Texture))
+                    {
+                        Recipes.Add(Recipe);
+                    }
+                }
+            }
+        }
+
+        // Only outputs that already exist are regenerated, discarded channels stay discarded
+        const TArray<UTexture2D*> SplitOutputs = UMaskToolsBlueprintLibrary::FindSplitOutputs(Texture);
+        if (SplitOutputs.ContainsByPredicate([](const UTexture2D* Output) { return Output != nullptr; }))
+        {
+            UMaskToolsBlueprintLibrary::StartSplit(Texture, bDiscardEmptyChannels, SplitOutputs);
+            SplitOperations++;
+        }
+    }
+
+    int32 RecipeOperations = 0;
+    for (UMaskRecipe* Recipe : Recipes)
+    {
+        if (Recipe->Rebuild())
+        {
+            RecipeOperations++;
+        }
+    }
+
+    UE_LOG(LogMaskTools, Log, TEXT("%d imported textures scheduled %d mask rebuilds and %d splits"), Textures.Num(), RecipeOperations, SplitOperations);
+    Batch.RunWithNotification(NSLOCTEXT("MaskToolsAutoRebuilder", "RebuildingMasks", "Rebuilding masks"));
+    return false;
+}
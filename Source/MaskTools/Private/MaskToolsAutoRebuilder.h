@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UFactory;
+class UTexture2D;
+
+/**
+ * Listens to texture imports and reimports and regenerates the masks and split outputs built from them.
+ * Bursts of imports are coalesced, nothing runs until no texture was imported for the configured delay,
+ * and then every rebuild of the burst runs as a single batch.
+ */
+class FMaskToolsAutoRebuilder
+{
+public:
+    ~FMaskToolsAutoRebuilder();
+
+    // Listens right away when the engine is running, otherwise once it finished initializing
+    void Register();
+    void Unregister();
+
+private:
+    // The import subsystem only exists once the editor engine is initialized
+    void RegisterImportDelegates();
+
+    void OnAssetReimport(UObject* Asset);
+    void OnAssetPostImport(UFactory* Factory, UObject* Asset);
+    void QueueTexture(UObject* Asset);
+
+    bool Flush(float DeltaTime);
+
+    TSet<FSoftObjectPath> PendingTextures;
+
+    FTSTicker::FDelegateHandle FlushHandle;
+    FDelegateHandle PostEngineInitHandle;
+    FDelegateHandle ReimportHandle;
+    FDelegateHandle PostImportHandle;
+};
@@ -0,0 +1,486 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsBenchmark.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/xxhash.h"
+#include "Interfaces/IPluginManager.h"
+#include "Logging.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace MaskToolsBenchmark
+{
+    // Enough work per measurement to get stable timings on small resolutions
+    constexpr int64 TargetPixelsPerMeasurement = 64 * 1024 * 1024;
+    constexpr int32 MaxIterations = 32;
+
+    uint32 HashPixel(uint32 Value)
+    {
+        Value ^= Value >> 16;
+        Value *= 0x7feb352dU;
+        Value ^= Value >> 15;
+        Value *= 0x846ca68bU;
+        Value ^= Value >> 16;
+        return Value;
+    }
+
+    uint64 HashImage(const FImage& Image)
+    {
+        return FXxHash64::HashBuffer(Image.RawData.GetData(), Image.RawData.Num()).Hash;
+    }
+
+    EMaskPlaneFormat GetPlaneFormat(EMaskToolsBenchmarkSource Source)
+    {
+        switch (Source)
+        {
+        case EMaskToolsBenchmarkSource::U16:
+            return EMaskPlaneFormat::U16;
+        case EMaskToolsBenchmarkSource::F32:
+            return EMaskPlaneFormat::F32;
+        case EMaskToolsBenchmarkSource::U8:
+        default:
+            return EMaskPlaneFormat::U8;
+        }
+    }
+
+    /*
+    * Times Function Iterations times and fills the timing and memory fields of OutResult.
+    */
+    void Measure(int32 Resolution, TFunctionRef<void()> Function, FMaskToolsBenchmarkResult& OutResult)
+    {
+        const int64 Pixels = static_cast<int64>(Resolution) * Resolution;
+        const int32 Iterations = static_cast<int32>(FMath::Clamp<int64>(TargetPixelsPerMeasurement / Pixels, 1, MaxIterations));
+
+        // Warm up caches and the thread pool when the measurement is cheap enough to repeat
+        if (Iterations > 1)
+        {
+            Function();
+        }
+
+        TArray<double> Timings;
+        Timings.Reserve(Iterations);
+
+        FMaskToolsPeakMemoryTracker MemoryTracker;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Function();
+            Timings.Add(FPlatformTime::Seconds() - StartTime);
+        }
+        OutResult.PeakMemoryBytes = MemoryTracker.Stop();
+
+        Timings.Sort();
+        const double MedianSeconds = Timings[Timings.Num() / 2];
+
+        OutResult.Resolution = Resolution;
+        OutResult.Iterations = Iterations;
+        OutResult.Milliseconds = MedianSeconds * 1000.0;
+        OutResult.MegaPixelsPerSecond = MedianSeconds > 0.0 ? Pixels / MedianSeconds / 1000000.0 : 0.0;
+    }
+}
+
+FString FMaskToolsBenchmarkResult::GetKey() const
+{
+    return Variant.IsEmpty()
+        ? FString::Printf(TEXT("%s/%s/%d"), *Operation, *SourceFormat, Resolution)
+        : FString::Printf(TEXT("%s/%s/%s/%d"), *Operation, *Variant, *SourceFormat, Resolution);
+}
+
+void FMaskToolsBenchmark::Run(EMaskToolsBenchmarkOperation Operation, int32 MaxResolution, TArray<FMaskToolsBenchmarkResult>& OutResults)
+{
+    using namespace MaskToolsBenchmark;
+
+    const EMaskToolsBenchmarkSource Sources[] = { EMaskToolsBenchmarkSource::U8, EMaskToolsBenchmarkSource::U16, EMaskToolsBenchmarkSource::F32 };
+
+    const EResizeMethod ResizeMethods[] =
+    {
+        EResizeMethod::Default, EResizeMethod::PointSample, EResizeMethod::Box, EResizeMethod::Triangle, EResizeMethod::Bilinear,
+        EResizeMethod::CubicGaussian, EResizeMethod::CubicSharp, EResizeMethod::CubicMitchell, EResizeMethod::AdaptiveSharp, EResizeMethod::AdaptiveSmooth
+    };
+
+    const UEnum* ResolutionEnum = StaticEnum<EMaskResolutions>();
+    for (int32 EnumIndex = 0; EnumIndex < ResolutionEnum->NumEnums() - 1; ++EnumIndex)
+    {
+        const EMaskResolutions MaskResolution = static_cast<EMaskResolutions>(ResolutionEnum->GetValueByIndex(EnumIndex));
+        if (MaskResolution == EMaskResolutions::Custom)
+        {
+            continue;
+        }
+
+        const int32 Resolution = FMaskToolsPrivateHelpers::FindResolution(MaskResolution);
+        if (Resolution > MaxResolution)
+        {
+            continue;
+        }
+
+        for (const EMaskToolsBenchmarkSource Source : Sources)
+        {
+            const EMaskPlaneFormat PlaneFormat = GetPlaneFormat(Source);
+            const int32 FirstResultIndex = OutResults.Num();
+
+            FMaskToolsBenchmarkResult Result;
+            Result.Operation = GetOperationName(Operation);
+            Result.SourceFormat = GetSourceName(Source);
+
+            switch (Operation)
+            {
+            case EMaskToolsBenchmarkOperation::Pack:
+            {
+                TArray<FImage> SourceImages;
+                SourceImages.SetNum(4);
+                for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+                {
+                    MakeSourceImage(Source, Resolution, ChannelIndex, SourceImages[ChannelIndex]);
+                }
+
+                FImage LastOutput;
+                Measure(Resolution, [&SourceImages, PlaneFormat, &LastOutput]()
+                    {
+                        FMaskPlane Planes[4];
+                        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+                        {
+                            FMaskToolsKernels::ExtractPlane(SourceImages[ChannelIndex], static_cast<EMaskChannel>(ChannelIndex), PlaneFormat, EGammaSpace::Linear, Planes[ChannelIndex]);
+                        }
+
+                        const FMaskPlane* PackPlanes[4] = { &Planes[0], &Planes[1], &Planes[2], &Planes[3] };
+                        FImage PackedImage;
+                        FMaskToolsKernels::Pack(PackPlanes, PackedImage);
+                        LastOutput = MoveTemp(PackedImage);
+                    }, Result);
+
+                Result.OutputHash = HashImage(LastOutput);
+                OutResults.Add(Result);
+                break;
+            }
+
+            case EMaskToolsBenchmarkOperation::Split:
+            {
+                FImage SourceImage;
+                MakeSourceImage(Source, Resolution, 0, SourceImage);
+
+                TArray<FMaskPlane> LastOutput;
+                Measure(Resolution, [&SourceImage, PlaneFormat, &LastOutput]()
+                    {
+                        TArray<FMaskPlane> Planes;
+                        FMaskToolsKernels::Unpack(SourceImage, PlaneFormat, EGammaSpace::Linear, Planes);
+                        for (const FMaskPlane& Plane : Planes)
+                        {
+                            FMaskToolsKernels::ComputeStats(Plane);
+                        }
+                        LastOutput = MoveTemp(Planes);
+                    }, Result);
+
+                FXxHash64Builder HashBuilder;
+                for (const FMaskPlane& Plane : LastOutput)
+                {
+                    HashBuilder.Update(Plane.RawData.GetData(), Plane.RawData.Num());
+                }
+                Result.OutputHash = HashBuilder.Finalize().Hash;
+                OutResults.Add(Result);
+                break;
+            }
+
+            case EMaskToolsBenchmarkOperation::Resize:
+            {
+                FImage SourceImage;
+                MakeSourceImage(Source, Resolution, 0, SourceImage);
+
+                FMaskPlane SourcePlane;
+                FMaskToolsKernels::ExtractPlane(SourceImage, EMaskChannel::Red, PlaneFormat, EGammaSpace::Linear, SourcePlane);
+
+                // Halve the source, the common case of big sources packed into a smaller mask
+                const int32 DestinationSize = FMath::Max(Resolution / 2, 1);
+                for (const EResizeMethod ResizeMethod : ResizeMethods)
+                {
+                    const FImageCore::EResizeImageFilter Filter = FMaskToolsPrivateHelpers::FindResizeMethod(ResizeMethod);
+
+                    FMaskToolsBenchmarkResult ResizeResult = Result;
+                    ResizeResult.Variant = StaticEnum<EResizeMethod>()->GetNameStringByValue(static_cast<int64>(ResizeMethod));
+
+                    FImage LastOutput;
+                    Measure(Resolution, [&SourceImage, DestinationSize, Filter, &LastOutput]()
+                        {
+                            FImage ResizedImage;
+                            FMaskToolsKernels::ResizeImage(SourceImage, DestinationSize, DestinationSize, Filter, ResizedImage);
+                            LastOutput = MoveTemp(ResizedImage);
+                        }, ResizeResult);
+
+                    ResizeResult.OutputHash = HashImage(LastOutput);
+                    OutResults.Add(ResizeResult);
+
+                    // The single channel resampler the mixer and splitter use
+                    FMaskToolsBenchmarkResult PlaneResult = Result;
+                    PlaneResult.Variant = ResizeResult.Variant + TEXT("Plane");
+
+                    FMaskPlane LastPlane;
+                    Measure(Resolution, [&SourcePlane, DestinationSize, Filter, &LastPlane]()
+                        {
+                            FMaskPlane ResizedPlane;
+                            FMaskToolsKernels::ResizePlane(SourcePlane, DestinationSize, DestinationSize, Filter, ResizedPlane);
+                            LastPlane = MoveTemp(ResizedPlane);
+                        }, PlaneResult);
+
+                    PlaneResult.OutputHash = FXxHash64::HashBuffer(LastPlane.RawData.GetData(), LastPlane.RawData.Num()).Hash;
+                    OutResults.Add(PlaneResult);
+                }
+                break;
+            }
+
+            case EMaskToolsBenchmarkOperation::Stats:
+            {
+                FImage SourceImage;
+                MakeSourceImage(Source, Resolution, 0, SourceImage);
+
+                FMaskPlane Plane;
+                FMaskToolsKernels::ExtractPlane(SourceImage, EMaskChannel::Red, PlaneFormat, EGammaSpace::Linear, Plane);
+
+                FMaskPlaneStats LastOutput;
+                Measure(Resolution, [&Plane, &LastOutput]()
+                    {
+                        LastOutput = FMaskToolsKernels::ComputeStats(Plane);
+                    }, Result);
+
+                const float StatValues[] = { LastOutput.Min, LastOutput.Max, LastOutput.Mean, LastOutput.bHasData ? 1.f : 0.f, LastOutput.bIsConstant ? 1.f : 0.f };
+                Result.OutputHash = FXxHash64::HashBuffer(StatValues, sizeof(StatValues)).Hash;
+                OutResults.Add(Result);
+                break;
+            }
+            }
+
+            for (int32 ResultIndex = FirstResultIndex; ResultIndex < OutResults.Num(); ++ResultIndex)
+            {
+                const FMaskToolsBenchmarkResult& NewResult = OutResults[ResultIndex];
+                UE_LOG(LogMaskToolsUtils, Display, TEXT("%s: %.3f ms, %.1f MPix/s"), *NewResult.GetKey(), NewResult.Milliseconds, NewResult.MegaPixelsPerSecond);
+            }
+        }
+    }
+}
+
+bool FMaskToolsBenchmark::WriteCsv(const TArray<FMaskToolsBenchmarkResult>& Results, const FString& FilePath)
+{
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Operation,Variant,SourceFormat,Resolution,Iterations,Milliseconds,MPixPerSecond,PeakMemoryMB,OutputHash"));
+
+    for (const FMaskToolsBenchmarkResult& Result : Results)
+    {
+        Lines.Add(FString::Printf(TEXT("%s,%s,%s,%d,%d,%.4f,%.2f,%.2f,%016llx"),
+            *Result.Operation, *Result.Variant, *Result.SourceFormat, Result.Resolution, Result.Iterations,
+            Result.Milliseconds, Result.MegaPixelsPerSecond, Result.PeakMemoryBytes / (1024.0 * 1024.0), Result.OutputHash));
+    }
+
+    return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
+
+bool FMaskToolsBenchmark::ReadCsv(const FString& FilePath, TArray<FMaskToolsBenchmarkResult>& OutResults)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+    {
+        return false;
+    }
+
+    // First line is the header
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        TArray<FString> Fields;
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+        if (Fields.Num() < 8)
+        {
+            continue;
+        }
+
+        FMaskToolsBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.Operation = Fields[0];
+        Result.Variant = Fields[1];
+        Result.SourceFormat = Fields[2];
+        Result.Resolution = FCString::Atoi(*Fields[3]);
+        Result.Iterations = FCString::Atoi(*Fields[4]);
+        Result.Milliseconds = FCString::Atod(*Fields[5]);
+        Result.MegaPixelsPerSecond = FCString::Atod(*Fields[6]);
+        Result.PeakMemoryBytes = static_cast<int64>(FCString::Atod(*Fields[7]) * 1024.0 * 1024.0);
+        Result.OutputHash = Fields.IsValidIndex(8) ? FCString::Strtoui64(*Fields[8], nullptr, 16) : 0;
+    }
+
+    return true;
+}
+
+TArray<FString> FMaskToolsBenchmark::Compare(const TArray<FMaskToolsBenchmarkResult>& Results, const TArray<FMaskToolsBenchmarkResult>& Baseline, float TimeThreshold, float MemoryThreshold,
+    TArray<FString>* OutMissing)
+{
+    // Below these the difference is timer and allocator noise, mostly on the smallest resolutions
+    constexpr double MinRegressionMilliseconds = 0.05;
+    constexpr int64 MinRegressionBytes = 4 * 1024 * 1024;
+
+    TMap<FString, const FMaskToolsBenchmarkResult*> BaselineByKey;
+    for (const FMaskToolsBenchmarkResult& BaselineResult : Baseline)
+    {
+        BaselineByKey.Add(BaselineResult.GetKey(), &BaselineResult);
+    }
+
+    TArray<FString> Regressions;
+    for (const FMaskToolsBenchmarkResult& Result : Results)
+    {
+        const FMaskToolsBenchmarkResult* const* BaselineResultPtr = BaselineByKey.Find(Result.GetKey());
+        if (!BaselineResultPtr)
+        {
+            if (OutMissing)
+            {
+                OutMissing->Add(Result.GetKey());
+            }
+            continue;
+        }
+        const FMaskToolsBenchmarkResult& BaselineResult = **BaselineResultPtr;
+
+        const double MaxMilliseconds = BaselineResult.Milliseconds * (1.0 + TimeThreshold / 100.0);
+        if (Result.Milliseconds > MaxMilliseconds && Result.Milliseconds - BaselineResult.Milliseconds > MinRegressionMilliseconds)
+        {
+            Regressions.Add(FString::Printf(TEXT("%s is slower: %.3f ms, baseline %.3f ms (+%.1f%%)"),
+                *Result.GetKey(), Result.Milliseconds, BaselineResult.Milliseconds, (Result.Milliseconds / BaselineResult.Milliseconds - 1.0) * 100.0));
+        }
+
+        const int64 MaxBytes = static_cast<int64>(BaselineResult.PeakMemoryBytes * (1.0 + MemoryThreshold / 100.0));
+        if (Result.PeakMemoryBytes > MaxBytes && Result.PeakMemoryBytes - BaselineResult.PeakMemoryBytes > MinRegressionBytes)
+        {
+            Regressions.Add(FString::Printf(TEXT("%s uses more memory: %.1f MB, baseline %.1f MB"),
+                *Result.GetKey(), Result.PeakMemoryBytes / (1024.0 * 1024.0), BaselineResult.PeakMemoryBytes / (1024.0 * 1024.0)));
+        }
+
+        if (Result.OutputHash != 0 && BaselineResult.OutputHash != 0 && Result.OutputHash != BaselineResult.OutputHash)
+        {
+            Regressions.Add(FString::Printf(TEXT("%s output changed: hash %016llx, baseline %016llx"),
+                *Result.GetKey(), Result.OutputHash, BaselineResult.OutputHash));
+        }
+    }
+
+    return Regressions;
+}
+
+void FMaskToolsBenchmark::MergeIntoBaseline(const TArray<FMaskToolsBenchmarkResult>& Results, TArray<FMaskToolsBenchmarkResult>& InOutBaseline)
+{
+    for (const FMaskToolsBenchmarkResult& Result : Results)
+    {
+        const FString Key = Result.GetKey();
+        FMaskToolsBenchmarkResult* Existing = InOutBaseline.FindByPredicate([&Key](const FMaskToolsBenchmarkResult& BaselineResult)
+            {
+                return BaselineResult.GetKey() == Key;
+            });
+
+        if (Existing)
+        {
+            *Existing = Result;
+        }
+        else
+        {
+            InOutBaseline.Add(Result);
+        }
+    }
+}
+
+FString FMaskToolsBenchmark::GetOperationName(EMaskToolsBenchmarkOperation Operation)
+{
+    switch (Operation)
+    {
+    case EMaskToolsBenchmarkOperation::Pack:
+        return TEXT("Pack");
+    case EMaskToolsBenchmarkOperation::Split:
+        return TEXT("Split");
+    case EMaskToolsBenchmarkOperation::Resize:
+        return TEXT("Resize");
+    case EMaskToolsBenchmarkOperation::Stats:
+        return TEXT("Stats");
+    default:
+        return TEXT("Unknown");
+    }
+}
+
+FString FMaskToolsBenchmark::GetSourceName(EMaskToolsBenchmarkSource Source)
+{
+    switch (Source)
+    {
+    case EMaskToolsBenchmarkSource::U8:
+        return TEXT("U8");
+    case EMaskToolsBenchmarkSource::U16:
+        return TEXT("U16");
+    case EMaskToolsBenchmarkSource::F32:
+        return TEXT("F32");
+    default:
+        return TEXT("Unknown");
+    }
+}
+
+void FMaskToolsBenchmark::MakeSourceImage(EMaskToolsBenchmarkSource Source, int32 Resolution, int32 Seed, FImage& OutImage)
+{
+    using namespace MaskToolsBenchmark;
+
+    switch (Source)
+    {
+    case EMaskToolsBenchmarkSource::U16:
+        OutImage.Init(Resolution, Resolution, ERawImageFormat::RGBA16, EGammaSpace::Linear);
+        break;
+    case EMaskToolsBenchmarkSource::F32:
+        OutImage.Init(Resolution, Resolution, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+        break;
+    case EMaskToolsBenchmarkSource::U8:
+    default:
+        OutImage.Init(Resolution, Resolution, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+        break;
+    }
+
+    // Half gradient, half noise, so channels are neither constant nor trivially compressible
+    ParallelFor(Resolution, [&OutImage, Source, Resolution, Seed](int32 Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                float Values[4];
+                for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+                {
+                    const uint32 Noise = HashPixel(static_cast<uint32>(Y * Resolution + X) * 4u + ChannelIndex + static_cast<uint32>(Seed) * 0x9e3779b9U);
+                    const float Gradient = static_cast<float>(X + Y) / (2.f * Resolution);
+                    Values[ChannelIndex] = 0.5f * Gradient + 0.5f * (Noise & 0xffff) / 65535.f;
+                }
+
+                const int64 PixelIndex = static_cast<int64>(Y) * Resolution + X;
+                switch (Source)
+                {
+                case EMaskToolsBenchmarkSource::U16:
+                {
+                    uint16* Pixel = reinterpret_cast<uint16*>(OutImage.RawData.GetData()) + PixelIndex * 4;
+                    for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+                    {
+                        Pixel[ChannelIndex] = static_cast<uint16>(Values[ChannelIndex] * 65535.f + 0.5f);
+                    }
+                    break;
+                }
+                case EMaskToolsBenchmarkSource::F32:
+                    OutImage.AsRGBA32F()[PixelIndex] = FLinearColor(Values[0], Values[1], Values[2], Values[3]);
+                    break;
+                case EMaskToolsBenchmarkSource::U8:
+                default:
+                    OutImage.AsBGRA8()[PixelIndex] = FLinearColor(Values[0], Values[1], Values[2], Values[3]).QuantizeRound();
+                    break;
+                }
+            }
+        });
+}
+
+FString FMaskToolsBenchmark::GetDefaultOutputDir()
+{
+    return FPaths::ProjectSavedDir() / TEXT("MaskTools") / TEXT("Benchmarks");
+}
+
+FString FMaskToolsBenchmark::GetDefaultBaselinePath()
+{
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MaskTools"));
+    if (!Plugin.IsValid())
+    {
+        return FString();
+    }
+
+    return Plugin->GetBaseDir() / TEXT("Resources") / TEXT("Benchmarks") / TEXT("MaskToolsPerfBaseline.csv");
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+#include "MaskPlane.h"
+#include "MaskToolsEnums.h"
+
+enum class EMaskToolsBenchmarkOperation : uint8
+{
+    Pack,
+    Split,
+    Resize,
+    Stats
+};
+
+enum class EMaskToolsBenchmarkSource : uint8
+{
+    U8,
+    U16,
+    F32
+};
+
+/**
+ * Timing of one operation on one source format and resolution.
+ */
+struct FMaskToolsBenchmarkResult
+{
+    FString Operation;
+
+    // Resize method for resize results, empty otherwise
+    FString Variant;
+
+    FString SourceFormat;
+    int32 Resolution = 0;
+    int32 Iterations = 0;
+
+    // Median time of a single iteration
+    double Milliseconds = 0.0;
+    double MegaPixelsPerSecond = 0.0;
+
+    // Highest process memory growth seen while the operation ran
+    int64 PeakMemoryBytes = 0;
+
+    // Hash of the output of the last iteration, 0 if unknown
+    uint64 OutputHash = 0;
+
+    // Identifies the result across runs, e.g. "Resize/CubicSharp/U8/1024"
+    FString GetKey() const;
+};
+
+/**
+ * Times the core pixel kernels on synthetic sources for every EMaskResolutions value.
+ * Runs headless, so it works under -nullrhi and in commandlets.
+ */
+struct FMaskToolsBenchmark
+{
+    /*
+    * Runs an operation for every source format and every resolution up to MaxResolution.
+    */
+    static void Run(EMaskToolsBenchmarkOperation Operation, int32 MaxResolution, TArray<FMaskToolsBenchmarkResult>& OutResults);
+
+    static bool WriteCsv(const TArray<FMaskToolsBenchmarkResult>& Results, const FString& FilePath);
+
+    static bool ReadCsv(const FString& FilePath, TArray<FMaskToolsBenchmarkResult>& OutResults);
+
+    /*
+    * Checks results against a baseline, matching them by key.
+    * Time and memory fail when they grow more than Threshold percent and above a small noise floor.
+    * Output hashes fail on any difference. Results missing from the baseline are not compared, their keys are added
+    * to OutMissing when given. Returns one message per regression.
+    */
+    static TArray<FString> Compare(const TArray<FMaskToolsBenchmarkResult>& Results, const TArray<FMaskToolsBenchmarkResult>& Baseline, float TimeThreshold, float MemoryThreshold,
+        TArray<FString>* OutMissing = nullptr);
+
+    /*
+    * Replaces the baseline entries that share a key with a result and adds the new ones.
+    */
+    static void MergeIntoBaseline(const TArray<FMaskToolsBenchmarkResult>& Results, TArray<FMaskToolsBenchmarkResult>& InOutBaseline);
+
+    static FString GetOperationName(EMaskToolsBenchmarkOperation Operation);
+
+    static FString GetSourceName(EMaskToolsBenchmarkSource Source);
+
+    /*
+    * Deterministic RGBA test image, so every run and every machine processes the same data.
+    */
+    static void MakeSourceImage(EMaskToolsBenchmarkSource Source, int32 Resolution, int32 Seed, FImage& OutImage);
+
+    // Default output folder, Saved/MaskTools/Benchmarks
+    static FString GetDefaultOutputDir();
+
+    // Checked in baseline, Resources/Benchmarks/MaskToolsPerfBaseline.csv in the plugin folder
+    static FString GetDefaultBaselinePath();
+};
@@ -0,0 +1,481 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsBlueprintLibrary.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "MaskToolsAsyncOperation.h"
+#include "MaskToolsConfig.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsImageFiles.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsUtils.h"
+#include "MaskToolsWorkerProtocol.h"
+#include "Misc/PackageName.h"
+
+namespace MaskToolsBlueprintLibrary
+{
+    const TCHAR* SplitSuffixes[4] = { TEXT("_R"), TEXT("_G"), TEXT("_B"), TEXT("_A") };
+
+    // Input of a single pack slot, copied on the game thread before the worker starts
+    // A cached plane replaces the source image, so cache hits skip the decode entirely
+    struct FPackSlotData
+    {
+        FImage Image;
+        FMaskPlane CachedPlane;
+        FMaskPlaneStats CachedStats;
+        FString CacheKey;
+        EMaskChannel Channel = EMaskChannel::Red;
+        EResizeMethod ResizeMethod = EResizeMethod::Default;
+        EGammaSpace SourceGamma = EGammaSpace::Linear;
+        bool bValid = false;
+        bool bCached = false;
+    };
+
+    FPackSlotData GatherPackSlot(const FMaskPackSlot& Slot, FIntPoint Size, EMaskPlaneFormat Format)
+    {
+        FPackSlotData SlotData;
+        SlotData.Channel = FMaskToolsPrivateHelpers::FindMaskChannel(Slot.SourceChannel);
+        SlotData.ResizeMethod = FMaskToolsPrivateHelpers::CombineResizeMethod(
+            FMaskToolsPrivateHelpers::ResolveResizeMethod(Slot.ResizeMethod, GetDefault<UMaskToolsConfig>()->MixerResizeMethod), Slot.EdgeMode);
+        if (!Slot.Texture) return SlotData;
+
+        // Masks are sampled as data, so every input ends up linear. Resolved the same way as the mixer inputs
+        SlotData.SourceGamma = FMaskToolsPrivateHelpers::FindInputGammaSpace(Slot.ColorSpace, GetDefault<UMaskToolsConfig>()->InputColorSpace,
+            FMaskToolsPrivateHelpers::FindTextureGammaSpace(Slot.Texture));
+        SlotData.CacheKey = FMaskToolsUtils::GetPlaneCacheKey(Slot.Texture, SlotData.Channel, Size.X, Size.Y, SlotData.ResizeMethod,
+            Format, EGammaSpace::Linear, SlotData.SourceGamma);
+        SlotData.bCached = FMaskToolsDiskCache::Get().Load(SlotData.CacheKey, SlotData.CachedPlane, &SlotData.CachedStats);
+        SlotData.bValid = SlotData.bCached || FMaskToolsUtils::GetTextureSourceImage(Slot.Texture, SlotData.Image);
+        return SlotData;
+    }
+
+    // Keys of the unpacked channels of a texture decoded at SizeX by SizeY, the same ones the texture splitter uses
+    TArray<FString> GetSplitCacheKeys(const UTexture2D* Texture, int32 SizeX, int32 SizeY, EResizeMethod ResizeMethod, EMaskPlaneFormat Format,
+        EGammaSpace Gamma, EGammaSpace SourceGamma)
+    {
+        TArray<FString> CacheKeys;
+        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+        {
+            CacheKeys.Add(FMaskToolsUtils::GetPlaneCacheKey(Texture, static_cast<EMaskChannel>(ChannelIndex), SizeX, SizeY,
+                ResizeMethod, Format, Gamma, SourceGamma));
+        }
+        return CacheKeys;
+    }
+
+    // Only textures the mask tools wrote are kept in sync, not hand authored ones that share the name
+    UTexture2D* FindOutputTexture(const IAssetRegistry& AssetRegistry, const FString& PackageName)
+    {
+        const FSoftObjectPath OutputPath(PackageName + TEXT(".") + FPackageName::GetShortName(PackageName));
+        const FAssetData OutputAsset = AssetRegistry.GetAssetByObjectPath(OutputPath);
+        UTexture2D* Output = OutputAsset.IsValid() ? Cast<UTexture2D>(OutputAsset.GetAsset()) : nullptr;
+        return FMaskToolsPrivateHelpers::IsMaskToolsOutput(Output) ? Output : nullptr;
+    }
+
+    // Only a full hit avoids the decode, a partial one is recomputed and stored again
+    bool LoadSplitPlanes(const TArray<FString>& CacheKeys, TArray<FMaskPlane>& OutPlanes, TArray<FMaskPlaneStats>& OutStats)
+    {
+        OutPlanes.SetNum(CacheKeys.Num());
+        OutStats.SetNum(CacheKeys.Num());
+        for (int32 ChannelIndex = 0; ChannelIndex < CacheKeys.Num(); ++ChannelIndex)
+        {
+            if (!FMaskToolsDiskCache::Get().Load(CacheKeys[ChannelIndex], OutPlanes[ChannelIndex], &OutStats[ChannelIndex]))
+            {
+                OutPlanes.Empty();
+                OutStats.Empty();
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::PackTextures(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue,
+    const FMaskPackSlot& Alpha, int32 Resolution, const FString& PackageName)
+{
+    return StartPack({ Red, Green, Blue, Alpha }, FIntPoint(Resolution, Resolution), PackageName);
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::PackTexturesToSize(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue,
+    const FMaskPackSlot& Alpha, int32 SizeX, int32 SizeY, const FString& PackageName)
+{
+    return StartPack({ Red, Green, Blue, Alpha }, FIntPoint(SizeX, SizeY), PackageName);
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::StartPack(const TArray<FMaskPackSlot>& PackSlots, FIntPoint Size, const FString& PackageName, UTexture2D* ExistingTexture,
+    const TArray<FIntPoint>& ResizedSizes, const TArray<UTexture2D*>& ExistingResizedTextures)
+{
+    using namespace MaskToolsBlueprintLibrary;
+    check(PackSlots.Num() == 4);
+
+    UMaskToolsAsyncOperation* Operation = NewObject<UMaskToolsAsyncOperation>();
+
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    const EMaskPlaneFormat PlaneFormat = FMaskToolsPrivateHelpers::FindPlaneFormat(Config->MaskPrecision);
+    const bool bChooseCompression = Config->bChooseCompressionFromChannels;
+    const FMaskMipSettings MipSettings = FMaskToolsPrivateHelpers::FindMipSettings();
+
+    TArray<FPackSlotData> Slots;
+    TArray<UTexture2D*> Inputs;
+    for (const FMaskPackSlot& PackSlot : PackSlots)
+    {
+        Slots.Add(GatherPackSlot(PackSlot, Size, PlaneFormat));
+        Inputs.Add(PackSlot.Texture);
+    }
+    Inputs.Add(ExistingTexture);
+    Inputs.Append(ExistingResizedTextures);
+
+    Operation->Start(Inputs,
+        [Slots = MoveTemp(Slots), Size, PackageName, ExistingTexture, ResizedSizes, ExistingResizedTextures, PlaneFormat, bChooseCompression, MipSettings](FMaskToolsOperationResult& Result)
+        {
+            if (!FMaskToolsPrivateHelpers::IsValidMaskSize(Size.X, Size.Y) || PackageName.IsEmpty())
+            {
+                Result.ErrorMessage = FString::Printf(TEXT("Invalid package name or size %dx%d, sizes go from 1 to %d"), Size.X, Size.Y, FMaskPlane::MaxSize);
+                return false;
+            }
+
+            FMaskPlane Planes[4];
+            FMaskPlaneStats PlaneStats[4];
+            ParallelFor(4, [&Slots, &Planes, &PlaneStats, Size, PlaneFormat](int32 SlotIndex)
+                {
+                    const FPackSlotData& Slot = Slots[SlotIndex];
+                    if (!Slot.bValid) return;
+
+                    if (Slot.bCached)
+                    {
+                        Planes[SlotIndex] = Slot.CachedPlane;
+                        PlaneStats[SlotIndex] = Slot.CachedStats;
+                        return;
+                    }
+
+                    // Same encoding the texture mixer uses
+                    FImageView SourceImage = Slot.Image;
+                    SourceImage.GammaSpace = Slot.SourceGamma;
+                    FMaskToolsKernels::ExtractResizedPlane(SourceImage, Slot.Channel, PlaneFormat, EGammaSpace::Linear,
+                        Size.X, Size.Y, FMaskToolsPrivateHelpers::FindResizeMethod(Slot.ResizeMethod), Planes[SlotIndex]);
+                    PlaneStats[SlotIndex] = FMaskToolsKernels::ComputeStats(Planes[SlotIndex]);
+
+                    FMaskToolsDiskCache::Get().Store(Slot.CacheKey, Planes[SlotIndex], PlaneStats[SlotIndex]);
+                });
+
+            const FMaskPlane* PackPlanes[4];
+            for (int32 SlotIndex = 0; SlotIndex < 4; ++SlotIndex)
+            {
+                PackPlanes[SlotIndex] = Slots[SlotIndex].bValid ? &Planes[SlotIndex] : nullptr;
+                Result.ChannelStats.Add(FMaskChannelStats(PlaneStats[SlotIndex]));
+            }
+
+            FMaskToolsPendingTexture& PendingTexture = Result.Textures.AddDefaulted_GetRef();
+            PendingTexture.PackageName = PackageName;
+            PendingTexture.ExistingTexture = ExistingTexture;
+
+            // An empty alpha slot is packed as white
+            if (!Slots[3].bValid)
+            {
+                PlaneStats[3].Min = PlaneStats[3].Max = PlaneStats[3].Mean = 1.f;
+            }
+            PendingTexture.BlockFormat = FMaskToolsPrivateHelpers::FindMaskBlockFormat(PlaneStats, PlaneFormat, bChooseCompression);
+            if (!FMaskToolsKernels::Pack(PackPlanes, PendingTexture.Image))
+            {
+                Result.ErrorMessage = TEXT("None of the pack slots has a valid texture");
+                Result.Textures.Empty();
+                return false;
+            }
+
+            if (MipSettings.bEnabled)
+            {
+                FMaskToolsKernels::BuildMipImages(PackPlanes, MipSettings.Reductions, MipSettings.CoverageThreshold, PendingTexture.Mips);
+            }
+
+            // Copies are resized from the packed channels, each slot with its own filter and edge mode, and packed again
+            TArray<FMaskPlane> Chains[4];
+            for (int32 SlotIndex = 0; SlotIndex < 4 && ResizedSizes.Num() > 0; ++SlotIndex)
+            {
+                if (!PackPlanes[SlotIndex]) continue;
+
+                FMaskToolsKernels::ResizePlaneChain(Planes[SlotIndex], ResizedSizes, FMaskToolsPrivateHelpers::FindResizeMethod(Slots[SlotIndex].ResizeMethod), Chains[SlotIndex]);
+                Planes[SlotIndex] = FMaskPlane();
+            }
+
+            for (int32 SizeIndex = 0; SizeIndex < ResizedSizes.Num(); ++SizeIndex)
+            {
+                const FMaskPlane* CopyPlanes[4];
+                FMaskPlaneStats CopyStats[4];
+                for (int32 SlotIndex = 0; SlotIndex < 4; ++SlotIndex)
+                {
+                    CopyPlanes[SlotIndex] = PackPlanes[SlotIndex] ? &Chains[SlotIndex][SizeIndex] : nullptr;
+                    if (CopyPlanes[SlotIndex])
+                    {
+                        CopyStats[SlotIndex] = FMaskToolsKernels::ComputeStats(*CopyPlanes[SlotIndex]);
+                    }
+                }
+                if (!CopyPlanes[3])
+                {
+                    CopyStats[3].Min = CopyStats[3].Max = CopyStats[3].Mean = 1.f;
+                }
+
+                FMaskToolsPendingTexture& Copy = Result.Textures.AddDefaulted_GetRef();
+                Copy.PackageName = FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, ResizedSizes[SizeIndex]);
+                Copy.ExistingTexture = ExistingResizedTextures.IsValidIndex(SizeIndex) ? ExistingResizedTextures[SizeIndex] : nullptr;
+                Copy.BlockFormat = FMaskToolsPrivateHelpers::FindMaskBlockFormat(CopyStats, PlaneFormat, bChooseCompression);
+                FMaskToolsKernels::Pack(CopyPlanes, Copy.Image);
+
+                if (MipSettings.bEnabled)
+                {
+                    FMaskToolsKernels::BuildMipImages(CopyPlanes, MipSettings.Reductions, MipSettings.CoverageThreshold, Copy.Mips);
+                }
+            }
+            return true;
+        }, FString::Printf(TEXT("Packing %s"), *FPackageName::GetShortName(PackageName)));
+
+    return Operation;
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::SplitTexture(UTexture2D* Texture, bool bDiscardEmptyChannels)
+{
+    return StartSplit(Texture, bDiscardEmptyChannels);
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::SplitTextureToFiles(UTexture2D* Texture, const FString& Directory, EMaskFileFormat Format, bool bDiscardEmptyChannels)
+{
+    return StartSplit(Texture, bDiscardEmptyChannels, {}, Directory.IsEmpty() ? GetDefault<UMaskToolsConfig>()->GetImageFileDirectory() : Directory, Format);
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::StartSplit(UTexture2D* Texture, bool bDiscardEmptyChannels, const TArray<UTexture2D*>& ExistingOutputs,
+    const FString& FileDirectory, EMaskFileFormat FileFormat)
+{
+    using namespace MaskToolsBlueprintLibrary;
+
+    UMaskToolsAsyncOperation* Operation = NewObject<UMaskToolsAsyncOperation>();
+
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    const EMaskPlaneFormat PlaneFormat = FMaskToolsPrivateHelpers::FindPlaneFormat(Config->MaskPrecision);
+    const FMaskMipSettings MipSettings = FMaskToolsPrivateHelpers::FindMipSettings();
+    const EResizeMethod ResizeMethod = FMaskToolsPrivateHelpers::CombineResizeMethod(Config->SplitterResizeMethod, Config->SplitterEdgeMode);
+
+    EGammaSpace SourceGamma;
+    EGammaSpace PlaneGamma;
+    FMaskToolsPrivateHelpers::FindSplitGammaSpaces(Texture, PlaneFormat, SourceGamma, PlaneGamma);
+
+    // Same size, filter and resized copies as the texture splitter, so a rebuild gives the outputs the menu split wrote
+    const FIntPoint Size = IsValid(Texture) ? FIntPoint(Texture->GetSizeX(), Texture->GetSizeY()) : FIntPoint::ZeroValue;
+    const TArray<FIntPoint> ResizedSizes = FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(Size, Config->AdditionalOutputResolutions);
+    TArray<FString> CacheKeys;
+    if (Size.X > 0 && Size.Y > 0)
+    {
+        CacheKeys = GetSplitCacheKeys(Texture, Size.X, Size.Y, ResizeMethod, PlaneFormat, PlaneGamma, SourceGamma);
+    }
+
+    TArray<FMaskPlane> Planes;
+    TArray<FMaskPlaneStats> PlaneStats;
+    const bool bCached = CacheKeys.Num() > 0 && LoadSplitPlanes(CacheKeys, Planes, PlaneStats);
+
+    FImage Image;
+    const bool bValidImage = bCached || FMaskToolsUtils::GetTextureSourceImage(Texture, Image);
+    const FString PathName = bValidImage ? FMaskToolsUtils::GetCleanPathName(Texture) : FString();
+    const FString FileBaseName = bValidImage && !FileDirectory.IsEmpty() ? FileDirectory / Texture->GetName() : FString();
+    const EMaskImageFileFormat ImageFileFormat = FMaskToolsPrivateHelpers::FindImageFileFormat(FileFormat);
+
+    if (!bCached && bValidImage)
+    {
+        Image.GammaSpace = SourceGamma;
+    }
+
+    // Outputs that already exist are kept in sync even when they duplicate another channel
+    const bool bSkipDuplicates = ExistingOutputs.Num() == 0 && Config->bSkipDuplicateChannels;
+
+    // Resized copies of the outputs being rebuilt are updated in place, in the same channel then size order they are written
+    TArray<UTexture2D*> ExistingResizedOutputs;
+    if (ExistingOutputs.Num() > 0 && ResizedSizes.Num() > 0)
+    {
+        const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+        {
+            for (const FIntPoint& ResizedSize : ResizedSizes)
+            {
+                ExistingResizedOutputs.Add(FindOutputTexture(AssetRegistry,
+                    FMaskToolsPrivateHelpers::GetResizedOutputName(PathName + SplitSuffixes[ChannelIndex], ResizedSize)));
+            }
+        }
+    }
+
+    TArray<UTexture2D*> Inputs = ExistingOutputs;
+    Inputs.Append(ExistingResizedOutputs);
+    Inputs.Add(Texture);
+
+    Operation->Start(Inputs,
+        [Image = MoveTemp(Image), Planes = MoveTemp(Planes), PlaneStats = MoveTemp(PlaneStats), CacheKeys = MoveTemp(CacheKeys), Size, ResizedSizes, ResizeMethod,
+        bCached, bValidImage, bSkipDuplicates, PlaneFormat, PlaneGamma, MipSettings, PathName, FileBaseName, ImageFileFormat, Texture, bDiscardEmptyChannels,
+        ExistingOutputs, ExistingResizedOutputs](FMaskToolsOperationResult& Result) mutable
+        {
+            if (!bValidImage)
+            {
+                Result.ErrorMessage = TEXT("Failed to get texture pixel data");
+                return false;
+            }
+
+            const FImageCore::EResizeImageFilter Filter = FMaskToolsPrivateHelpers::FindResizeMethod(ResizeMethod);
+            if (!bCached)
+            {
+                // Same decode the texture splitter hands to its workers, resized to the built texture size
+                FMaskToolsSplitTask Task;
+                Task.Image = MoveTemp(Image);
+                Task.PlaneFormat = PlaneFormat;
+                Task.PlaneGamma = PlaneGamma;
+                Task.SizeX = Size.X;
+                Task.SizeY = Size.Y;
+                Task.Filter = Filter;
+
+                FMaskToolsSplitResult SplitResult;
+                FMaskToolsWorkerProtocol::RunSplitTask(Task, SplitResult);
+                Planes = MoveTemp(SplitResult.Planes);
+                PlaneStats = MoveTemp(SplitResult.Stats);
+                for (int32 ChannelIndex = 0; ChannelIndex < Planes.Num() && ChannelIndex < CacheKeys.Num(); ++ChannelIndex)
+                {
+                    FMaskToolsDiskCache::Get().Store(CacheKeys[ChannelIndex], Planes[ChannelIndex], PlaneStats[ChannelIndex]);
+                }
+            }
+
+            TArray<int32> DuplicateOf;
+            FMaskToolsKernels::FindDuplicatePlanes(Planes, DuplicateOf);
+
+            TArray<FImage> FileImages;
+            for (int32 ChannelIndex = 0; ChannelIndex < Planes.Num(); ++ChannelIndex)
+            {
+                FMaskChannelStats Stats(PlaneStats[ChannelIndex]);
+                Stats.DuplicateOfChannel = DuplicateOf[ChannelIndex];
+                Result.ChannelStats.Add(Stats);
+
+                if (bSkipDuplicates && Stats.DuplicateOfChannel != INDEX_NONE)
+                {
+                    continue;
+                }
+
+                if (bDiscardEmptyChannels && !Stats.bHasData)
+                {
+                    continue;
+                }
+
+                UTexture2D* ExistingOutput = ExistingOutputs.IsValidIndex(ChannelIndex) ? ExistingOutputs[ChannelIndex] : nullptr;
+                if (FileBaseName.IsEmpty() && ExistingOutputs.Num() > 0 && !ExistingOutput)
+                {
+                    continue;
+                }
+
+                // Smaller copies are resized from the channel already in memory, each from the previous size
+                TArray<FMaskPlane> ResizedPlanes;
+                if (ResizedSizes.Num() > 0)
+                {
+                    FMaskToolsKernels::ResizePlaneChain(Planes[ChannelIndex], ResizedSizes, Filter, ResizedPlanes);
+                }
+
+                // The copies keep the block format of their channel, as in the texture splitter
+                const EMaskBlockFormat BlockFormat = FMaskToolsKernels::ChooseBlockFormat({ PlaneStats[ChannelIndex] }, PlaneFormat);
+                auto AddOutput = [&Result, &FileImages, &MipSettings, &FileBaseName, ImageFileFormat, PlaneGamma, BlockFormat, Texture, ChannelIndex]
+                    (FMaskPlane& Plane, const FString& PackageName, const FString& FileName, UTexture2D* ExistingTexture)
+                    {
+                        if (!FileBaseName.IsEmpty())
+                        {
+                            Plane.MoveToImage(FileImages.AddDefaulted_GetRef());
+                            FileImages.Last().GammaSpace = PlaneGamma;
+                            Result.Files.Add(FileName + FMaskToolsImageFiles::GetExtension(ImageFileFormat));
+                            return;
+                        }
+
+                        FMaskToolsPendingTexture& PendingTexture = Result.Textures.AddDefaulted_GetRef();
+                        PendingTexture.PackageName = PackageName;
+                        PendingTexture.BlockFormat = BlockFormat;
+                        PendingTexture.SettingsSource = Texture;
+                        PendingTexture.ExistingTexture = ExistingTexture;
+
+                        // A split channel keeps the mip filter of the channel it comes from
+                        if (MipSettings.bEnabled)
+                        {
+                            const FMaskPlane* ChannelPlane = &Plane;
+                            FMaskToolsKernels::BuildMipImages(MakeArrayView(&ChannelPlane, 1), MakeArrayView(&MipSettings.Reductions[ChannelIndex], 1),
+                                MipSettings.CoverageThreshold, PendingTexture.Mips);
+                        }
+                        Plane.MoveToImage(PendingTexture.Image);
+                        PendingTexture.Image.GammaSpace = PlaneGamma;
+                    };
+
+                const FString PackageName = PathName + SplitSuffixes[ChannelIndex];
+                const FString FileName = FileBaseName + SplitSuffixes[ChannelIndex];
+                AddOutput(Planes[ChannelIndex], PackageName, FileName, ExistingOutput);
+                for (int32 SizeIndex = 0; SizeIndex < ResizedPlanes.Num(); ++SizeIndex)
+                {
+                    const int32 ExistingIndex = ChannelIndex * ResizedSizes.Num() + SizeIndex;
+                    AddOutput(ResizedPlanes[SizeIndex], FMaskToolsPrivateHelpers::GetResizedOutputName(PackageName, ResizedSizes[SizeIndex]),
+                        FMaskToolsPrivateHelpers::GetResizedOutputName(FileName, ResizedSizes[SizeIndex]),
+                        ExistingResizedOutputs.IsValidIndex(ExistingIndex) ? ExistingResizedOutputs[ExistingIndex] : nullptr);
+                }
+            }
+
+            if (FileImages.Num() > 0)
+            {
+                const TArray<FImageView> FileViews(FileImages);
+                if (FMaskToolsImageFiles::SaveImages(FileViews, Result.Files, ImageFileFormat) != FileImages.Num())
+                {
+                    Result.ErrorMessage = TEXT("Failed to write some of the image files");
+                    return false;
+                }
+            }
+            return true;
+        }, FString::Printf(TEXT("Splitting %s"), *GetNameSafe(Texture)));
+
+    return Operation;
+}
+
+TArray<UTexture2D*> UMaskToolsBlueprintLibrary::FindSplitOutputs(UTexture2D* Texture)
+{
+    using namespace MaskToolsBlueprintLibrary;
+
+    TArray<UTexture2D*> Outputs;
+    if (!IsValid(Texture)) return Outputs;
+
+    const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    const FString PathName = FMaskToolsUtils::GetCleanPathName(Texture);
+
+    for (const TCHAR* Suffix : SplitSuffixes)
+    {
+        Outputs.Add(FindOutputTexture(AssetRegistry, PathName + Suffix));
+    }
+
+    return Outputs;
+}
+
+UMaskToolsAsyncOperation* UMaskToolsBlueprintLibrary::ComputeChannelStats(UTexture2D* Texture)
+{
+    UMaskToolsAsyncOperation* Operation = NewObject<UMaskToolsAsyncOperation>();
+
+    FImage Image;
+    const bool bValidImage = FMaskToolsUtils::GetTextureSourceImage(Texture, Image);
+
+    Operation->Start({ Texture },
+        [Image = MoveTemp(Image), bValidImage](FMaskToolsOperationResult& Result)
+        {
+            if (!bValidImage)
+            {
+                Result.ErrorMessage = TEXT("Failed to get texture pixel data");
+                return false;
+            }
+
+            TArray<FMaskPlane> Planes;
+            FMaskToolsKernels::Unpack(Image, EMaskPlaneFormat::U8, EGammaSpace::Linear, Planes);
+
+            TArray<int32> DuplicateOf;
+            FMaskToolsKernels::FindDuplicatePlanes(Planes, DuplicateOf);
+
+            for (int32 ChannelIndex = 0; ChannelIndex < Planes.Num(); ++ChannelIndex)
+            {
+                FMaskChannelStats& Stats = Result.ChannelStats.Emplace_GetRef(FMaskToolsKernels::ComputeStats(Planes[ChannelIndex]));
+                Stats.DuplicateOfChannel = DuplicateOf[ChannelIndex];
+            }
+            return true;
+        }, FString::Printf(TEXT("Computing the channel stats of %s"), *GetNameSafe(Texture)));
+
+    return Operation;
+}
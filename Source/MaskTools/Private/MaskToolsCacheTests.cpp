@@ -0,0 +1,196 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "ImageCore.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsUtils.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaskToolsCacheTests
+{
+    // Each test works in its own folder so the project cache is left alone
+    FString GetTestCacheDir(const TCHAR* TestName)
+    {
+        return FPaths::AutomationTransientDir() / TEXT("MaskToolsCache") / TestName;
+    }
+
+    // Noise does not compress, so the entries on disk are about as large as the planes
+    void MakeNoisePlane(int32 SizeX, int32 SizeY, int32 Seed, FMaskPlane& OutPlane)
+    {
+        OutPlane.Init(SizeX, SizeY, EMaskPlaneFormat::U8);
+
+        FRandomStream Random(Seed);
+        for (uint8& Value : OutPlane.AsU8())
+        {
+            Value = static_cast<uint8>(Random.RandHelper(256));
+        }
+    }
+
+    int64 GetFolderSize(const FString& Directory)
+    {
+        int64 TotalBytes = 0;
+        IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&TotalBytes](const TCHAR* Path, const FFileStatData& StatData)
+            {
+                TotalBytes += StatData.bIsDirectory ? 0 : StatData.FileSize;
+                return true;
+            });
+        return TotalBytes;
+    }
+}
+
+/*
+* A stored plane is read back with the same size, format, pixels and stats.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsCacheRoundTripTest, "MaskTools.Cache.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsCacheRoundTripTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsCacheTests;
+
+    FMaskToolsDiskCache Cache(GetTestCacheDir(TEXT("RoundTrip")));
+    Cache.Clear();
+
+    FMaskPlane Plane;
+    MakeNoisePlane(37, 19, 1, Plane);
+
+    FMaskPlaneStats Stats;
+    Stats.Min = 0.25f;
+    Stats.Max = 0.75f;
+    Stats.Mean = 0.5f;
+    Stats.bHasData = true;
+    Stats.bIsConstant = false;
+
+    const FString Key = FMaskToolsDiskCache::MakeKey(TEXT("Source"), TEXT("RoundTrip"));
+    Cache.Store(Key, Plane, Stats);
+
+    FMaskPlane LoadedPlane;
+    FMaskPlaneStats LoadedStats;
+    if (!TestTrue(TEXT("Stored plane is loaded"), Cache.Load(Key, LoadedPlane, &LoadedStats)))
+    {
+        Cache.Clear();
+        return false;
+    }
+
+    TestEqual(TEXT("SizeX"), LoadedPlane.SizeX, Plane.SizeX);
+    TestEqual(TEXT("SizeY"), LoadedPlane.SizeY, Plane.SizeY);
+    TestTrue(TEXT("Format"), LoadedPlane.Format == Plane.Format);
+    TestTrue(TEXT("Pixels"), LoadedPlane.RawData == Plane.RawData);
+    TestEqual(TEXT("Min"), LoadedStats.Min, Stats.Min);
+    TestEqual(TEXT("Max"), LoadedStats.Max, Stats.Max);
+    TestEqual(TEXT("Mean"), LoadedStats.Mean, Stats.Mean);
+    TestEqual(TEXT("bHasData"), LoadedStats.bHasData, Stats.bHasData);
+    TestEqual(TEXT("bIsConstant"), LoadedStats.bIsConstant, Stats.bIsConstant);
+
+    TestFalse(TEXT("Unknown key misses"), Cache.Load(FMaskToolsDiskCache::MakeKey(TEXT("Source"), TEXT("Other")), LoadedPlane));
+    TestFalse(TEXT("Empty key misses"), Cache.Load(FString(), LoadedPlane));
+
+    Cache.Clear();
+    return true;
+}
+
+/*
+* Changing any single input of a plane cache key gives a key the stored plane is not found under.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsCacheKeyTest, "MaskTools.Cache.Key", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsCacheKeyTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsCacheTests;
+
+    FImage Image(4, 4, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+    FMemory::Memset(Image.RawData.GetData(), 0x80, Image.RawData.Num());
+    UTexture2D* Texture = FMaskToolsUtils::CreateTransientTexture(Image, TC_Masks, TMGS_NoMipmaps);
+
+    auto GetKey = [Texture](EMaskChannel Channel, int32 SizeX, int32 SizeY, EResizeMethod ResizeMethod, EMaskPlaneFormat Format,
+        EGammaSpace Gamma, EGammaSpace SourceGamma)
+        {
+            return FMaskToolsUtils::GetPlaneCacheKey(Texture, Channel, SizeX, SizeY, ResizeMethod, Format, Gamma, SourceGamma);
+        };
+
+    const FString BaseKey = GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear);
+    if (!TestFalse(TEXT("Key of a texture with a source is not empty"), BaseKey.IsEmpty()))
+    {
+        return false;
+    }
+
+    const TPair<const TCHAR*, FString> ChangedKeys[] =
+    {
+        { TEXT("Channel"), GetKey(EMaskChannel::Green, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("SizeX"), GetKey(EMaskChannel::Red, 32, 32, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("SizeY"), GetKey(EMaskChannel::Red, 64, 64, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("ResizeMethod"), GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Box, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("EdgeMode"), GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Flag_WrapX, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("Format"), GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U16, EGammaSpace::Linear, EGammaSpace::Linear) },
+        { TEXT("Gamma"), GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::sRGB, EGammaSpace::Linear) },
+        { TEXT("SourceGamma"), GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U8, EGammaSpace::Linear, EGammaSpace::sRGB) },
+    };
+
+    FMaskToolsDiskCache Cache(GetTestCacheDir(TEXT("Key")));
+    Cache.Clear();
+
+    FMaskPlane Plane;
+    MakeNoisePlane(64, 32, 2, Plane);
+    Cache.Store(BaseKey, Plane, FMaskPlaneStats());
+
+    FMaskPlane LoadedPlane;
+    TestTrue(TEXT("Unchanged inputs hit"), Cache.Load(GetKey(EMaskChannel::Red, 64, 32, EResizeMethod::Default, EMaskPlaneFormat::U8,
+        EGammaSpace::Linear, EGammaSpace::Linear), LoadedPlane));
+
+    for (const TPair<const TCHAR*, FString>& ChangedKey : ChangedKeys)
+    {
+        TestNotEqual(*FString::Printf(TEXT("Changing %s changes the key"), ChangedKey.Key), ChangedKey.Value, BaseKey);
+        TestFalse(*FString::Printf(TEXT("Changing %s misses"), ChangedKey.Key), Cache.Load(ChangedKey.Value, LoadedPlane));
+    }
+
+    Cache.Clear();
+    return true;
+}
+
+/*
+* Once stores take the cache over its cap, the least recently used entries are evicted to bring it back under.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsCacheEvictionTest, "MaskTools.Cache.Eviction", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsCacheEvictionTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsCacheTests;
+
+    const FString CacheDir = GetTestCacheDir(TEXT("Eviction"));
+    FMaskToolsDiskCache Cache(CacheDir);
+    Cache.Clear();
+
+    // Room for about four entries of 64x64 noise
+    constexpr int32 NumEntries = 16;
+    constexpr int64 MaxSizeBytes = 4 * 64 * 64 + 512;
+    Cache.Configure(true, MaxSizeBytes);
+
+    int32 NumLoaded = 0;
+    for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+    {
+        FMaskPlane Plane;
+        MakeNoisePlane(64, 64, EntryIndex, Plane);
+        Cache.Store(FMaskToolsDiskCache::MakeKey(TEXT("Source"), FString::Printf(TEXT("Eviction%d"), EntryIndex)), Plane, FMaskPlaneStats());
+
+        const int64 FolderSize = GetFolderSize(CacheDir);
+        TestTrue(*FString::Printf(TEXT("Cache of %lld bytes after store %d is under its cap of %lld"), FolderSize, EntryIndex, MaxSizeBytes),
+            FolderSize <= MaxSizeBytes);
+    }
+
+    for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+    {
+        FMaskPlane LoadedPlane;
+        NumLoaded += Cache.Load(FMaskToolsDiskCache::MakeKey(TEXT("Source"), FString::Printf(TEXT("Eviction%d"), EntryIndex)), LoadedPlane) ? 1 : 0;
+    }
+    TestTrue(*FString::Printf(TEXT("Some entries were evicted, %d of %d remain"), NumLoaded, NumEntries), NumLoaded > 0 && NumLoaded < NumEntries);
+
+    Cache.Clear();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsUtils.h"
+#include "MaskToolsImageFiles.h"
+#include "MaskToolsKernels.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaskToolsColorSpaceTests
+{
+    // 2x2 G8 image holding 0, 64, 128 and 255
+    FImage MakeGrayImage(EGammaSpace GammaSpace)
+    {
+        FImage Image(2, 2, ERawImageFormat::G8, GammaSpace);
+        const uint8 Values[] = { 0, 64, 128, 255 };
+        FMemory::Memcpy(Image.RawData.GetData(), Values, sizeof(Values));
+        return Image;
+    }
+}
+
+/*
+* A slot set to Linear or sRGB wins, From Texture follows the project setting which follows the texture.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsColorSpaceResolveTest, "MaskTools.ColorSpace.Resolve", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsColorSpaceResolveTest::RunTest(const FString& Parameters)
+{
+    using FHelpers = FMaskToolsPrivateHelpers;
+
+    TestEqual(TEXT("Linear slot over sRGB texture"), FHelpers::FindInputGammaSpace(EMaskColorSpace::Linear, EMaskColorSpace::FromTexture, EGammaSpace::sRGB), EGammaSpace::Linear);
+    TestEqual(TEXT("sRGB slot over linear project"), FHelpers::FindInputGammaSpace(EMaskColorSpace::SRGB, EMaskColorSpace::Linear, EGammaSpace::Linear), EGammaSpace::sRGB);
+    TestEqual(TEXT("Slot follows the project"), FHelpers::FindInputGammaSpace(EMaskColorSpace::FromTexture, EMaskColorSpace::Linear, EGammaSpace::sRGB), EGammaSpace::Linear);
+    TestEqual(TEXT("Slot and project follow the texture"), FHelpers::FindInputGammaSpace(EMaskColorSpace::FromTexture, EMaskColorSpace::FromTexture, EGammaSpace::sRGB), EGammaSpace::sRGB);
+
+    const FImage Gray = MaskToolsColorSpaceTests::MakeGrayImage(EGammaSpace::sRGB);
+    UTexture2D* SRGBTexture = FMaskToolsUtils::CreateTransientTexture(Gray, TC_Grayscale, TMGS_NoMipmaps);
+    TestEqual(TEXT("sRGB G8 texture"), FHelpers::FindTextureGammaSpace(SRGBTexture), EGammaSpace::sRGB);
+
+    const FImage LinearGray = MaskToolsColorSpaceTests::MakeGrayImage(EGammaSpace::Linear);
+    UTexture2D* LinearTexture = FMaskToolsUtils::CreateTransientTexture(LinearGray, TC_Grayscale, TMGS_NoMipmaps);
+    TestEqual(TEXT("Linear G8 texture"), FHelpers::FindTextureGammaSpace(LinearTexture), EGammaSpace::Linear);
+
+    FImage Gray16;
+    Gray.CopyTo(Gray16, ERawImageFormat::G16, EGammaSpace::Linear);
+    UTexture2D* Texture16 = FMaskToolsUtils::CreateTransientTexture(Gray16, TC_Grayscale, TMGS_NoMipmaps);
+    TestEqual(TEXT("16 bit texture"), FHelpers::FindTextureGammaSpace(Texture16), EGammaSpace::Linear);
+
+    return true;
+}
+
+/*
+* 8 bit image files are read as data, a PNG round trip keeps the values and comes back linear.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsColorSpaceImageFileTest, "MaskTools.ColorSpace.ImageFile", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsColorSpaceImageFileTest::RunTest(const FString& Parameters)
+{
+    const FImage Gray = MaskToolsColorSpaceTests::MakeGrayImage(EGammaSpace::Linear);
+    const FString FilePath = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("MaskToolsColorSpace"),
+        FMaskToolsImageFiles::GetExtension(EMaskImageFileFormat::PNG8));
+
+    if (!TestTrue(TEXT("Saved"), FMaskToolsImageFiles::SaveImage(Gray, FilePath, EMaskImageFileFormat::PNG8)))
+    {
+        return false;
+    }
+
+    FImage Loaded;
+    const bool bLoaded = FMaskToolsImageFiles::LoadImage(FilePath, Loaded);
+    IFileManager::Get().Delete(*FilePath);
+
+    if (!TestTrue(TEXT("Loaded"), bLoaded))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Gamma space"), Loaded.GammaSpace, EGammaSpace::Linear);
+
+    FMaskPlane Plane;
+    FMaskToolsKernels::ExtractPlane(Loaded, EMaskChannel::Red, EMaskPlaneFormat::U8, EGammaSpace::Linear, Plane);
+    const TArrayView64<const uint8> Values = Plane.AsU8();
+    const TArrayView64<const uint8> Expected = Gray.AsG8();
+    for (int64 Index = 0; Index < Expected.Num(); ++Index)
+    {
+        TestEqual(*FString::Printf(TEXT("Value %lld"), Index), Values[Index], Expected[Index]);
+    }
+
+    return true;
+}
+
+/*
+* Extraction decodes sRGB to linear and copies values untouched when both spaces match.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsColorSpaceExtractTest, "MaskTools.ColorSpace.Extract", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsColorSpaceExtractTest::RunTest(const FString& Parameters)
+{
+    const FImage SRGBGray = MaskToolsColorSpaceTests::MakeGrayImage(EGammaSpace::sRGB);
+
+    FMaskPlane Decoded;
+    FMaskToolsKernels::ExtractPlane(SRGBGray, EMaskChannel::Red, EMaskPlaneFormat::U8, EGammaSpace::Linear, Decoded);
+    TestEqual(TEXT("Black"), Decoded.AsU8()[0], static_cast<uint8>(0));
+    TestTrue(TEXT("sRGB 128 decodes to about 55"), FMath::Abs(static_cast<int32>(Decoded.AsU8()[2]) - 55) <= 1);
+    TestEqual(TEXT("White"), Decoded.AsU8()[3], static_cast<uint8>(255));
+
+    FMaskPlane Kept;
+    FMaskToolsKernels::ExtractPlane(SRGBGray, EMaskChannel::Red, EMaskPlaneFormat::U8, EGammaSpace::sRGB, Kept);
+    for (int64 Index = 0; Index < Kept.GetNumPixels(); ++Index)
+    {
+        TestEqual(*FString::Printf(TEXT("Untouched %lld"), Index), Kept.AsU8()[Index], SRGBGray.AsG8()[Index]);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,9 @@
 
 
 #include "MaskToolsConfig.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsMemory.h"
+#include "Misc/Paths.h"
 
 UMaskToolsConfig::UMaskToolsConfig()
 {
@@ -12,4 +15,71 @@ UMaskToolsConfig::UMaskToolsConfig()
 	DefaultMaskSavePath.Path = TEXT("GeneratedMasks");
 	DefaultMaskResolution = EMaskResolutions::FiveHundredTwelve;
 	bDiscardEmptyChannels = true;
+	SplitterEdgeMode = EMaskEdgeMode::Clamp;
+	bSkipDuplicateChannels = true;
+	bRedirectDuplicateChannels = false;
+	bSaveMaskRecipes = true;
+	bUpdateOutputsInPlace = true;
+	bChooseCompressionFromChannels = false;
+	MaskPrecision = EMaskPrecision::EightBit;
+	bGenerateMipsPerChannel = false;
+	RedMipFilter = EMaskMipFilter::Average;
+	GreenMipFilter = EMaskMipFilter::Average;
+	BlueMipFilter = EMaskMipFilter::Average;
+	AlphaMipFilter = EMaskMipFilter::Average;
+	MipCoverageThreshold = 0.5f;
+	InputColorSpace = EMaskColorSpace::FromTexture;
+	SplitColorSpace = EMaskColorSpace::FromTexture;
+	bAutoRebuildOnReimport = true;
+	AutoRebuildDelay = 2.f;
+	MemoryBudgetMB = 0;
+	MaxTexturesInFlight = 4;
+	bUseWorkerProcesses = false;
+	NumWorkerProcesses = 2;
+	WorkerTaskTimeoutSeconds = 300;
+	PerfTimeRegressionThreshold = 10.f;
+	PerfMemoryRegressionThreshold = 10.f;
+	ExportTarget = EMaskExportTarget::Asset;
+	ImageFileFormat = EMaskFileFormat::PNG8;
+	bEnableDiskCache = true;
+	DiskCacheMaxSizeMB = 2048;
 }
+
+FString UMaskToolsConfig::GetImageFileDirectory() const
+{
+	if (ImageFileDirectory.Path.IsEmpty())
+	{
+		return FPaths::ProjectSavedDir() / TEXT("MaskTools") / TEXT("Export");
+	}
+
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ImageFileDirectory.Path);
+}
+
+int64 UMaskToolsConfig::GetMemoryBudget() const
+{
+	if (MemoryBudgetMB <= 0)
+	{
+		return FMaskToolsMemory::GetDefaultBudget();
+	}
+
+	return static_cast<int64>(MemoryBudgetMB) * 1024 * 1024;
+}
+
+void UMaskToolsConfig::ApplyDiskCacheSettings() const
+{
+	FMaskToolsDiskCache::Get().Configure(bEnableDiskCache, static_cast<int64>(DiskCacheMaxSizeMB) * 1024 * 1024);
+}
+
+#if WITH_EDITOR
+void UMaskToolsConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UMaskToolsConfig, bEnableDiskCache)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UMaskToolsConfig, DiskCacheMaxSizeMB))
+	{
+		ApplyDiskCacheSettings();
+	}
+}
+#endif
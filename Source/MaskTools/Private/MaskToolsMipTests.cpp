@@ -0,0 +1,212 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsKernels.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaskToolsMipTests
+{
+    // 4x4 black plane with a single white texel, the thin feature mips tend to erode
+    void MakeSpeckPlane(EMaskPlaneFormat Format, FMaskPlane& OutPlane)
+    {
+        OutPlane.Init(4, 4, Format);
+        FMemory::Memzero(OutPlane.RawData.GetData(), OutPlane.RawData.Num());
+
+        switch (Format)
+        {
+        case EMaskPlaneFormat::U16:
+            OutPlane.AsU16()[5] = 65535;
+            break;
+        case EMaskPlaneFormat::F32:
+            OutPlane.AsF32()[5] = 1.f;
+            break;
+        case EMaskPlaneFormat::U8:
+        default:
+            OutPlane.AsU8()[5] = 255;
+            break;
+        }
+    }
+
+    // Share of the values of a float plane at or over Threshold
+    double GetCoverage(const FMaskPlane& Plane, float Threshold)
+    {
+        int64 Covered = 0;
+        for (const float Value : Plane.AsF32())
+        {
+            Covered += Value >= Threshold ? 1 : 0;
+        }
+        return static_cast<double>(Covered) / Plane.GetNumPixels();
+    }
+}
+
+/*
+* Mip sizes follow the engine, halving down to 1x1 with odd sides dropping their last row or column.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsMipSizesTest, "MaskTools.Mips.Sizes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsMipSizesTest::RunTest(const FString& Parameters)
+{
+    const FIntPoint TopSizes[] = { FIntPoint(8, 4), FIntPoint(5, 5), FIntPoint(1, 16) };
+    const TArray<FIntPoint> ExpectedSizes[] =
+    {
+        { FIntPoint(4, 2), FIntPoint(2, 1), FIntPoint(1, 1) },
+        { FIntPoint(2, 2), FIntPoint(1, 1) },
+        { FIntPoint(1, 8), FIntPoint(1, 4), FIntPoint(1, 2), FIntPoint(1, 1) }
+    };
+
+    for (int32 SizeIndex = 0; SizeIndex < UE_ARRAY_COUNT(TopSizes); ++SizeIndex)
+    {
+        FMaskPlane Plane(TopSizes[SizeIndex].X, TopSizes[SizeIndex].Y, EMaskPlaneFormat::U8);
+        FMemory::Memzero(Plane.RawData.GetData(), Plane.RawData.Num());
+
+        TArray<FMaskPlane> Mips;
+        FMaskToolsKernels::BuildMipChain(Plane, EMaskMipReduction::Average, 0.5f, Mips);
+
+        const TArray<FIntPoint>& Expected = ExpectedSizes[SizeIndex];
+        if (!TestEqual(*FString::Printf(TEXT("Mip count of %dx%d"), Plane.SizeX, Plane.SizeY), Mips.Num(), Expected.Num()))
+        {
+            continue;
+        }
+
+        for (int32 MipIndex = 0; MipIndex < Mips.Num(); ++MipIndex)
+        {
+            TestEqual(*FString::Printf(TEXT("Mip %d of %dx%d"), MipIndex + 1, Plane.SizeX, Plane.SizeY),
+                FIntPoint(Mips[MipIndex].SizeX, Mips[MipIndex].SizeY), Expected[MipIndex]);
+        }
+    }
+
+    return true;
+}
+
+/*
+* Average blurs a single texel away, Max keeps it down to 1x1 and Min drops it at the first mip, in every format.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsMipReductionsTest, "MaskTools.Mips.Reductions", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsMipReductionsTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsMipTests;
+
+    const EMaskPlaneFormat Formats[] = { EMaskPlaneFormat::U8, EMaskPlaneFormat::U16, EMaskPlaneFormat::F32 };
+    for (const EMaskPlaneFormat Format : Formats)
+    {
+        FMaskPlane Plane;
+        MakeSpeckPlane(Format, Plane);
+
+        // Compared as floats so every format shares the expectations
+        auto GetLastValue = [&Plane](EMaskMipReduction Reduction, int32 MipIndex)
+        {
+            TArray<FMaskPlane> Mips;
+            FMaskToolsKernels::BuildMipChain(Plane, Reduction, 0.5f, Mips);
+
+            FMaskPlane FloatMip;
+            FMaskToolsKernels::ConvertPlane(Mips[MipIndex], EMaskPlaneFormat::F32, FloatMip);
+            return FMath::Max(FloatMip.AsF32()[0], FloatMip.AsF32()[FloatMip.GetNumPixels() - 1]);
+        };
+
+        const FString FormatName = FString::FromInt(static_cast<int32>(Format));
+        TestTrue(TEXT("Average 2x2 is a quarter ") + FormatName, FMath::IsNearlyEqual(GetLastValue(EMaskMipReduction::Average, 0), 0.25f, 0.01f));
+        TestTrue(TEXT("Average 1x1 is a sixteenth ") + FormatName, FMath::IsNearlyEqual(GetLastValue(EMaskMipReduction::Average, 1), 0.0625f, 0.01f));
+        TestTrue(TEXT("Max keeps the texel ") + FormatName, FMath::IsNearlyEqual(GetLastValue(EMaskMipReduction::Max, 1), 1.f, 0.001f));
+        TestTrue(TEXT("Min drops the texel ") + FormatName, FMath::IsNearlyEqual(GetLastValue(EMaskMipReduction::Min, 0), 0.f, 0.001f));
+    }
+
+    return true;
+}
+
+/*
+* Coverage keeps the share of texels over the threshold closer to the top mip than Average does,
+* and leaves the values of a constant plane as they are.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsMipCoverageTest, "MaskTools.Mips.Coverage", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsMipCoverageTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsMipTests;
+
+    constexpr float Threshold = 0.5f;
+
+    // Alpha tested foliage, a horizontal ramp with every other texel cut out
+    FMaskPlane Plane(16, 16, EMaskPlaneFormat::F32);
+    for (int32 Y = 0; Y < 16; ++Y)
+    {
+        for (int32 X = 0; X < 16; ++X)
+        {
+            Plane.AsF32()[Y * 16 + X] = (X + Y) % 2 == 0 ? 0.7f * X / 15.f : 0.f;
+        }
+    }
+    const double TopCoverage = GetCoverage(Plane, Threshold);
+
+    TArray<FMaskPlane> AverageMips;
+    FMaskToolsKernels::BuildMipChain(Plane, EMaskMipReduction::Average, Threshold, AverageMips);
+
+    TArray<FMaskPlane> CoverageMips;
+    FMaskToolsKernels::BuildMipChain(Plane, EMaskMipReduction::Coverage, Threshold, CoverageMips);
+
+    const double AverageError = FMath::Abs(GetCoverage(AverageMips[0], Threshold) - TopCoverage);
+    const double CoverageError = FMath::Abs(GetCoverage(CoverageMips[0], Threshold) - TopCoverage);
+    TestTrue(FString::Printf(TEXT("Coverage error %f is below the average one %f"), CoverageError, AverageError), CoverageError < AverageError);
+
+    // Fully covered and fully uncovered constant planes keep their value down the chain
+    const float ConstantValues[] = { 0.3f, 0.5f, 0.8f };
+    for (const float ConstantValue : ConstantValues)
+    {
+        FMaskPlane ConstantPlane(16, 16, EMaskPlaneFormat::F32);
+        for (float& Value : ConstantPlane.AsF32())
+        {
+            Value = ConstantValue;
+        }
+
+        TArray<FMaskPlane> ConstantMips;
+        FMaskToolsKernels::BuildMipChain(ConstantPlane, EMaskMipReduction::Coverage, Threshold, ConstantMips);
+        for (int32 MipIndex = 0; MipIndex < ConstantMips.Num(); ++MipIndex)
+        {
+            for (const float Value : ConstantMips[MipIndex].AsF32())
+            {
+                if (!TestTrue(*FString::Printf(TEXT("Mip %d of a constant %f plane is unchanged, got %f"), MipIndex + 1, ConstantValue, Value),
+                    FMath::IsNearlyEqual(Value, ConstantValue, 1e-6f)))
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+* Packed mips reduce each channel with its own reduction, in RGBA order.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsMipImagesTest, "MaskTools.Mips.PerChannel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsMipImagesTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsMipTests;
+
+    FMaskPlane Plane;
+    MakeSpeckPlane(EMaskPlaneFormat::U8, Plane);
+
+    const FMaskPlane* Planes[4] = { &Plane, &Plane, &Plane, &Plane };
+    const EMaskMipReduction Reductions[4] = { EMaskMipReduction::Max, EMaskMipReduction::Min, EMaskMipReduction::Average, EMaskMipReduction::Max };
+
+    TArray<FImage> Mips;
+    if (!TestTrue(TEXT("Built"), FMaskToolsKernels::BuildMipImages(Planes, Reductions, 0.5f, Mips)) || !TestEqual(TEXT("Mip count"), Mips.Num(), 2))
+    {
+        return false;
+    }
+
+    FImage LastMip;
+    Mips.Last().CopyTo(LastMip, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+    const FColor Color = LastMip.AsBGRA8()[0];
+    TestEqual(TEXT("Red is Max"), Color.R, static_cast<uint8>(255));
+    TestEqual(TEXT("Green is Min"), Color.G, static_cast<uint8>(0));
+    TestEqual(TEXT("Blue is Average"), Color.B, static_cast<uint8>(16));
+    TestEqual(TEXT("Alpha is Max"), Color.A, static_cast<uint8>(255));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,118 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsBenchmark.h"
+
+#include "MaskToolsConfig.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Throughput of the pixel kernels for every resolution and source format.
+* Run with -ExecCmds="Automation RunTests MaskTools.Perf" -nullrhi
+* -MaskToolsPerfMaxResolution=N skips the resolutions above N.
+* -MaskToolsPerfOutput=Folder overrides the CSV folder, Saved/MaskTools/Benchmarks by default.
+* -MaskToolsPerfBaseline=File compares against another baseline than the checked in one.
+* -MaskToolsPerfThreshold=Percent overrides the time threshold of the project settings.
+* -MaskToolsPerfUpdateBaseline records the results into the baseline instead of comparing.
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMaskToolsPerfTest, "MaskTools.Perf", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+void FMaskToolsPerfTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    const EMaskToolsBenchmarkOperation Operations[] =
+    {
+        EMaskToolsBenchmarkOperation::Pack,
+        EMaskToolsBenchmarkOperation::Split,
+        EMaskToolsBenchmarkOperation::Resize,
+        EMaskToolsBenchmarkOperation::Stats
+    };
+
+    for (const EMaskToolsBenchmarkOperation Operation : Operations)
+    {
+        OutBeautifiedNames.Add(FMaskToolsBenchmark::GetOperationName(Operation));
+        OutTestCommands.Add(FString::FromInt(static_cast<int32>(Operation)));
+    }
+}
+
+bool FMaskToolsPerfTest::RunTest(const FString& Parameters)
+{
+    const EMaskToolsBenchmarkOperation Operation = static_cast<EMaskToolsBenchmarkOperation>(FCString::Atoi(*Parameters));
+
+    int32 MaxResolution = 8192;
+    FParse::Value(FCommandLine::Get(), TEXT("MaskToolsPerfMaxResolution="), MaxResolution);
+
+    FString OutputDir = FMaskToolsBenchmark::GetDefaultOutputDir();
+    FParse::Value(FCommandLine::Get(), TEXT("MaskToolsPerfOutput="), OutputDir);
+
+    TArray<FMaskToolsBenchmarkResult> Results;
+    FMaskToolsBenchmark::Run(Operation, MaxResolution, Results);
+
+    if (!TestTrue(TEXT("Benchmark produced results"), Results.Num() > 0))
+    {
+        return false;
+    }
+
+    for (const FMaskToolsBenchmarkResult& Result : Results)
+    {
+        AddInfo(FString::Printf(TEXT("%s: %.3f ms, %.1f MPix/s, %.1f MB peak"),
+            *Result.GetKey(), Result.Milliseconds, Result.MegaPixelsPerSecond, Result.PeakMemoryBytes / (1024.0 * 1024.0)));
+    }
+
+    const FString FilePath = OutputDir / FString::Printf(TEXT("MaskToolsPerf_%s_%s.csv"),
+        *FMaskToolsBenchmark::GetOperationName(Operation), *FDateTime::Now().ToString());
+
+    if (!TestTrue(TEXT("Benchmark CSV written"), FMaskToolsBenchmark::WriteCsv(Results, FilePath)))
+    {
+        return false;
+    }
+
+    AddInfo(FString::Printf(TEXT("Results written to %s"), *FPaths::ConvertRelativePathToFull(FilePath)));
+
+    FString BaselinePath = FMaskToolsBenchmark::GetDefaultBaselinePath();
+    FParse::Value(FCommandLine::Get(), TEXT("MaskToolsPerfBaseline="), BaselinePath);
+
+    TArray<FMaskToolsBenchmarkResult> Baseline;
+    const bool bHasBaseline = FMaskToolsBenchmark::ReadCsv(BaselinePath, Baseline);
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("MaskToolsPerfUpdateBaseline")))
+    {
+        FMaskToolsBenchmark::MergeIntoBaseline(Results, Baseline);
+        TestTrue(TEXT("Baseline written"), FMaskToolsBenchmark::WriteCsv(Baseline, BaselinePath));
+        AddInfo(FString::Printf(TEXT("Baseline updated at %s"), *FPaths::ConvertRelativePathToFull(BaselinePath)));
+        return true;
+    }
+
+    // Timings only mean something on the machine that recorded them, without a baseline there is nothing to gate on
+    if (!bHasBaseline || Baseline.Num() == 0)
+    {
+        AddWarning(FString::Printf(TEXT("No baseline entries in %s, comparison skipped. Record them with -MaskToolsPerfUpdateBaseline"), *BaselinePath));
+        return true;
+    }
+
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+
+    float TimeThreshold = Config->PerfTimeRegressionThreshold;
+    FParse::Value(FCommandLine::Get(), TEXT("MaskToolsPerfThreshold="), TimeThreshold);
+
+    TArray<FString> MissingKeys;
+    for (const FString& Regression : FMaskToolsBenchmark::Compare(Results, Baseline, TimeThreshold, Config->PerfMemoryRegressionThreshold, &MissingKeys))
+    {
+        AddError(Regression);
+    }
+
+    if (MissingKeys.Num() > 0)
+    {
+        AddWarning(FString::Printf(TEXT("%d results have no baseline entry and were not compared, e.g. %s. Record them with -MaskToolsPerfUpdateBaseline"),
+            MissingKeys.Num(), *MissingKeys[0]));
+    }
+
+    return !HasAnyErrors();
+}
+
+#endif
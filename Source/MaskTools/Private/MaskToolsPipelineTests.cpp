@@ -0,0 +1,339 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsMemory.h"
+#include "MaskToolsPipeline.h"
+#include "MaskToolsProgress.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaskToolsPipelineTests
+{
+    struct FTestJob : public FMaskToolsPipelineJob
+    {
+        int32 Index = 0;
+        // Names of the stages the job went through, in order
+        TArray<FString> Stages;
+    };
+
+    // Jobs in flight and the most seen at once, updated from every thread
+    struct FInFlightCounter
+    {
+        std::atomic<int32> Current { 0 };
+        std::atomic<int32> Peak { 0 };
+
+        void Enter()
+        {
+            const int32 Value = ++Current;
+            int32 Previous = Peak.load();
+            while (Value > Previous && !Peak.compare_exchange_weak(Previous, Value))
+            {
+            }
+        }
+
+        void Leave()
+        {
+            --Current;
+        }
+    };
+
+    TUniquePtr<FTestJob> MakeJob(int32 Index)
+    {
+        TUniquePtr<FTestJob> Job = MakeUnique<FTestJob>();
+        Job->Index = Index;
+        return Job;
+    }
+}
+
+/*
+* Every job goes through every stage in the order they were added, and with a single job in flight
+* jobs also leave in the order they were added.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineOrderTest, "MaskTools.Pipeline.Order", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineOrderTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsPipelineTests;
+
+    constexpr int32 NumJobs = 8;
+    TSharedRef<TArray<int32>> Finished = MakeShared<TArray<int32>>();
+    TSharedRef<TArray<TArray<FString>>> FinishedStages = MakeShared<TArray<TArray<FString>>>();
+
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Test Order"), 1);
+    Pipeline->AddStage(TEXT("Load"), EMaskPipelineThread::GameThread, [](FMaskToolsPipelineJob& Job)
+        {
+            static_cast<FTestJob&>(Job).Stages.Add(TEXT("Load"));
+            return true;
+        });
+    Pipeline->AddStage(TEXT("Compute"), EMaskPipelineThread::Worker, [](FMaskToolsPipelineJob& Job)
+        {
+            static_cast<FTestJob&>(Job).Stages.Add(TEXT("Compute"));
+            return true;
+        });
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [Finished, FinishedStages](FMaskToolsPipelineJob& PipelineJob)
+        {
+            FTestJob& Job = static_cast<FTestJob&>(PipelineJob);
+            Job.Stages.Add(TEXT("Write"));
+            Finished->Add(Job.Index);
+            FinishedStages->Add(Job.Stages);
+            return true;
+        });
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Pipeline->AddJob(MakeJob(Index));
+    }
+    Pipeline->Wait();
+
+    TestEqual(TEXT("Completed"), Pipeline->GetNumCompleted(), NumJobs);
+    if (!TestEqual(TEXT("Finished"), Finished->Num(), NumJobs))
+    {
+        return false;
+    }
+
+    const TArray<FString> ExpectedStages = { TEXT("Load"), TEXT("Compute"), TEXT("Write") };
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        TestEqual(*FString::Printf(TEXT("Job %d left in order"), Index), (*Finished)[Index], Index);
+        TestTrue(*FString::Printf(TEXT("Job %d went through every stage in order"), Index), (*FinishedStages)[Index] == ExpectedStages);
+    }
+
+    return true;
+}
+
+/*
+* A stage returning false drops its job, later stages never see it and the progress still counts it.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineDropTest, "MaskTools.Pipeline.Drop", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineDropTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsPipelineTests;
+
+    constexpr int32 NumJobs = 10;
+    TSharedRef<std::atomic<int32>> Written = MakeShared<std::atomic<int32>>(0);
+    TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe> Progress = MakeShared<FMaskToolsProgress, ESPMode::ThreadSafe>();
+
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Test Drop"));
+    Pipeline->SetProgress(Progress);
+
+    // Odd jobs are dropped
+    Pipeline->AddStage(TEXT("Compute"), EMaskPipelineThread::Worker, [](FMaskToolsPipelineJob& Job)
+        {
+            return static_cast<FTestJob&>(Job).Index % 2 == 0;
+        });
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [Written, this](FMaskToolsPipelineJob& Job)
+        {
+            TestTrue(TEXT("Only kept jobs are written"), static_cast<FTestJob&>(Job).Index % 2 == 0);
+            ++*Written;
+            return true;
+        });
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Pipeline->AddJob(MakeJob(Index));
+    }
+    Pipeline->Wait();
+
+    TestEqual(TEXT("Completed"), Pipeline->GetNumCompleted(), NumJobs / 2);
+    TestEqual(TEXT("Dropped"), Pipeline->GetNumDropped(), NumJobs / 2);
+    TestEqual(TEXT("Written"), Written->load(), NumJobs / 2);
+    TestEqual(TEXT("Progress counts dropped jobs"), Progress->GetCompletedWork(), static_cast<int64>(NumJobs));
+
+    return true;
+}
+
+/*
+* No more than MaxInFlight jobs are admitted at once, and a slow last stage holds the earlier ones back
+* instead of letting its queue grow past its capacity.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineBackpressureTest, "MaskTools.Pipeline.Backpressure", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineBackpressureTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsPipelineTests;
+
+    constexpr int32 NumJobs = 24;
+    constexpr int32 MaxInFlight = 3;
+    constexpr int32 WriteCapacity = 1;
+
+    TSharedRef<FInFlightCounter> InFlight = MakeShared<FInFlightCounter>();
+    TSharedRef<FInFlightCounter> Computed = MakeShared<FInFlightCounter>();
+
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Test Backpressure"), MaxInFlight);
+    Pipeline->AddStage(TEXT("Load"), EMaskPipelineThread::GameThread, [InFlight](FMaskToolsPipelineJob& Job)
+        {
+            InFlight->Enter();
+            return true;
+        });
+
+    // Computed but not written yet, bounded by the write queue and the job being written
+    Pipeline->AddStage(TEXT("Compute"), EMaskPipelineThread::Worker, [Computed](FMaskToolsPipelineJob& Job)
+        {
+            FPlatformProcess::Sleep(0.001f);
+            Computed->Enter();
+            return true;
+        });
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [InFlight, Computed](FMaskToolsPipelineJob& Job)
+        {
+            FPlatformProcess::Sleep(0.002f);
+            Computed->Leave();
+            InFlight->Leave();
+            return true;
+        }, WriteCapacity);
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Pipeline->AddJob(MakeJob(Index));
+    }
+    Pipeline->Wait();
+
+    TestEqual(TEXT("Completed"), Pipeline->GetNumCompleted(), NumJobs);
+    TestTrue(*FString::Printf(TEXT("Peak in flight %d is within %d"), InFlight->Peak.load(), MaxInFlight), InFlight->Peak.load() <= MaxInFlight);
+    TestTrue(*FString::Printf(TEXT("Peak waiting for the write %d is within its capacity"), Computed->Peak.load()), Computed->Peak.load() <= WriteCapacity + 1);
+
+    return true;
+}
+
+/*
+* With a memory budget jobs are admitted in the order they were added, a large one waits for memory instead of
+* letting smaller ones pass it, and a job over the whole budget runs alone.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineMemoryBudgetTest, "MaskTools.Pipeline.MemoryBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineMemoryBudgetTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsPipelineTests;
+
+    constexpr int64 MemoryBudget = 100;
+    constexpr int32 OverBudgetIndex = 3;
+    const int64 MemoryCosts[] = { 40, 40, 60, 250, 10, 10, 90, 10 };
+    constexpr int32 NumJobs = UE_ARRAY_COUNT(MemoryCosts);
+
+    TSharedRef<TArray<int32>> Admitted = MakeShared<TArray<int32>>();
+    TSharedRef<FInFlightCounter> InFlight = MakeShared<FInFlightCounter>();
+    TSharedRef<std::atomic<bool>> bOverBudgetInFlight = MakeShared<std::atomic<bool>>(false);
+
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Test Memory Budget"), NumJobs);
+    Pipeline->SetMemoryBudget(MemoryBudget);
+    Pipeline->AddStage(TEXT("Load"), EMaskPipelineThread::GameThread, [Admitted, InFlight, bOverBudgetInFlight, this](FMaskToolsPipelineJob& PipelineJob)
+        {
+            const FTestJob& Job = static_cast<FTestJob&>(PipelineJob);
+            Admitted->Add(Job.Index);
+            InFlight->Enter();
+
+            if (Job.Index == OverBudgetIndex)
+            {
+                TestEqual(TEXT("Jobs in flight with the one over budget"), InFlight->Current.load(), 1);
+                *bOverBudgetInFlight = true;
+            }
+            else
+            {
+                TestFalse(*FString::Printf(TEXT("Job %d admitted next to the one over budget"), Job.Index), bOverBudgetInFlight->load());
+            }
+            return true;
+        });
+    Pipeline->AddStage(TEXT("Compute"), EMaskPipelineThread::Worker, [](FMaskToolsPipelineJob& Job)
+        {
+            FPlatformProcess::Sleep(0.001f);
+            return true;
+        });
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [InFlight, bOverBudgetInFlight](FMaskToolsPipelineJob& Job)
+        {
+            if (static_cast<FTestJob&>(Job).Index == OverBudgetIndex)
+            {
+                *bOverBudgetInFlight = false;
+            }
+            InFlight->Leave();
+            return true;
+        });
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Pipeline->AddJob(MakeJob(Index), MemoryCosts[Index]);
+    }
+    Pipeline->Wait();
+
+    TestEqual(TEXT("Completed"), Pipeline->GetNumCompleted(), NumJobs);
+    if (!TestEqual(TEXT("Admitted"), Admitted->Num(), NumJobs))
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        TestEqual(*FString::Printf(TEXT("Job %d admitted in order"), Index), (*Admitted)[Index], Index);
+    }
+
+    return true;
+}
+
+/*
+* Mips and additional resolutions are part of the memory a split is expected to hold.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineSplitMemoryTest, "MaskTools.Pipeline.SplitMemory", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineSplitMemoryTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Size = 1024;
+    constexpr int64 NumPixels = static_cast<int64>(Size) * Size;
+    constexpr int64 PlanesBytes = NumPixels * 4;
+    const TArray<FIntPoint> ResizedSizes = { FIntPoint(512, 512), FIntPoint(256, 256) };
+    const int64 ResizedBytes = (512 * 512 + 256 * 256) * 4;
+
+    const int64 Planes = FMaskToolsMemory::EstimateSplitMemory(Size, Size, 8, EMaskPlaneFormat::U8);
+    TestEqual(TEXT("Source, interleaved copy and planes"), Planes, NumPixels * 8 + PlanesBytes * 2);
+
+    const int64 WithMips = FMaskToolsMemory::EstimateSplitMemory(Size, Size, 8, EMaskPlaneFormat::U8, true);
+    TestEqual(TEXT("Mips add a third of the planes"), WithMips, Planes + PlanesBytes / 3);
+
+    const int64 WithResized = FMaskToolsMemory::EstimateSplitMemory(Size, Size, 8, EMaskPlaneFormat::U8, false, ResizedSizes);
+    TestEqual(TEXT("Every additional resolution adds its channels"), WithResized, Planes + ResizedBytes);
+
+    const int64 WithBoth = FMaskToolsMemory::EstimateSplitMemory(Size, Size, 8, EMaskPlaneFormat::U8, true, ResizedSizes);
+    TestEqual(TEXT("Additional resolutions have mips too"), WithBoth, Planes + ResizedBytes + (PlanesBytes + ResizedBytes) / 3);
+
+    return true;
+}
+
+/*
+* Once the progress is cancelled jobs not admitted yet are dropped without running, the ones in flight finish.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsPipelineCancelTest, "MaskTools.Pipeline.Cancel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsPipelineCancelTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsPipelineTests;
+
+    constexpr int32 NumJobs = 20;
+    TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe> Progress = MakeShared<FMaskToolsProgress, ESPMode::ThreadSafe>();
+
+    TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FMaskToolsPipeline, ESPMode::ThreadSafe>(TEXT("Test Cancel"), 2);
+    Pipeline->SetProgress(Progress);
+    Pipeline->AddStage(TEXT("Write"), EMaskPipelineThread::GameThread, [Progress](FMaskToolsPipelineJob& Job)
+        {
+            if (static_cast<FTestJob&>(Job).Index == 1)
+            {
+                Progress->Cancel();
+            }
+            return true;
+        });
+
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Pipeline->AddJob(MakeJob(Index));
+    }
+    Pipeline->Wait();
+
+    TestTrue(TEXT("Some jobs were cancelled"), Pipeline->GetNumCancelled() > 0);
+    TestEqual(TEXT("Every job is accounted for"), Pipeline->GetNumCompleted() + Pipeline->GetNumDropped() + Pipeline->GetNumCancelled(), NumJobs);
+    TestEqual(TEXT("Progress is complete"), Progress->GetCompletedWork(), Progress->GetTotalWork());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsProgressNotification.h"
+
+#include "Framework/Notifications/NotificationManager.h"
+#include "MaskToolsProgress.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "FMaskToolsProgressNotification"
+
+namespace MaskToolsProgressNotification
+{
+    // Refreshing the text more often only costs slate invalidations
+    constexpr float RefreshSeconds = 0.1f;
+}
+
+TSharedRef<FMaskToolsProgressNotification> FMaskToolsProgressNotification::Open(const FText& InTitle, const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& InProgress)
+{
+    check(IsInGameThread());
+
+    TSharedRef<FMaskToolsProgressNotification> Notification = MakeShareable(new FMaskToolsProgressNotification(InTitle, InProgress));
+
+    FNotificationInfo Info(Notification->GetProgressText());
+    Info.bFireAndForget = false;
+    Info.bUseThrobber = true;
+    Info.ExpireDuration = 3.f;
+    Info.ButtonDetails.Add(FNotificationButtonInfo(
+        LOCTEXT("Cancel", "Cancel"),
+        LOCTEXT("CancelTooltip", "Stops once the textures already started are done"),
+        FSimpleDelegate::CreateSP(Notification, &FMaskToolsProgressNotification::OnCancelClicked),
+        SNotificationItem::CS_Pending));
+
+    if (TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info))
+    {
+        Item->SetCompletionState(SNotificationItem::CS_Pending);
+        Notification->Item = Item;
+    }
+
+    Notification->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(Notification, &FMaskToolsProgressNotification::Tick), MaskToolsProgressNotification::RefreshSeconds);
+    return Notification;
+}
+
+FMaskToolsProgressNotification::FMaskToolsProgressNotification(const FText& InTitle, const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& InProgress)
+    : Title(InTitle)
+    , Progress(InProgress)
+{
+}
+
+FMaskToolsProgressNotification::~FMaskToolsProgressNotification()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+void FMaskToolsProgressNotification::Close(int32 NumFailed)
+{
+    check(IsInGameThread());
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    if (TSharedPtr<SNotificationItem> PinnedItem = Item.Pin())
+    {
+        if (Progress->IsCancelled())
+        {
+            PinnedItem->SetText(FText::Format(LOCTEXT("Cancelled", "{0} cancelled"), Title));
+            PinnedItem->SetCompletionState(SNotificationItem::CS_None);
+        }
+        else if (NumFailed > 0)
+        {
+            PinnedItem->SetText(FText::Format(LOCTEXT("FinishedWithFailures", "{0} done, {1} failed, see the log"), Title, FText::AsNumber(NumFailed)));
+            PinnedItem->SetCompletionState(SNotificationItem::CS_Fail);
+        }
+        else
+        {
+            PinnedItem->SetText(FText::Format(LOCTEXT("Finished", "{0} done"), Title));
+            PinnedItem->SetCompletionState(SNotificationItem::CS_Success);
+        }
+        PinnedItem->ExpireAndFadeout();
+    }
+    Item.Reset();
+}
+
+bool FMaskToolsProgressNotification::Tick(float DeltaTime)
+{
+    if (TSharedPtr<SNotificationItem> PinnedItem = Item.Pin())
+    {
+        PinnedItem->SetText(GetProgressText());
+    }
+    return true;
+}
+
+void FMaskToolsProgressNotification::OnCancelClicked()
+{
+    if (Progress->IsCancelled()) return;
+    Progress->Cancel();
+
+    // The button only shows while pending, leaving that state hides it until Close sets the final one
+    if (TSharedPtr<SNotificationItem> PinnedItem = Item.Pin())
+    {
+        PinnedItem->SetText(GetProgressText());
+        PinnedItem->SetCompletionState(SNotificationItem::CS_None);
+    }
+}
+
+FText FMaskToolsProgressNotification::GetProgressText() const
+{
+    const FText Count = FText::Format(LOCTEXT("Count", "{0} / {1}"), FText::AsNumber(Progress->GetCompletedWork()), FText::AsNumber(Progress->GetTotalWork()));
+    if (Progress->IsCancelled())
+    {
+        return FText::Format(LOCTEXT("Cancelling", "{0} {1}, cancelling..."), Title, Count);
+    }
+
+    const FString Status = Progress->GetStatus();
+    if (Status.IsEmpty())
+    {
+        return FText::Format(LOCTEXT("Progress", "{0} {1}"), Title, Count);
+    }
+    return FText::Format(LOCTEXT("ProgressWithStatus", "{0} {1}\n{2}"), Title, Count, FText::FromString(Status));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,142 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsKernels.h"
+#include "MaskToolsResampler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaskToolsResamplerTests
+{
+    using EFilter = FImageCore::EResizeImageFilter;
+
+    // Filters leave some room to the way each resampler sums its taps, a few 8 bit steps
+    constexpr float Tolerance = 0.02f;
+
+    // Ramps in both directions, so wrapping pulls the far edge in, with a smooth wave on top
+    void MakePlane(int32 SizeX, int32 SizeY, FMaskPlane& OutPlane)
+    {
+        OutPlane.Init(SizeX, SizeY, EMaskPlaneFormat::F32);
+        const TArrayView64<float> Values = OutPlane.AsF32();
+        for (int32 Y = 0; Y < SizeY; ++Y)
+        {
+            for (int32 X = 0; X < SizeX; ++X)
+            {
+                const float Ramp = 0.4f * X / SizeX + 0.4f * Y / SizeY;
+                Values[static_cast<int64>(Y) * SizeX + X] = Ramp + 0.1f * FMath::Sin(X * 0.35f) * FMath::Cos(Y * 0.25f) + 0.1f;
+            }
+        }
+    }
+
+    float GetMaxDifference(const FMaskPlane& Plane, const FImage& Image)
+    {
+        const TArrayView64<const float> Values = Plane.AsF32();
+        const TArrayView64<const float> Expected = Image.AsR32F();
+
+        float MaxDifference = 0.f;
+        for (int64 Index = 0; Index < Values.Num(); ++Index)
+        {
+            MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Values[Index] - Expected[Index]));
+        }
+        return MaxDifference;
+    }
+}
+
+/*
+* The plane resampler matches FImageCore::ResizeImage for every filter and edge mode, down and up.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsResamplerMatchTest, "MaskTools.Resampler.MatchesImageCore", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsResamplerMatchTest::RunTest(const FString& Parameters)
+{
+    using namespace MaskToolsResamplerTests;
+
+    const EFilter Filters[] =
+    {
+        EFilter::PointSample,
+        EFilter::Box,
+        EFilter::Triangle,
+        EFilter::CubicGaussian,
+        EFilter::CubicSharp,
+        EFilter::CubicMitchell,
+        EFilter::AdaptiveSharp,
+        EFilter::AdaptiveSmooth
+    };
+
+    const uint32 EdgeFlags[] =
+    {
+        0,
+        static_cast<uint32>(EFilter::Flag_WrapX),
+        static_cast<uint32>(EFilter::Flag_WrapY),
+        static_cast<uint32>(EFilter::Flag_WrapX) | static_cast<uint32>(EFilter::Flag_WrapY)
+    };
+
+    const FIntPoint DestSizes[] = { FIntPoint(27, 20), FIntPoint(33, 71) };
+
+    FMaskPlane Source;
+    MakePlane(64, 48, Source);
+
+    for (const EFilter BaseFilter : Filters)
+    {
+        for (const uint32 Flags : EdgeFlags)
+        {
+            const EFilter Filter = static_cast<EFilter>(static_cast<uint32>(BaseFilter) | Flags);
+
+            for (const FIntPoint& DestSize : DestSizes)
+            {
+                FMaskPlane Resized;
+                FMaskToolsResampler::Get().Resize(Source, DestSize.X, DestSize.Y, Filter, Resized);
+
+                FImage Expected(DestSize.X, DestSize.Y, ERawImageFormat::R32F, EGammaSpace::Linear);
+                FImageCore::ResizeImage(Source.AsImageView(), Expected, Filter);
+
+                const float MaxDifference = GetMaxDifference(Resized, Expected);
+                TestTrue(FString::Printf(TEXT("Filter %u, flags %u, %dx%d differs by %f"),
+                    static_cast<uint32>(BaseFilter), Flags, DestSize.X, DestSize.Y, MaxDifference), MaxDifference <= Tolerance);
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+* A resized 8 bit channel is the float resize quantized once, darks of an sRGB source are not crushed before filtering.
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaskToolsResamplerQuantizeTest, "MaskTools.Resampler.QuantizesLast", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaskToolsResamplerQuantizeTest::RunTest(const FString& Parameters)
+{
+    // Dark sRGB ramp, most of it decodes below one linear 8 bit step
+    FImage Image(64, 64, ERawImageFormat::G8, EGammaSpace::sRGB);
+    const TArrayView64<uint8> Pixels = Image.AsG8();
+    for (int64 Index = 0; Index < Pixels.Num(); ++Index)
+    {
+        Pixels[Index] = static_cast<uint8>((Index * 7) % 24);
+    }
+
+    const EFilter Filter = EFilter::Box;
+
+    FMaskPlane Quantized;
+    FMaskToolsKernels::ExtractResizedPlane(Image, EMaskChannel::Red, EMaskPlaneFormat::U8, EGammaSpace::Linear, 16, 16, Filter, Quantized);
+
+    FMaskPlane Reference;
+    FMaskToolsKernels::ExtractResizedPlane(Image, EMaskChannel::Red, EMaskPlaneFormat::F32, EGammaSpace::Linear, 16, 16, Filter, Reference);
+
+    const TArrayView64<const uint8> Values = Quantized.AsU8();
+    const TArrayView64<const float> ReferenceValues = Reference.AsF32();
+    for (int64 Index = 0; Index < Values.Num(); ++Index)
+    {
+        const int32 Expected = FMath::RoundToInt(FMath::Clamp(ReferenceValues[Index], 0.f, 1.f) * 255.f);
+        if (FMath::Abs(Values[Index] - Expected) > 1)
+        {
+            AddError(FString::Printf(TEXT("Pixel %lld is %d, float resize gives %d"), Index, Values[Index], Expected));
+            break;
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
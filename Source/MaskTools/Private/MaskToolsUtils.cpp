@@ -10,19 +10,74 @@
 #include "IAssetTools.h"
 #include "IContentBrowserSingleton.h"
 #include "ImageCore.h"
+#include "ImageCoreUtils.h"
 #include "Logging.h"
 #include "MaskToolsEnums.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsMemory.h"
 #include "MaskToolsConfig.h"
+#include "MaskToolsDiskCache.h"
+#include "MaskToolsOutputData.h"
+#include "MaskToolsProgress.h"
+#include "MaskToolsStats.h"
+#include "ObjectTools.h"
 #include "PackageTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Hash/xxhash.h"
 #include "Interfaces/IPluginManager.h"
-#include "Logging.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/ObjectRedirector.h"
 
-void FMaskToolsUtils::ForceTextureCompilation(UTexture2D* Texture)
+namespace MaskToolsUtils
 {
-    FScopedSlowTask ForceTextureCompilationTask(1.f, FText::FromString("Forcing texture compilation..."));
-    ForceTextureCompilationTask.MakeDialog();
-    
+    // Image as the top mip of the source, followed by Mips when given
+    void InitTextureSource(FTextureSource& Source, const FImageView& Image, TConstArrayView<FImage> Mips)
+    {
+        if (Mips.Num() == 0)
+        {
+            Source.Init(Image);
+            return;
+        }
+
+        int64 NumBytes = Image.GetImageSizeBytes();
+        for (const FImage& Mip : Mips)
+        {
+            check(Mip.Format == Image.Format);
+            NumBytes += Mip.RawData.Num();
+        }
+
+        TArray64<uint8> MipData;
+        MipData.Reserve(NumBytes);
+        MipData.Append(static_cast<const uint8*>(Image.RawData), Image.GetImageSizeBytes());
+        for (const FImage& Mip : Mips)
+        {
+            MipData.Append(Mip.RawData);
+        }
+
+        Source.Init(Image.SizeX, Image.SizeY, 1, 1 + Mips.Num(), FImageCoreUtils::ConvertToTextureSourceFormat(Image.Format), MipData.GetData());
+    }
+
+    // Mips are stored in the format of the top mip, float ones end up as half floats like it
+    void ConvertMips(TConstArrayView<FImage> Mips, ERawImageFormat::Type Format, TArray<FImage>& OutMips)
+    {
+        OutMips.SetNum(Mips.Num());
+        for (int32 MipIndex = 0; MipIndex < Mips.Num(); ++MipIndex)
+        {
+            FMaskToolsKernels::ConvertImage(Mips[MipIndex], Format, EGammaSpace::Linear, OutMips[MipIndex]);
+        }
+    }
+}
+
+void FMaskToolsUtils::ForceTextureCompilation(UTexture2D* Texture, FMaskToolsProgress* Progress)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::ForceTextureCompilation);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    if (Progress)
+    {
+        Progress->SetStatus(FString::Printf(TEXT("Compiling %s"), *Texture->GetName()));
+    }
+
     FTextureCompilingManager::Get().FinishCompilation({ Texture });
     Texture->SetForceMipLevelsToBeResident(1.f);
     
@@ -30,6 +85,9 @@ void FMaskToolsUtils::ForceTextureCompilation(UTexture2D* Texture)
 
 TArray<UTexture2D*> FMaskToolsUtils::SyncronousLoadCBTextures(TArray<FAssetData>& LoadedAssetData)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::SyncronousLoadCBTextures);
+    LLM_SCOPE_BYTAG(MaskTools);
+
     FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
     TArray<FAssetData> SelectedObjects;
     ContentBrowserModule.Get().GetSelectedAssets(SelectedObjects);
@@ -46,8 +104,11 @@ TArray<UTexture2D*> FMaskToolsUtils::SyncronousLoadCBTextures(TArray<FAssetData>
     return SelectedTextures;
 }
 
-UTexture2D* FMaskToolsUtils::LoadTextureFromAssetData(const FAssetData& AssetData)
+UTexture2D* FMaskToolsUtils::LoadTextureFromAssetData(const FAssetData& AssetData, FMaskToolsProgress* Progress)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::LoadTextureFromAssetData);
+    LLM_SCOPE_BYTAG(MaskTools);
+
     TSoftObjectPtr<UTexture2D> SoftTexture(AssetData.GetSoftObjectPath());
     UTexture2D* Texture = SoftTexture.LoadSynchronous();
 
@@ -57,7 +118,7 @@ UTexture2D* FMaskToolsUtils::LoadTextureFromAssetData(const FAssetData& AssetDat
     }
 
     //Ensure texture is fully loaded before using it for the render target
-    ForceTextureCompilation(Texture);
+    ForceTextureCompilation(Texture, Progress);
     Texture->UpdateResource();
     return Texture;
 }
@@ -71,66 +132,15 @@ FString FMaskToolsUtils::GetCleanPathName(UObject* OuterObject)
     return PathName;
 }
 
-bool FMaskToolsUtils::GetTexturePixelData(UTexture2D* Texture, int32 DestinationSize, EResizeMethod ResizeMethod, TArray<FLinearColor>& OutData)
-{
-    if (!IsValid(Texture)) return false;
-    
-    FScopedSlowTask GetPixelDataTask(2.f, FText::FromString("Retrieving texture pixel data..."));
-    GetPixelDataTask.MakeDialog();
-
-    auto FillOutDataFromImage = [&OutData, DestinationSize, ResizeMethod](const FImage& Image)
-    {    
-        FImage ResizedImage;
-        ResizedImage.SizeX = DestinationSize;
-        ResizedImage.SizeY = DestinationSize;
-        ResizedImage.Format = Image.Format;
-        ResizedImage.NumSlices = Image.NumSlices;
-        ResizedImage.Init(DestinationSize, DestinationSize, Image.Format);
-    
-        FImageCore::ResizeImage(Image, ResizedImage, FMaskToolsPrivateHelpers::FindResizeMethod(ResizeMethod));
-    
-        TArray<FLinearColor> tmpData;
-        tmpData.Reserve(ResizedImage.SizeX * ResizedImage.SizeY);
-    
-        for (int Y = 0; Y < ResizedImage.SizeY; Y++) 
-        {
-            for (int X = 0; X < ResizedImage.SizeX; X++)
-            {
-                tmpData.Add(ResizedImage.GetOnePixelLinear(X, Y));
-            }
-        }
-        OutData = tmpData;
-    };
-
-    GetPixelDataTask.EnterProgressFrame(1.f, FText::FromString("Trying to access texture CPU Copy..."));
-    if (FSharedImageConstRef TextureCPUCopy = Texture->GetCPUCopy())
-    {
-        FImage Image;
-        TextureCPUCopy->CopyTo(Image);
-        FillOutDataFromImage(Image);
-        return true;
-    }
-
-    GetPixelDataTask.EnterProgressFrame(1.f, FText::FromString("Trying to access texture Source..."));
-    if (Texture->Source.IsValid())
-    {
-        FImage Image;
-        if (Texture->Source.GetMipImage(Image, 0, 0, 0))
-        {
-            FillOutDataFromImage(Image);
-            return true;
-        }
-    }
-
-    return false;
-}
-
 UTexture2D* FMaskToolsUtils::CreateStaticTextureEditorOnly(UTexture2D* TransientTexture, FString InName,
     TextureCompressionSettings InCompressionSettings, TextureMipGenSettings InMipSettings)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::CreateStaticTextureEditorOnly);
+    LLM_SCOPE_BYTAG(MaskTools);
+
     if (TransientTexture == nullptr)
     {
-        UE_LOG(LogTemp, Warning, TEXT("EmptyTexture"))
+        UE_LOG(LogMaskToolsUtils, Warning, TEXT("Can't save an empty texture to %s"), *InName);
         return nullptr;
     }
 
@@ -158,60 +168,729 @@ UTexture2D* FMaskToolsUtils::CreateStaticTextureEditorOnly(UTexture2D* Transient
     TransientTexture->MarkPackageDirty();
     TransientTexture->CompressionSettings = InCompressionSettings;
     TransientTexture->MipGenSettings = InMipSettings;
-    TransientTexture->SRGB = false;
     TransientTexture->PostEditChange();
 
     FAssetRegistryModule::AssetCreated(TransientTexture);
+    INC_DWORD_STAT(STAT_MaskToolsTexturesCreated);
     return TransientTexture;
 }
 
+void FMaskToolsUtils::CopyTextureSettings(const UTexture2D* SourceTexture, UTexture2D* DestinationTexture)
+{
+    if (!SourceTexture || !DestinationTexture) return;
+
+    DestinationTexture->LODBias = SourceTexture->LODBias;
+    DestinationTexture->MaxTextureSize = SourceTexture->MaxTextureSize;
+    DestinationTexture->bPreserveBorder = SourceTexture->bPreserveBorder;
+    DestinationTexture->NeverStream = SourceTexture->NeverStream;
+
+#if UE_VERSION_NEWER_THAN(5, 2, 0)
+    DestinationTexture->CookPlatformTilingSettings = SourceTexture->CookPlatformTilingSettings;
+#endif // UE_VERSION_NEWER_THAN(5, 2, 0)
+
+#if UE_VERSION_NEWER_THAN(5, 4, 0)
+    DestinationTexture->bOodlePreserveExtremes = SourceTexture->bOodlePreserveExtremes;
+#endif // UE_VERSION_NEWER_THAN(5, 4, 0)
+}
+
+bool FMaskToolsUtils::GetTextureSourceImage(UTexture2D* Texture, FImage& OutImage)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::GetTextureSourceImage);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(IsInGameThread());
+
+    if (!IsValid(Texture)) return false;
+
+    if (FSharedImageConstRef TextureCPUCopy = Texture->GetCPUCopy())
+    {
+        TextureCPUCopy->CopyTo(OutImage);
+        INC_DWORD_STAT_BY(STAT_MaskToolsBytesAllocatedTotal, OutImage.RawData.Num());
+        FMaskToolsPeakMemoryTracker::SampleAll();
+        return true;
+    }
+
+    // Decompresses the bulk data, the most expensive stage for big sources
+    if (Texture->Source.IsValid() && Texture->Source.GetMipImage(OutImage, 0, 0, 0))
+    {
+        INC_DWORD_STAT_BY(STAT_MaskToolsBytesAllocatedTotal, OutImage.RawData.Num());
+        FMaskToolsPeakMemoryTracker::SampleAll();
+        return true;
+    }
+
+    return false;
+}
+
+UTexture2D* FMaskToolsUtils::CreateTransientTexture(const FImageView& Image, TextureCompressionSettings InCompressionSettings, TextureMipGenSettings InMipSettings,
+    bool bCompressionNoAlpha, TConstArrayView<FImage> Mips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::CreateTransientTexture);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_KeepForCooker);
+
+    MaskToolsUtils::InitTextureSource(Texture->Source, Image, Mips);
+    Texture->LODGroup = TextureGroup::TEXTUREGROUP_World;
+    Texture->CompressionSettings = InCompressionSettings;
+    Texture->CompressionNoAlpha = bCompressionNoAlpha;
+    Texture->MipGenSettings = InMipSettings;
+    Texture->SRGB = Image.GammaSpace == EGammaSpace::sRGB && ERawImageFormat::GetFormatNeedsGammaSpace(Image.Format);
+    Texture->VirtualTextureStreaming = FMaskToolsPrivateHelpers::NeedsVirtualTexture(Image.SizeX, Image.SizeY);
+    Texture->PostEditChange();
+
+    return Texture;
+}
+
+void FMaskToolsUtils::UpdateTextureSource(UTexture2D* Texture, const FImageView& Image, TConstArrayView<FImage> Mips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::UpdateTextureSource);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    if (!IsValid(Texture)) return;
+
+    Texture->PreEditChange(nullptr);
+    MaskToolsUtils::InitTextureSource(Texture->Source, Image, Mips);
+
+    // Without mips of our own the mip settings are the user's, whatever they are
+    if (Mips.Num() > 0)
+    {
+        Texture->MipGenSettings = TMGS_LeaveExistingMips;
+    }
+    else if (Texture->MipGenSettings == TMGS_LeaveExistingMips)
+    {
+        UE_LOG(LogMaskToolsUtils, Log, TEXT("%s keeps Leave Existing Mips with a single mip source, it has no mips until its Mip Gen Settings change"),
+            *Texture->GetPathName());
+    }
+    Texture->SRGB = Image.GammaSpace == EGammaSpace::sRGB && ERawImageFormat::GetFormatNeedsGammaSpace(Image.Format);
+    // Streaming is the user's choice on existing assets, only new ones are made virtual
+    if (!Texture->VirtualTextureStreaming && FMaskToolsPrivateHelpers::NeedsVirtualTexture(Image.SizeX, Image.SizeY))
+    {
+        UE_LOG(LogMaskToolsUtils, Warning, TEXT("%s is now %dx%d but is not a virtual texture, some platforms may fail to load it"),
+            *Texture->GetPathName(), Image.SizeX, Image.SizeY);
+    }
+    Texture->PostEditChange();
+    Texture->MarkPackageDirty();
+}
+
+FString FMaskToolsUtils::GetTextureContentHash(const UTexture2D* Texture)
+{
+    if (!IsValid(Texture) || !Texture->Source.IsValid()) return FString();
+
+    return Texture->Source.GetId().ToString();
+}
+
+FString FMaskToolsUtils::GetImageContentHash(const FImageView& Image, TextureCompressionSettings InCompressionSettings, bool bCompressionNoAlpha,
+    TConstArrayView<FImage> Mips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::GetImageContentHash);
+
+    const int32 Header[] = { Image.SizeX, Image.SizeY, Image.NumSlices, static_cast<int32>(Image.Format), static_cast<int32>(Image.GammaSpace),
+        static_cast<int32>(InCompressionSettings), bCompressionNoAlpha ? 1 : 0 };
+
+    FXxHash64Builder HashBuilder;
+    HashBuilder.Update(Header, sizeof(Header));
+    HashBuilder.Update(Image.RawData, Image.GetImageSizeBytes());
+
+    // Mips we built are hashed too, engine generated ones follow from the top mip
+    for (const FImage& Mip : Mips)
+    {
+        HashBuilder.Update(Mip.RawData.GetData(), Mip.RawData.Num());
+    }
+    return BytesToHex(reinterpret_cast<const uint8*>(&HashBuilder.Finalize().Hash), sizeof(uint64));
+}
+
+UTexture2D* FMaskToolsUtils::FindTextureAsset(const FString& PackageName)
+{
+    if (!FPackageName::IsValidLongPackageName(PackageName)) return nullptr;
+
+    const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+    return LoadObject<UTexture2D>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+}
+
+UTexture2D* FMaskToolsUtils::WriteOutputTexture(const FImageView& Image, const FString& PackageName, EMaskBlockFormat BlockFormat,
+    const UTexture2D* SettingsSource, UTexture2D* ExistingTexture, bool* bOutUnchanged, TConstArrayView<FImage> Mips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::WriteOutputTexture);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(IsInGameThread());
+
+    if (bOutUnchanged) *bOutUnchanged = false;
+
+    // Float planes are packed as 32 bit floats, the texture only keeps half floats
+    FImage HalfFloatImage;
+    if (Image.Format == ERawImageFormat::R32F || Image.Format == ERawImageFormat::RGBA32F)
+    {
+        const ERawImageFormat::Type HalfFloatFormat = Image.Format == ERawImageFormat::R32F ? ERawImageFormat::R16F : ERawImageFormat::RGBA16F;
+        FMaskToolsKernels::ConvertImage(Image, HalfFloatFormat, EGammaSpace::Linear, HalfFloatImage);
+    }
+    const FImageView SourceImage = HalfFloatImage.RawData.IsEmpty() ? Image : FImageView(HalfFloatImage);
+
+    TArray<FImage> ConvertedMips;
+    TConstArrayView<FImage> SourceMips = Mips;
+    if (Mips.Num() > 0 && Mips[0].Format != SourceImage.Format)
+    {
+        MaskToolsUtils::ConvertMips(Mips, SourceImage.Format, ConvertedMips);
+        SourceMips = ConvertedMips;
+    }
+    const TextureMipGenSettings MipSettings = SourceMips.Num() > 0 ? TMGS_LeaveExistingMips : TMGS_FromTextureGroup;
+
+    UTexture2D* Texture = ExistingTexture;
+    if (!IsValid(Texture) && GetDefault<UMaskToolsConfig>()->bUpdateOutputsInPlace)
+    {
+        // A hand authored texture that happens to have the output name is never overwritten
+        UTexture2D* FoundTexture = FindTextureAsset(PackageName);
+        if (FMaskToolsPrivateHelpers::IsMaskToolsOutput(FoundTexture))
+        {
+            Texture = FoundTexture;
+        }
+        else if (FoundTexture)
+        {
+            UE_LOG(LogMaskToolsUtils, Log, TEXT("%s was not written by the mask tools, writing a new texture next to it"), *FoundTexture->GetPathName());
+        }
+    }
+
+    FString ContentHash;
+    if (IsValid(Texture))
+    {
+        // The texture keeps its compression settings, so they are what the pixels are compared with
+        ContentHash = GetImageContentHash(SourceImage, Texture->CompressionSettings, Texture->CompressionNoAlpha, SourceMips);
+        if (FMaskToolsPrivateHelpers::IsOutputUpToDate(Texture, ContentHash))
+        {
+            UE_LOG(LogMaskToolsUtils, Verbose, TEXT("%s is already up to date"), *Texture->GetPathName());
+            INC_DWORD_STAT(STAT_MaskToolsTexturesUnchanged);
+            if (bOutUnchanged) *bOutUnchanged = true;
+            return Texture;
+        }
+
+        UpdateTextureSource(Texture, SourceImage, SourceMips);
+    }
+    else
+    {
+        bool bCompressionNoAlpha = false;
+        const TextureCompressionSettings InCompressionSettings = FMaskToolsPrivateHelpers::FindCompressionSettings(BlockFormat, bCompressionNoAlpha);
+        ContentHash = GetImageContentHash(SourceImage, InCompressionSettings, bCompressionNoAlpha, SourceMips);
+
+        UTexture2D* NewTexture = CreateTransientTexture(SourceImage, InCompressionSettings, MipSettings, bCompressionNoAlpha, SourceMips);
+
+        // Settings are copied before saving so the asset is only rebuilt once
+        CopyTextureSettings(SettingsSource, NewTexture);
+
+        Texture = CreateStaticTextureEditorOnly(NewTexture, PackageName, InCompressionSettings, MipSettings);
+        if (!Texture) return nullptr;
+
+        Texture->MarkPackageDirty();
+    }
+
+    UMaskToolsOutputData* OutputData = Texture->GetAssetUserData<UMaskToolsOutputData>();
+    if (!OutputData)
+    {
+        OutputData = NewObject<UMaskToolsOutputData>(Texture, NAME_None, RF_Public | RF_Transactional);
+        Texture->AddAssetUserData(OutputData);
+    }
+    OutputData->ContentHash = ContentHash;
+    OutputData->SourceId = Texture->Source.GetId();
+
+    return Texture;
+}
+
+int64 FMaskToolsUtils::EstimateSplitMemory(const FAssetData& AssetData, EMaskPlaneFormat Format, bool bWithMips,
+    TConstArrayView<EMaskResolutions> AdditionalOutputResolutions)
+{
+    FIntPoint Size = FIntPoint::ZeroValue;
+    int32 SourceBytesPerPixel = 8;
+
+    const UTexture2D* Texture = Cast<UTexture2D>(AssetData.FastGetAsset(false));
+    if (Texture && Texture->Source.IsValid())
+    {
+        Size = FIntPoint(Texture->Source.GetSizeX(), Texture->Source.GetSizeY());
+        SourceBytesPerPixel = Texture->Source.GetBytesPerPixel();
+    }
+    else
+    {
+        // Written by textures as WidthxHeight
+        FString Dimensions;
+        FString SizeX;
+        FString SizeY;
+        if (!AssetData.GetTagValue(TEXT("Dimensions"), Dimensions) || !Dimensions.Split(TEXT("x"), &SizeX, &SizeY))
+        {
+            return 0;
+        }
+        Size = FIntPoint(FCString::Atoi(*SizeX), FCString::Atoi(*SizeY));
+    }
+
+    const TArray<FIntPoint> ResizedSizes = FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(Size, AdditionalOutputResolutions);
+    return FMaskToolsMemory::EstimateSplitMemory(Size.X, Size.Y, SourceBytesPerPixel, Format, bWithMips, ResizedSizes);
+}
+
+FString FMaskToolsUtils::GetImageFilePath(const FString& PackageName)
+{
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+    const EMaskImageFileFormat Format = FMaskToolsPrivateHelpers::FindImageFileFormat(Config->ImageFileFormat);
+
+    // /Game/Textures/T_Mask goes to <Folder>/Game/Textures/T_Mask.png
+    FString RelativePath = PackageName;
+    RelativePath.RemoveFromStart(TEXT("/"));
+    return Config->GetImageFileDirectory() / RelativePath + FMaskToolsImageFiles::GetExtension(Format);
+}
+
+UObjectRedirector* FMaskToolsUtils::CreateRedirector(const FString& PackageName, UObject* Destination)
+{
+    if (!IsValid(Destination) || !FPackageName::IsValidLongPackageName(PackageName)) return nullptr;
+
+    // Splitting again finds the redirector the previous split left
+    const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+    if (UObjectRedirector* ExistingRedirector = LoadObject<UObjectRedirector>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet))
+    {
+        if (ExistingRedirector->DestinationObject == Destination)
+        {
+            return ExistingRedirector;
+        }
+    }
+
+    if (FindPackage(nullptr, *PackageName) || FPackageName::DoesPackageExist(PackageName))
+    {
+        UE_LOG(LogMaskToolsUtils, Warning, TEXT("Can't redirect %s to %s, an asset already exists there"), *PackageName, *Destination->GetPathName());
+        return nullptr;
+    }
+
+    UPackage* Package = CreatePackage(*PackageName);
+    UObjectRedirector* Redirector = NewObject<UObjectRedirector>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+    Redirector->DestinationObject = Destination;
+
+    FAssetRegistryModule::AssetCreated(Redirector);
+    Redirector->MarkPackageDirty();
+    return Redirector;
+}
+
+void FMaskToolsUtils::ReplaceDuplicateOutput(const FString& PackageName, UTexture2D* Original, bool bRedirect)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsUtils::ReplaceDuplicateOutput);
+    check(IsInGameThread());
+
+    UTexture2D* StaleOutput = FindTextureAsset(PackageName);
+    if (StaleOutput == Original) return;
+
+    if (!FMaskToolsPrivateHelpers::IsMaskToolsOutput(StaleOutput))
+    {
+        if (bRedirect && IsValid(Original))
+        {
+            CreateRedirector(PackageName, Original);
+        }
+        return;
+    }
+
+    if (bRedirect && IsValid(Original))
+    {
+        // Consolidating moves every reference to the original and leaves a redirector in place of the stale output
+        TArray<UObject*> ObjectsToConsolidate = { StaleOutput };
+        ObjectTools::ConsolidateObjects(Original, ObjectsToConsolidate, false);
+        UE_LOG(LogMaskToolsUtils, Log, TEXT("Replaced stale output %s with a redirector to %s"), *PackageName, *Original->GetPathName());
+        return;
+    }
+
+    const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    TArray<FName> Referencers;
+    AssetRegistry.GetReferencers(*PackageName, Referencers);
+    if (Referencers.Num() > 0)
+    {
+        UE_LOG(LogMaskToolsUtils, Warning, TEXT("%s holds a channel that is now a duplicate but is still referenced, it was left as is. Enable Redirect Duplicate Channels to replace it"),
+            *PackageName);
+        return;
+    }
+
+    const TArray<UObject*> ObjectsToDelete = { StaleOutput };
+    if (ObjectTools::DeleteObjects(ObjectsToDelete, false) > 0)
+    {
+        UE_LOG(LogMaskToolsUtils, Log, TEXT("Deleted stale output %s, its channel is now a duplicate"), *PackageName);
+    }
+}
+
+void FMaskToolsUtils::ReportDuplicateChannels(const UTexture2D* Texture, TConstArrayView<int32> DuplicateOf)
+{
+    const TCHAR* ChannelNames[] = { TEXT("Red"), TEXT("Green"), TEXT("Blue"), TEXT("Alpha") };
+    const FString TextureName = IsValid(Texture) ? Texture->GetPathName() : FString();
+
+    for (int32 ChannelIndex = 0; ChannelIndex < DuplicateOf.Num() && ChannelIndex < UE_ARRAY_COUNT(ChannelNames); ++ChannelIndex)
+    {
+        if (DuplicateOf[ChannelIndex] == INDEX_NONE) continue;
+
+        UE_LOG(LogMaskToolsUtils, Log, TEXT("%s channel of %s is identical to its %s channel"),
+            ChannelNames[ChannelIndex], *TextureName, ChannelNames[DuplicateOf[ChannelIndex]]);
+    }
+
+    if (DuplicateOf.Num() >= 3 && DuplicateOf[1] == 0 && DuplicateOf[2] == 0)
+    {
+        UE_LOG(LogMaskToolsUtils, Display, TEXT("%s is grayscale stored as RGB, it could be a single channel texture"), *TextureName);
+    }
+}
+
+FString FMaskToolsUtils::GetPlaneCacheKey(const UTexture2D* Texture, EMaskChannel Channel, int32 SizeX, int32 SizeY,
+    EResizeMethod ResizeMethod, EMaskPlaneFormat Format, EGammaSpace Gamma, EGammaSpace SourceGamma)
+{
+    const FString Parameters = FString::Printf(TEXT("Plane,%d,%dx%d,%u,%d,%d,%d"), static_cast<int32>(Channel), SizeX, SizeY,
+        static_cast<uint32>(ResizeMethod), static_cast<int32>(Format), static_cast<int32>(Gamma), static_cast<int32>(SourceGamma));
+
+    return FMaskToolsDiskCache::MakeKey(GetTextureContentHash(Texture), Parameters);
+}
+
+FMaskChannelStats::FMaskChannelStats(const FMaskPlaneStats& PlaneStats)
+    : Min(PlaneStats.Min)
+    , Max(PlaneStats.Max)
+    , Mean(PlaneStats.Mean)
+    , bHasData(PlaneStats.bHasData)
+    , bIsConstant(PlaneStats.bIsConstant)
+{
+}
+
 FImageCore::EResizeImageFilter FMaskToolsPrivateHelpers::FindResizeMethod(EResizeMethod Method)
 {
-    switch (Method)
+    using EFilter = FImageCore::EResizeImageFilter;
+
+    EFilter Filter;
+    switch (FindBaseResizeMethod(Method))
     {
     case EResizeMethod::AdaptiveSharp:
-        return FImageCore::EResizeImageFilter::AdaptiveSharp;
+        Filter = EFilter::AdaptiveSharp;
+        break;
 
     case EResizeMethod::Bilinear:
-        return FImageCore::EResizeImageFilter::Triangle;
+    case EResizeMethod::Triangle:
+        Filter = EFilter::Triangle;
+        break;
 
     case EResizeMethod::AdaptiveSmooth:
-        return FImageCore::EResizeImageFilter::AdaptiveSmooth;
+        Filter = EFilter::AdaptiveSmooth;
+        break;
 
     case EResizeMethod::Box:
-        return FImageCore::EResizeImageFilter::Box;
+        Filter = EFilter::Box;
+        break;
 
     case EResizeMethod::CubicGaussian:
-        return FImageCore::EResizeImageFilter::CubicGaussian;
+        Filter = EFilter::CubicGaussian;
+        break;
 
     case EResizeMethod::CubicMitchell:
-        return FImageCore::EResizeImageFilter::CubicMitchell;
+        Filter = EFilter::CubicMitchell;
+        break;
 
     case EResizeMethod::CubicSharp:
-         return FImageCore::EResizeImageFilter::CubicSharp;
+        Filter = EFilter::CubicSharp;
+        break;
+
+    case EResizeMethod::PointSample:
+        Filter = EFilter::PointSample;
+        break;
 
     case EResizeMethod::Default:
-        return FImageCore::EResizeImageFilter::Default;
+    default:
+        Filter = EFilter::Default;
+        break;
+    }
 
-    case EResizeMethod::Flag_WrapX:
-        return FImageCore::EResizeImageFilter::Flag_WrapX;
+    // The switch above could only return a filter or a flag, never both, so tiling textures were always clamped
+    uint32 Flags = 0;
+    const EMaskEdgeMode EdgeMode = FindEdgeMode(Method);
+    if (EdgeMode == EMaskEdgeMode::WrapX || EdgeMode == EMaskEdgeMode::Wrap)
+    {
+        Flags |= static_cast<uint32>(EFilter::Flag_WrapX);
+    }
+    if (EdgeMode == EMaskEdgeMode::WrapY || EdgeMode == EMaskEdgeMode::Wrap)
+    {
+        Flags |= static_cast<uint32>(EFilter::Flag_WrapY);
+    }
 
-    case EResizeMethod::Flag_WrapY:
-        return FImageCore::EResizeImageFilter::Flag_WrapY;
+    return static_cast<EFilter>(static_cast<uint32>(Filter) | Flags);
+}
 
-    case EResizeMethod::PointSample:
-        return FImageCore::EResizeImageFilter::PointSample;
+EResizeMethod FMaskToolsPrivateHelpers::CombineResizeMethod(EResizeMethod Method, EMaskEdgeMode EdgeMode)
+{
+    uint32 Flags = 0;
+    if (EdgeMode == EMaskEdgeMode::WrapX || EdgeMode == EMaskEdgeMode::Wrap)
+    {
+        Flags |= static_cast<uint32>(EResizeMethod::Flag_WrapX);
+    }
+    if (EdgeMode == EMaskEdgeMode::WrapY || EdgeMode == EMaskEdgeMode::Wrap)
+    {
+        Flags |= static_cast<uint32>(EResizeMethod::Flag_WrapY);
+    }
 
-    case EResizeMethod::Triangle:
-        return FImageCore::EResizeImageFilter::Triangle;
+    return static_cast<EResizeMethod>(static_cast<uint32>(Method) | Flags);
+}
+
+EResizeMethod FMaskToolsPrivateHelpers::ResolveResizeMethod(EResizeMethod Method, EResizeMethod DefaultMethod)
+{
+    if (FindBaseResizeMethod(Method) != EResizeMethod::Default)
+    {
+        return Method;
+    }
+
+    return static_cast<EResizeMethod>(static_cast<uint32>(Method) | static_cast<uint32>(DefaultMethod));
+}
+
+EResizeMethod FMaskToolsPrivateHelpers::FindBaseResizeMethod(EResizeMethod Method)
+{
+    return static_cast<EResizeMethod>(static_cast<uint32>(Method) & static_cast<uint32>(EResizeMethod::WithoutFlagsMask));
+}
 
-    case EResizeMethod::WithoutFlagsMask:
-        return FImageCore::EResizeImageFilter::WithoutFlagsMask;
+EMaskEdgeMode FMaskToolsPrivateHelpers::FindEdgeMode(EResizeMethod Method)
+{
+    const bool bWrapX = (static_cast<uint32>(Method) & static_cast<uint32>(EResizeMethod::Flag_WrapX)) != 0;
+    const bool bWrapY = (static_cast<uint32>(Method) & static_cast<uint32>(EResizeMethod::Flag_WrapY)) != 0;
 
+    if (bWrapX && bWrapY) return EMaskEdgeMode::Wrap;
+    if (bWrapX) return EMaskEdgeMode::WrapX;
+    if (bWrapY) return EMaskEdgeMode::WrapY;
+    return EMaskEdgeMode::Clamp;
+}
+
+EMaskChannel FMaskToolsPrivateHelpers::FindMaskChannel(EMaskTextureChannel Channel)
+{
+    switch (Channel)
+    {
+    case EMaskTextureChannel::Green:
+        return EMaskChannel::Green;
+
+    case EMaskTextureChannel::Blue:
+        return EMaskChannel::Blue;
+
+    case EMaskTextureChannel::Alpha:
+        return EMaskChannel::Alpha;
+
+    case EMaskTextureChannel::Red:
     default:
-        return FImageCore::EResizeImageFilter::Default;
-        
+        return EMaskChannel::Red;
+    }
+}
+
+EMaskImageFileFormat FMaskToolsPrivateHelpers::FindImageFileFormat(EMaskFileFormat Format)
+{
+    switch (Format)
+    {
+    case EMaskFileFormat::PNG16:
+        return EMaskImageFileFormat::PNG16;
+
+    case EMaskFileFormat::TGA:
+        return EMaskImageFileFormat::TGA;
+
+    case EMaskFileFormat::EXR:
+        return EMaskImageFileFormat::EXR;
+
+    case EMaskFileFormat::PNG8:
+    default:
+        return EMaskImageFileFormat::PNG8;
+    }
+}
+
+TextureCompressionSettings FMaskToolsPrivateHelpers::FindCompressionSettings(EMaskBlockFormat Format, bool& bOutCompressionNoAlpha)
+{
+    bOutCompressionNoAlpha = false;
+
+    switch (Format)
+    {
+    case EMaskBlockFormat::BC4:
+        return TC_Grayscale;
+
+    case EMaskBlockFormat::BC1:
+        bOutCompressionNoAlpha = true;
+        return TC_Masks;
+
+    case EMaskBlockFormat::BC7:
+        return TC_BC7;
+
+    // Grayscale keeps 16 bit sources uncompressed as G16
+    case EMaskBlockFormat::G16:
+        return TC_Grayscale;
+
+    case EMaskBlockFormat::R16F:
+        return TC_HalfFloat;
+
+    case EMaskBlockFormat::RGBA16F:
+        return TC_HDR;
+
+    case EMaskBlockFormat::RGBA32F:
+        return TC_HDR_F32;
+
+    case EMaskBlockFormat::BC3:
+    default:
+        return TC_Masks;
+    }
+}
+
+EMaskBlockFormat FMaskToolsPrivateHelpers::FindMaskBlockFormat(TArrayView<const FMaskPlaneStats> ChannelStats, EMaskPlaneFormat Format, bool bChooseFromChannels)
+{
+    if (!bChooseFromChannels)
+    {
+        switch (Format)
+        {
+        case EMaskPlaneFormat::U16:
+            return EMaskBlockFormat::RGBA32F;
+        case EMaskPlaneFormat::F32:
+            return EMaskBlockFormat::RGBA16F;
+        case EMaskPlaneFormat::U8:
+        default:
+            return EMaskBlockFormat::BC3;
+        }
+    }
+
+    return FMaskToolsKernels::ChooseBlockFormat(ChannelStats, Format);
+}
+
+EMaskPlaneFormat FMaskToolsPrivateHelpers::FindPlaneFormat(EMaskPrecision Precision)
+{
+    switch (Precision)
+    {
+    case EMaskPrecision::SixteenBit:
+        return EMaskPlaneFormat::U16;
+
+    case EMaskPrecision::Float:
+        return EMaskPlaneFormat::F32;
+
+    case EMaskPrecision::EightBit:
+    default:
+        return EMaskPlaneFormat::U8;
+    }
+}
+
+EMaskMipReduction FMaskToolsPrivateHelpers::FindMipReduction(EMaskMipFilter Filter)
+{
+    switch (Filter)
+    {
+    case EMaskMipFilter::Max:
+        return EMaskMipReduction::Max;
+
+    case EMaskMipFilter::Min:
+        return EMaskMipReduction::Min;
+
+    case EMaskMipFilter::Coverage:
+        return EMaskMipReduction::Coverage;
+
+    case EMaskMipFilter::Average:
+    default:
+        return EMaskMipReduction::Average;
+    }
+}
+
+FMaskMipSettings FMaskToolsPrivateHelpers::FindMipSettings()
+{
+    check(IsInGameThread());
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+
+    FMaskMipSettings Settings;
+    Settings.bEnabled = Config->bGenerateMipsPerChannel;
+    Settings.Reductions[0] = FindMipReduction(Config->RedMipFilter);
+    Settings.Reductions[1] = FindMipReduction(Config->GreenMipFilter);
+    Settings.Reductions[2] = FindMipReduction(Config->BlueMipFilter);
+    Settings.Reductions[3] = FindMipReduction(Config->AlphaMipFilter);
+    Settings.CoverageThreshold = Config->MipCoverageThreshold;
+    return Settings;
+}
+
+EGammaSpace FMaskToolsPrivateHelpers::FindGammaSpace(EMaskColorSpace ColorSpace, EGammaSpace NativeGammaSpace)
+{
+    switch (ColorSpace)
+    {
+    case EMaskColorSpace::Linear:
+        return EGammaSpace::Linear;
+
+    case EMaskColorSpace::SRGB:
+        return EGammaSpace::sRGB;
+
+    case EMaskColorSpace::FromTexture:
+    default:
+        return NativeGammaSpace;
+    }
+}
+
+EGammaSpace FMaskToolsPrivateHelpers::FindInputGammaSpace(EMaskColorSpace SlotColorSpace, EMaskColorSpace ProjectColorSpace, EGammaSpace NativeGammaSpace)
+{
+    return FindGammaSpace(SlotColorSpace, FindGammaSpace(ProjectColorSpace, NativeGammaSpace));
+}
+
+EGammaSpace FMaskToolsPrivateHelpers::FindTextureGammaSpace(const UTexture2D* Texture)
+{
+    if (!IsValid(Texture) || !Texture->SRGB) return EGammaSpace::Linear;
+
+    const ETextureSourceFormat SourceFormat = Texture->Source.GetFormat();
+    return SourceFormat == TSF_G8 || SourceFormat == TSF_BGRA8 ? EGammaSpace::sRGB : EGammaSpace::Linear;
+}
+
+void FMaskToolsPrivateHelpers::FindSplitGammaSpaces(const UTexture2D* Texture, EMaskPlaneFormat Format, EGammaSpace& OutSourceGamma, EGammaSpace& OutPlaneGamma)
+{
+    check(IsInGameThread());
+    const UMaskToolsConfig* Config = GetDefault<UMaskToolsConfig>();
+
+    OutSourceGamma = FindGammaSpace(Config->InputColorSpace, FindTextureGammaSpace(Texture));
+
+    // Keeping the source encoding copies the values untouched
+    OutPlaneGamma = Format == EMaskPlaneFormat::U8 ? FindGammaSpace(Config->SplitColorSpace, OutSourceGamma) : EGammaSpace::Linear;
+}
+
+int32 FMaskToolsPrivateHelpers::FindResolution(EMaskResolutions Resolution)
+{
+    if (Resolution == EMaskResolutions::Custom) return 512;
+
+    // Enum values are consecutive powers of two starting at 32
+    return 32 << static_cast<uint8>(Resolution);
+}
+
+FIntPoint FMaskToolsPrivateHelpers::FindResolutionSize(EMaskResolutions Resolution, FIntPoint CustomSize)
+{
+    if (Resolution != EMaskResolutions::Custom)
+    {
+        const int32 Size = FindResolution(Resolution);
+        return FIntPoint(Size, Size);
     }
+
+    return FIntPoint(FMath::Clamp(CustomSize.X, 1, FMaskPlane::MaxSize), FMath::Clamp(CustomSize.Y, 1, FMaskPlane::MaxSize));
+}
+
+EMaskResolutions FMaskToolsPrivateHelpers::FindMaskResolution(int32 SizeX, int32 SizeY)
+{
+    if (SizeX != SizeY || SizeX < 32 || SizeX > FMaskPlane::MaxSize || !FMath::IsPowerOfTwo(SizeX))
+    {
+        return EMaskResolutions::Custom;
+    }
+
+    return static_cast<EMaskResolutions>(FMath::FloorLog2(static_cast<uint32>(SizeX)) - 5);
+}
+
+TArray<FIntPoint> FMaskToolsPrivateHelpers::FindAdditionalOutputSizes(FIntPoint Size, TConstArrayView<EMaskResolutions> Resolutions)
+{
+    TArray<FIntPoint> Sizes;
+    const int32 LongestSide = FMath::Max(Size.X, Size.Y);
+
+    for (const EMaskResolutions Resolution : Resolutions)
+    {
+        if (Resolution == EMaskResolutions::Custom) continue;
+
+        const int32 Side = FindResolution(Resolution);
+        if (Side >= LongestSide) continue;
+
+        const FIntPoint ResizedSize(
+            FMath::Max(1, FMath::RoundToInt(static_cast<double>(Size.X) * Side / LongestSide)),
+            FMath::Max(1, FMath::RoundToInt(static_cast<double>(Size.Y) * Side / LongestSide)));
+        Sizes.AddUnique(ResizedSize);
+    }
+
+    Sizes.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.X > B.X || (A.X == B.X && A.Y > B.Y); });
+    return Sizes;
+}
+
+FString FMaskToolsPrivateHelpers::GetResizedOutputName(const FString& PackageName, FIntPoint Size)
+{
+    return FString::Printf(TEXT("%s_%d"), *PackageName, FMath::Max(Size.X, Size.Y));
+}
+
+bool FMaskToolsPrivateHelpers::IsValidMaskSize(int32 SizeX, int32 SizeY)
+{
+    return SizeX > 0 && SizeY > 0 && SizeX <= FMaskPlane::MaxSize && SizeY <= FMaskPlane::MaxSize;
+}
+
+bool FMaskToolsPrivateHelpers::NeedsVirtualTexture(int32 SizeX, int32 SizeY)
+{
+    // Largest regular texture every platform can load
+    constexpr int32 MaxRegularTextureSize = 8192;
+    return SizeX > MaxRegularTextureSize || SizeY > MaxRegularTextureSize;
 }
 
 UMaterialInterface* FMaskToolsPrivateHelpers::LoadPluginMaterial(const FString& MaterialName)
@@ -221,7 +900,7 @@ UMaterialInterface* FMaskToolsPrivateHelpers::LoadPluginMaterial(const FString&
 
     if (!Plugin.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("Plugin %s not found"), *PluginName);
+        UE_LOG(LogMaskToolsUtils, Error, TEXT("Plugin %s not found"), *PluginName);
         return nullptr;
     }
 
@@ -239,3 +918,26 @@ UMaterialInterface* FMaskToolsPrivateHelpers::LoadPluginMaterial(const FString&
     return BaseMaterial;
 }
 
+bool FMaskToolsPrivateHelpers::IsMaskToolsOutput(UTexture2D* Texture)
+{
+    return IsValid(Texture) && Texture->GetAssetUserData<UMaskToolsOutputData>() != nullptr;
+}
+
+bool FMaskToolsPrivateHelpers::IsOutputUpToDate(UTexture2D* Texture, const FString& ContentHash)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsPrivateHelpers::IsOutputUpToDate);
+
+    if (!IsValid(Texture) || !Texture->Source.IsValid()) return false;
+
+    const UMaskToolsOutputData* OutputData = Texture->GetAssetUserData<UMaskToolsOutputData>();
+    if (OutputData && OutputData->SourceId == Texture->Source.GetId())
+    {
+        return OutputData->ContentHash == ContentHash;
+    }
+
+    // Reimported or written by another tool since, compare with what the source actually holds
+    FImage SourceImage;
+    if (!Texture->Source.GetMipImage(SourceImage, 0, 0, 0)) return false;
+
+    return FMaskToolsUtils::GetImageContentHash(SourceImage, Texture->CompressionSettings, Texture->CompressionNoAlpha) == ContentHash;
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsWorkerPool.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Logging.h"
+#include "MaskToolsStats.h"
+#include "MaskToolsWorkerProtocol.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace MaskToolsWorkerPool
+{
+    // How often a waiting thread checks for a result or an idle worker
+    constexpr float PollSeconds = 0.005f;
+
+    // Time workers get to quit on their own at shutdown
+    constexpr double QuitTimeoutSeconds = 1.0;
+}
+
+FMaskToolsWorkerPool& FMaskToolsWorkerPool::Get()
+{
+    static FMaskToolsWorkerPool Instance;
+    return Instance;
+}
+
+bool FMaskToolsWorkerPool::Configure(int32 InMaxWorkers, int32 InTaskTimeoutSeconds)
+{
+    check(IsInGameThread());
+
+    const FString Path = GetWorkerPath();
+    if (Path.IsEmpty())
+    {
+        UE_LOG(LogMaskTools, Warning, TEXT("MaskToolsWorker was not found, build the MaskToolsWorker target to use worker processes. Splitting in the editor instead"));
+        return false;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    WorkerPath = Path;
+    MaxWorkers = FMath::Max(1, InMaxWorkers);
+    TaskTimeoutSeconds = FMath::Max(0, InTaskTimeoutSeconds);
+    return true;
+}
+
+FString FMaskToolsWorkerPool::GetWorkerPath()
+{
+    const FString ExecutableName = FString(TEXT("MaskToolsWorker")) + FPlatformProcess::GetExecutableExtension();
+
+    if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MaskTools")))
+    {
+        const FString PluginPath = FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Binaries") / FPlatformProcess::GetBinariesSubdirectory() / ExecutableName);
+        if (FPaths::FileExists(PluginPath))
+        {
+            return PluginPath;
+        }
+    }
+
+    const FString EnginePath = FPlatformProcess::GenerateApplicationPath(TEXT("MaskToolsWorker"), EBuildConfiguration::Development);
+    return FPaths::FileExists(EnginePath) ? EnginePath : FString();
+}
+
+EMaskWorkerTaskResult FMaskToolsWorkerPool::RunSplitTask(const FMaskToolsSplitTask& Task, FMaskToolsSplitResult& OutResult)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerPool::RunSplitTask);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(!IsInGameThread());
+
+    const TSharedPtr<FWorker, ESPMode::ThreadSafe> Worker = AcquireWorker();
+    if (!Worker)
+    {
+        return EMaskWorkerTaskResult::Unavailable;
+    }
+
+    int32 TaskId = 0;
+    double TimeoutSeconds = 0.0;
+    {
+        FScopeLock ScopeLock(&Lock);
+        TaskId = NextTaskId++;
+        TimeoutSeconds = TaskTimeoutSeconds;
+    }
+
+    const FString TaskName = FString::Printf(TEXT("%08d"), TaskId);
+    const FString TaskPath = Worker->WorkingDirectory / TaskName + FMaskToolsWorkerProtocol::TaskExtension;
+    const FString ResultPath = Worker->WorkingDirectory / TaskName + FMaskToolsWorkerProtocol::ResultExtension;
+
+    if (!FMaskToolsWorkerProtocol::SaveTask(TaskPath, Task))
+    {
+        ReleaseWorker(Worker);
+        return EMaskWorkerTaskResult::Unavailable;
+    }
+
+    EMaskWorkerTaskResult Result = EMaskWorkerTaskResult::Failed;
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerPool::WaitForResult);
+
+        const double Deadline = TimeoutSeconds > 0.0 ? FPlatformTime::Seconds() + TimeoutSeconds : 0.0;
+        while (true)
+        {
+            // Checked before the process, a worker may write its result and exit right after
+            const bool bRunning = FPlatformProcess::IsProcRunning(Worker->Process);
+            if (IFileManager::Get().FileExists(*ResultPath))
+            {
+                // An empty result means the worker could not read the task
+                const bool bLoaded = FMaskToolsWorkerProtocol::LoadResult(ResultPath, OutResult) && OutResult.Planes.Num() == 4;
+                Result = bLoaded ? EMaskWorkerTaskResult::Succeeded : EMaskWorkerTaskResult::Failed;
+                break;
+            }
+
+            if (!bRunning)
+            {
+                int32 ReturnCode = 0;
+                FPlatformProcess::GetProcReturnCode(Worker->Process, &ReturnCode);
+                UE_LOG(LogMaskTools, Warning, TEXT("MaskToolsWorker exited with code %d while running task %s"), ReturnCode, *TaskPath);
+                break;
+            }
+
+            // A hung worker is replaced by a new one on the next acquire
+            if (Deadline > 0.0 && FPlatformTime::Seconds() > Deadline)
+            {
+                UE_LOG(LogMaskTools, Warning, TEXT("MaskToolsWorker did not finish task %s within %.0f seconds and was terminated"), *TaskPath, TimeoutSeconds);
+                FPlatformProcess::TerminateProc(Worker->Process, true);
+                break;
+            }
+
+            FPlatformProcess::Sleep(MaskToolsWorkerPool::PollSeconds);
+        }
+    }
+
+    IFileManager::Get().Delete(*TaskPath, false, false, true);
+    IFileManager::Get().Delete(*ResultPath, false, false, true);
+    ReleaseWorker(Worker);
+    return Result;
+}
+
+TSharedPtr<FMaskToolsWorkerPool::FWorker, ESPMode::ThreadSafe> FMaskToolsWorkerPool::AcquireWorker()
+{
+    while (true)
+    {
+        {
+            FScopeLock ScopeLock(&Lock);
+
+            // Workers that crashed or were terminated are replaced by new ones, along with the tasks they left behind
+            for (int32 WorkerIndex = Workers.Num() - 1; WorkerIndex >= 0; --WorkerIndex)
+            {
+                FWorker& Worker = *Workers[WorkerIndex];
+                if (!Worker.bBusy && !FPlatformProcess::IsProcRunning(Worker.Process))
+                {
+                    FPlatformProcess::CloseProc(Worker.Process);
+                    IFileManager::Get().DeleteDirectory(*Worker.WorkingDirectory, false, true);
+                    Workers.RemoveAt(WorkerIndex);
+                }
+            }
+
+            for (const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker : Workers)
+            {
+                if (!Worker->bBusy)
+                {
+                    Worker->bBusy = true;
+                    return Worker;
+                }
+            }
+
+            if (Workers.Num() < MaxWorkers)
+            {
+                if (TSharedPtr<FWorker, ESPMode::ThreadSafe> Worker = LaunchWorker())
+                {
+                    Worker->bBusy = true;
+                    return Worker;
+                }
+            }
+
+            // Nothing to wait for
+            if (Workers.Num() == 0)
+            {
+                return nullptr;
+            }
+        }
+
+        FPlatformProcess::Sleep(MaskToolsWorkerPool::PollSeconds);
+    }
+}
+
+void FMaskToolsWorkerPool::ReleaseWorker(const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker)
+{
+    FScopeLock ScopeLock(&Lock);
+    Worker->bBusy = false;
+}
+
+TSharedPtr<FMaskToolsWorkerPool::FWorker, ESPMode::ThreadSafe> FMaskToolsWorkerPool::LaunchWorker()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerPool::LaunchWorker);
+    if (WorkerPath.IsEmpty()) return nullptr;
+
+    const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+    const FString WorkingDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("MaskToolsWorker")
+        / FString::Printf(TEXT("%u-%d"), ProcessId, NumLaunched++));
+
+    // Leftovers of a previous worker with the same name would be taken as tasks
+    IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+    if (!IFileManager::Get().MakeDirectory(*WorkingDirectory, true))
+    {
+        UE_LOG(LogMaskTools, Warning, TEXT("Failed to create the MaskToolsWorker directory %s"), *WorkingDirectory);
+        return nullptr;
+    }
+
+    // Below normal priority, so the editor stays responsive while workers are busy
+    const FString Params = FString::Printf(TEXT("\"%s\" -ParentPID=%u"), *WorkingDirectory, ProcessId);
+    FProcHandle Process = FPlatformProcess::CreateProc(*WorkerPath, *Params, true, true, true, nullptr, -1, nullptr, nullptr);
+    if (!Process.IsValid())
+    {
+        UE_LOG(LogMaskTools, Warning, TEXT("Failed to launch %s"), *WorkerPath);
+        return nullptr;
+    }
+
+    TSharedPtr<FWorker, ESPMode::ThreadSafe> Worker = MakeShared<FWorker, ESPMode::ThreadSafe>();
+    Worker->Process = Process;
+    Worker->WorkingDirectory = WorkingDirectory;
+    Workers.Add(Worker);
+
+    UE_LOG(LogMaskTools, Log, TEXT("Launched MaskToolsWorker %d of %d in %s"), Workers.Num(), MaxWorkers, *WorkingDirectory);
+    return Worker;
+}
+
+void FMaskToolsWorkerPool::Shutdown()
+{
+    TArray<TSharedPtr<FWorker, ESPMode::ThreadSafe>> WorkersToStop;
+    {
+        FScopeLock ScopeLock(&Lock);
+        WorkersToStop = MoveTemp(Workers);
+        MaxWorkers = 0;
+    }
+
+    for (const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker : WorkersToStop)
+    {
+        FFileHelper::SaveStringToFile(FString(), *(Worker->WorkingDirectory / FMaskToolsWorkerProtocol::QuitFileName));
+    }
+
+    const double Deadline = FPlatformTime::Seconds() + MaskToolsWorkerPool::QuitTimeoutSeconds;
+    for (const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker : WorkersToStop)
+    {
+        while (FPlatformProcess::IsProcRunning(Worker->Process) && FPlatformTime::Seconds() < Deadline)
+        {
+            FPlatformProcess::Sleep(MaskToolsWorkerPool::PollSeconds);
+        }
+
+        if (FPlatformProcess::IsProcRunning(Worker->Process))
+        {
+            FPlatformProcess::TerminateProc(Worker->Process, true);
+        }
+    }
+
+    // A thread waiting on a worker sees it exit and releases it, its handle must stay open until then
+    for (const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker : WorkersToStop)
+    {
+        while (true)
+        {
+            {
+                FScopeLock ScopeLock(&Lock);
+                if (!Worker->bBusy) break;
+            }
+            FPlatformProcess::Sleep(MaskToolsWorkerPool::PollSeconds);
+        }
+
+        FPlatformProcess::CloseProc(Worker->Process);
+        IFileManager::Get().DeleteDirectory(*Worker->WorkingDirectory, false, true);
+    }
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "MaskToolsEnums.h"
+#include "UObject/Object.h"
+#include "MaskRecipe.generated.h"
+
+class UMaskToolsAsyncOperation;
+
+/**
+ * One input of a mask recipe.
+ */
+USTRUCT(BlueprintType)
+struct MASKTOOLS_API FMaskRecipeSlot
+{
+	GENERATED_BODY()
+
+	// Leave empty to fill the channel with black, or white for alpha
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	TSoftObjectPtr<UTexture2D> Texture;
+
+	// Channel of Texture copied into the mask
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	EMaskTextureChannel SourceChannel = EMaskTextureChannel::Red;
+
+	// Default uses the mixer resize method from the project settings
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	EResizeMethod ResizeMethod = EResizeMethod::Default;
+
+	// Wrap for tiling textures, so the resized channel stays seamless
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	EMaskEdgeMode EdgeMode = EMaskEdgeMode::Clamp;
+
+	// How the values of Texture are encoded, sRGB ones are decoded to linear before packing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	EMaskColorSpace ColorSpace = EMaskColorSpace::FromTexture;
+
+	// Content hash of Texture when the output was last built
+	UPROPERTY(VisibleAnywhere, Category = "Mask Recipe", AdvancedDisplay)
+	FString BuiltInputHash;
+};
+
+/**
+ * Records the inputs and parameters that produce a packed mask, so the mask can be rebuilt
+ * when, and only when, one of them changes.
+ */
+UCLASS(BlueprintType)
+class MASKTOOLS_API UMaskRecipe : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	FMaskRecipeSlot Red;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	FMaskRecipeSlot Green;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	FMaskRecipeSlot Blue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	FMaskRecipeSlot Alpha;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	EMaskResolutions Resolution = EMaskResolutions::FiveHundredTwelve;
+
+	// Width and height of the mask when Resolution is Custom, up to 16384
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe", meta = (EditCondition = "Resolution == EMaskResolutions::Custom", EditConditionHides, ClampMin = "1", ClampMax = "16384"))
+	FIntPoint CustomResolution = FIntPoint(512, 512);
+
+	/*
+	Mask built by this recipe. Rebuilds update it in place.
+	When empty the first build creates it next to the recipe, named after it with a _Mask suffix.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Recipe")
+	TSoftObjectPtr<UTexture2D> OutputTexture;
+
+	// Smaller copies of the output at the Additional Output Resolutions of the project settings, rebuilt along with it
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mask Recipe")
+	TArray<TSoftObjectPtr<UTexture2D>> ResizedOutputTextures;
+
+	// Hash of the slot settings and resolution when the output was last built
+	UPROPERTY(VisibleAnywhere, Category = "Mask Recipe", AdvancedDisplay)
+	FString BuiltParametersHash;
+
+	/*
+	True if the output is missing or an input or parameter changed since the last build.
+	Loads the input textures.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mask Recipe")
+	bool NeedsRebuild() const;
+
+	/*
+	Rebuilds the output if needed, or always when bForce is set.
+	Returns the running operation, or nothing when the output is already up to date.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Recipe")
+	UMaskToolsAsyncOperation* Rebuild(bool bForce = false);
+
+	/*
+	Rebuilds every outdated recipe of the project in a single batch, followed by a progress notification.
+	Returns the started operations.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Recipe")
+	static TArray<UMaskToolsAsyncOperation*> RebuildAllRecipes(bool bForce = false);
+
+	/*
+	Stores the current input hashes and parameters as built, for an output produced outside the recipe.
+	*/
+	void MarkAsBuilt(UTexture2D* InOutputTexture, TConstArrayView<UTexture2D*> InResizedOutputTextures = {});
+
+	// True if Texture is the output or one of its resized copies, rather than an input
+	bool IsOutput(const UTexture2D* Texture) const;
+
+	// Creates an empty recipe asset, PackageName is made unique if already taken
+	static UMaskRecipe* CreateRecipeAsset(const FString& PackageName);
+
+	TArray<FMaskRecipeSlot*> GetSlots();
+	TArray<const FMaskRecipeSlot*> GetSlots() const;
+
+private:
+	FString ComputeParametersHash() const;
+
+	UFUNCTION()
+	void OnRebuildCompleted(UMaskToolsAsyncOperation* Operation);
+
+	// Hashes the running rebuild was started with, stored once it succeeds
+	TArray<FString> PendingInputHashes;
+	FString PendingParametersHash;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaskToolsAsyncOperation> PendingOperation;
+};
@@ -6,6 +6,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+class FMaskToolsAutoRebuilder;
+
 class FMaskToolsModule : public IModuleInterface
 {
 public:
@@ -16,4 +18,7 @@ public:
 
 	void RegisterSettings();
 	void UnregisterSettings();
+
+private:
+	TUniquePtr<FMaskToolsAutoRebuilder> AutoRebuilder;
 };
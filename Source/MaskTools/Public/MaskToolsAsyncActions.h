@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "MaskToolsBlueprintLibrary.h"
+#include "MaskToolsAsyncActions.generated.h"
+
+class UMaskToolsAsyncOperation;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMaskToolsAsyncActionPin, UMaskToolsAsyncOperation*, Operation);
+
+/**
+ * Latent Blueprint nodes wrapping UMaskToolsBlueprintLibrary, one node per factory function.
+ */
+UCLASS()
+class MASKTOOLS_API UMaskToolsAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintAssignable)
+	FMaskToolsAsyncActionPin OnSucceeded;
+
+	UPROPERTY(BlueprintAssignable)
+	FMaskToolsAsyncActionPin OnFailed;
+
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Pack Textures Async"))
+	static UMaskToolsAsyncAction* PackTexturesAsync(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue, const FMaskPackSlot& Alpha, int32 Resolution, const FString& PackageName);
+
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Split Texture Async"))
+	static UMaskToolsAsyncAction* SplitTextureAsync(UTexture2D* Texture, bool bDiscardEmptyChannels = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Compute Channel Stats Async"))
+	static UMaskToolsAsyncAction* ComputeChannelStatsAsync(UTexture2D* Texture);
+
+	virtual void Activate() override;
+
+private:
+	UFUNCTION()
+	void HandleOperationCompleted(UMaskToolsAsyncOperation* CompletedOperation);
+
+	// Operations are started lazily on Activate so the node output pins are bound first
+	TUniqueFunction<UMaskToolsAsyncOperation*()> StartOperation;
+
+	UPROPERTY()
+	TObjectPtr<UMaskToolsAsyncOperation> Operation;
+};
@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Engine/Texture.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsPipeline.h"
+#include "MaskToolsUtils.h"
+#include "MaskToolsAsyncOperation.generated.h"
+
+class FMaskToolsProgress;
+class UMaskToolsAsyncOperation;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMaskToolsOperationCompleted, UMaskToolsAsyncOperation*, Operation);
+
+UENUM(BlueprintType)
+enum class EMaskToolsOperationState : uint8
+{
+	Running UMETA(DisplayName = "Running"),
+	Succeeded UMETA(DisplayName = "Succeeded"),
+	Failed UMETA(DisplayName = "Failed")
+};
+
+/**
+ * Texture computed on a worker thread, turned into an asset once back on the game thread.
+ */
+struct FMaskToolsPendingTexture
+{
+	FString PackageName;
+	FImage Image;
+	// Mips built by the worker, empty to let the engine generate them
+	TArray<FImage> Mips;
+	EMaskBlockFormat BlockFormat = EMaskBlockFormat::BC3;
+	// Texture whose LOD and streaming settings are copied to the new asset, must be one of the operation inputs
+	UTexture2D* SettingsSource = nullptr;
+	// When set it is written in place instead of the texture at PackageName, must be one of the operation inputs
+	UTexture2D* ExistingTexture = nullptr;
+};
+
+/**
+ * Everything a worker produces, only read by the game thread after the worker finished.
+ */
+struct FMaskToolsOperationResult
+{
+	TArray<FMaskToolsPendingTexture> Textures;
+	// Image files written by the worker itself
+	TArray<FString> Files;
+	TArray<FMaskChannelStats> ChannelStats;
+	FString ErrorMessage;
+};
+
+/**
+ * Handle returned by the scriptable API. The pixel work runs on the thread pool,
+ * assets are created on the game thread when it finishes or when WaitForCompletion is called.
+ */
+UCLASS(BlueprintType)
+class MASKTOOLS_API UMaskToolsAsyncOperation : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	using FWorkerFunction = TUniqueFunction<bool(FMaskToolsOperationResult&)>;
+
+	/*
+	Runs Worker on the thread pool. The operation keeps itself and its inputs alive until finished.
+	While an FMaskToolsOperationBatch is collecting, the worker is queued in the batch instead,
+	and Description, such as "Packing T_Mask", is shown as the batch status while it runs.
+	*/
+	void Start(const TArray<UTexture2D*>& Inputs, FWorkerFunction&& Worker, const FString& InDescription = FString());
+
+	UPROPERTY(BlueprintAssignable, Category = "Mask Tools")
+	FMaskToolsOperationCompleted OnCompleted;
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	EMaskToolsOperationState GetState() const { return State; }
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	bool IsDone() const { return State != EMaskToolsOperationState::Running; }
+
+	/*
+	Blocks until the worker finishes and creates the resulting assets. Game thread only.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	void WaitForCompletion();
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	TArray<UTexture2D*> GetOutputTextures() const { return OutputTextures; }
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	TArray<FString> GetOutputFiles() const { return OutputFiles; }
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	TArray<FMaskChannelStats> GetChannelStats() const { return ChannelStats; }
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	FString GetErrorMessage() const { return ErrorMessage; }
+
+	/*
+	Highest growth of the editor working set while the operation ran, in bytes. 0 until done,
+	and for operations run in a batch, which logs a single summary.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	int64 GetPeakMemoryBytes() const { return PeakMemoryBytes; }
+
+	UFUNCTION(BlueprintPure, Category = "Mask Tools")
+	float GetElapsedSeconds() const { return ElapsedSeconds; }
+
+private:
+	friend class FMaskToolsOperationBatch;
+
+	void FinishOnGameThread();
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTexture2D>> InputTextures;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTexture2D>> OutputTextures;
+
+	TArray<FString> OutputFiles;
+
+	UPROPERTY()
+	TArray<FMaskChannelStats> ChannelStats;
+
+	FString ErrorMessage;
+
+	int64 PeakMemoryBytes = 0;
+	float ElapsedSeconds = 0.f;
+	TUniquePtr<FMaskToolsPeakMemoryTracker> MemoryTracker;
+
+	EMaskToolsOperationState State = EMaskToolsOperationState::Running;
+
+	TFuture<bool> WorkerFuture;
+	FMaskToolsOperationResult Result;
+	bool bWorkerSucceeded = false;
+
+	// Worker queued in a batch, and the pipeline running it
+	FString Description;
+	FWorkerFunction BatchWorker;
+	TWeakPtr<FMaskToolsPipeline, ESPMode::ThreadSafe> BatchPipeline;
+};
+
+/**
+ * Collects the operations started while it is in scope and runs them through a single pipeline,
+ * so a batch shares the thread pool, the in flight limit and one memory tracker instead of one task each.
+ * Game thread only. Operations still collecting when the batch is destroyed are run then.
+ */
+class MASKTOOLS_API FMaskToolsOperationBatch
+{
+public:
+	explicit FMaskToolsOperationBatch(const FString& InName);
+	~FMaskToolsOperationBatch();
+
+	FMaskToolsOperationBatch(const FMaskToolsOperationBatch&) = delete;
+	FMaskToolsOperationBatch& operator=(const FMaskToolsOperationBatch&) = delete;
+
+	int32 Num() const { return Operations.Num(); }
+
+	/*
+	Stops collecting and starts the pipeline. Operations not run because Progress was cancelled fail.
+	OnCompleted runs on the game thread with the number of operations that succeeded.
+	*/
+	void Run(TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> Progress = nullptr, TFunction<void(int32)> OnCompleted = nullptr);
+
+	/*
+	Runs the batch with a progress notification titled Title, which cancels it and reports the operations that failed.
+	Nothing is shown when no operation was collected.
+	*/
+	void RunWithNotification(const FText& Title, TFunction<void(int32)> OnCompleted = nullptr);
+
+private:
+	friend class UMaskToolsAsyncOperation;
+
+	static FMaskToolsOperationBatch* Current;
+
+	const FString Name;
+	TArray<UMaskToolsAsyncOperation*> Operations;
+	bool bRun = false;
+};
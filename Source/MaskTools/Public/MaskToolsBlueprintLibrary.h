@@ -0,0 +1,106 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "MaskToolsEnums.h"
+#include "MaskToolsBlueprintLibrary.generated.h"
+
+class UMaskToolsAsyncOperation;
+class UTexture2D;
+
+/**
+ * One input of a packed mask.
+ */
+USTRUCT(BlueprintType)
+struct MASKTOOLS_API FMaskPackSlot
+{
+	GENERATED_BODY()
+
+	// Leave empty to fill the channel with black, or white for alpha
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Tools")
+	TObjectPtr<UTexture2D> Texture = nullptr;
+
+	// Channel of Texture copied into the packed mask
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Tools")
+	EMaskTextureChannel SourceChannel = EMaskTextureChannel::Red;
+
+	// Default uses the mixer resize method from the project settings
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Tools")
+	EResizeMethod ResizeMethod = EResizeMethod::Default;
+
+	// Wrap for tiling textures, so the resized channel stays seamless
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Tools")
+	EMaskEdgeMode EdgeMode = EMaskEdgeMode::Clamp;
+
+	// How the values of Texture are encoded, sRGB ones are decoded to linear before packing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mask Tools")
+	EMaskColorSpace ColorSpace = EMaskColorSpace::FromTexture;
+};
+
+/**
+ * Scriptable entry points to the mask tools. Every function returns immediately with a handle,
+ * pixel work runs on worker threads and the resulting assets are created on the game thread.
+ */
+UCLASS()
+class MASKTOOLS_API UMaskToolsBlueprintLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/*
+	Packs up to four textures into the RGBA channels of a new mask saved at PackageName.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	static UMaskToolsAsyncOperation* PackTextures(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue, const FMaskPackSlot& Alpha, int32 Resolution, const FString& PackageName);
+
+	/*
+	Packs up to four textures into a mask of any width and height up to 16384, such as 2:1 trim sheets.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	static UMaskToolsAsyncOperation* PackTexturesToSize(const FMaskPackSlot& Red, const FMaskPackSlot& Green, const FMaskPackSlot& Blue, const FMaskPackSlot& Alpha, int32 SizeX, int32 SizeY, const FString& PackageName);
+
+	/*
+	Splits every channel of Texture into a grayscale texture next to it, suffixed _R, _G, _B and _A.
+	Channels identical to a previous one are only exported once if SkipDuplicateChannels is set.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	static UMaskToolsAsyncOperation* SplitTexture(UTexture2D* Texture, bool bDiscardEmptyChannels = true);
+
+	/*
+	Splits every channel of Texture into an image file in Directory, named after the texture and suffixed _R, _G, _B and _A.
+	No asset is created, the encoding runs on worker threads. The written files are listed by GetOutputFiles.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	static UMaskToolsAsyncOperation* SplitTextureToFiles(UTexture2D* Texture, const FString& Directory, EMaskFileFormat Format = EMaskFileFormat::PNG8, bool bDiscardEmptyChannels = true);
+
+	/*
+	Computes min, max and mean of every channel of Texture, in RGBA order, and which channels duplicate another.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mask Tools")
+	static UMaskToolsAsyncOperation* ComputeChannelStats(UTexture2D* Texture);
+
+	/*
+	Packs Slots in RGBA order. When ExistingTexture is set its source is replaced instead of creating a new asset.
+	A copy is also written for each of ResizedSizes, named with GetResizedOutputName and written after the mask in the same order.
+	ExistingResizedTextures, when given, holds the copy to update for each size.
+	*/
+	static UMaskToolsAsyncOperation* StartPack(const TArray<FMaskPackSlot>& Slots, FIntPoint Size, const FString& PackageName, UTexture2D* ExistingTexture = nullptr,
+		const TArray<FIntPoint>& ResizedSizes = {}, const TArray<UTexture2D*>& ExistingResizedTextures = {});
+
+	/*
+	Splits Texture in RGBA order at its built size with the splitter resize method, edge mode and additional resolutions, as the texture splitter does.
+	Each channel is followed by its resized copies. When ExistingOutputs is not empty only the channels with an existing output are written,
+	replacing their source and that of their copies in place. When FileDirectory is set the channels are written there as image files instead of assets.
+	*/
+	static UMaskToolsAsyncOperation* StartSplit(UTexture2D* Texture, bool bDiscardEmptyChannels, const TArray<UTexture2D*>& ExistingOutputs = {},
+		const FString& FileDirectory = FString(), EMaskFileFormat FileFormat = EMaskFileFormat::PNG8);
+
+	/*
+	Split outputs already saved next to Texture, in RGBA order, null where a channel has none or where the texture was not written by the mask tools.
+	*/
+	static TArray<UTexture2D*> FindSplitOutputs(UTexture2D* Texture);
+};
@@ -21,6 +21,22 @@ class MASKTOOLS_API UMaskToolsConfig : public UObject
 public:
 	UMaskToolsConfig();
 
+	// Pushes the cache settings to the disk cache
+	void ApplyDiskCacheSettings() const;
+
+	bool ExportsAssets() const { return ExportTarget != EMaskExportTarget::ImageFile; }
+	bool ExportsImageFiles() const { return ExportTarget != EMaskExportTarget::Asset; }
+
+	// Folder image files are written to, resolved to a full path
+	FString GetImageFileDirectory() const;
+
+	// Bytes the textures split at once may hold together
+	int64 GetMemoryBudget() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	/*
 	Sample
 	*/
@@ -63,7 +79,7 @@ public:
 	Default resolution masks will be exported if not changed.
 	Default is 512
 	*/
-	UPROPERTY(EditAnywhere, config, Category = "Texture Mixer")
+	UPROPERTY(EditAnywhere, config, Category = "Texture Mixer", meta = (InvalidEnumValues = "Custom"))
 	EMaskResolutions DefaultMaskResolution;
 
 	/*
@@ -78,6 +94,109 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Texture Mixer")
 	bool bDefaultAddSuffix;
 
+	/*
+	Saves a mask recipe next to every exported mask, recording its inputs so it can be rebuilt when they change.
+	Default is true
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Texture Mixer")
+	bool bSaveMaskRecipes;
+
+	/*
+	Writes into the existing texture when an output with the same name already exists and was written by the mask tools,
+	instead of creating a numbered copy. Its compression settings are kept as they are.
+	The texture is left untouched, not even marked dirty, when it already holds the same pixels.
+	Default is true
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outputs")
+	bool bUpdateOutputsInPlace;
+
+	/*
+	Stores each new packed mask with the cheapest compression that keeps its channels: grayscale when green and blue are 0
+	and alpha opaque, DXT1 when alpha is fully opaque, BC7 when all four channels carry data and DXT5 otherwise.
+	Masks sampled with a Masks sampler may need their sampler type updated. Outputs updated in place keep their compression.
+	Default is false
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outputs")
+	bool bChooseCompressionFromChannels;
+
+	/*
+	Precision channels are packed and split with, for height, displacement or distance field data. Outputs are then stored uncompressed:
+	16 bit as G16 for single channels and RGBA32F for masks, which keep every value exact,
+	float as R16F for single channels and RGBA16F for masks, which round to half float.
+	Default is 8 bit
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outputs")
+	EMaskPrecision MaskPrecision;
+
+	/*
+	Smaller copies written along with every mixer export and split, named after the output with a _<size> suffix, such as _1024.
+	Each size is the longest side of the copy, which keeps the aspect ratio of the output. Sizes not smaller than the output are skipped.
+	Copies are resized from the same decoded channels as the output, each from the previous size, so they add little to its cost.
+	Default is none
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outputs", meta = (InvalidEnumValues = "Custom"))
+	TArray<EMaskResolutions> AdditionalOutputResolutions;
+
+	/*
+	Builds the mips of masks and split channels in the plugin, channel by channel with the filters below, and stores them
+	in the texture source with Leave Existing Mips. Disable to let the engine average every channel.
+	Values are reduced as stored, sRGB split channels are not decoded first.
+	Default is false
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips")
+	bool bGenerateMipsPerChannel;
+
+	/*
+	Mip filter of the red channel of masks, and of channels split from red.
+	Default is Average
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips", meta = (EditCondition = "bGenerateMipsPerChannel"))
+	EMaskMipFilter RedMipFilter;
+
+	/*
+	Mip filter of the green channel of masks, and of channels split from green.
+	Default is Average
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips", meta = (EditCondition = "bGenerateMipsPerChannel"))
+	EMaskMipFilter GreenMipFilter;
+
+	/*
+	Mip filter of the blue channel of masks, and of channels split from blue.
+	Default is Average
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips", meta = (EditCondition = "bGenerateMipsPerChannel"))
+	EMaskMipFilter BlueMipFilter;
+
+	/*
+	Mip filter of the alpha channel of masks, and of channels split from alpha.
+	Default is Average
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips", meta = (EditCondition = "bGenerateMipsPerChannel"))
+	EMaskMipFilter AlphaMipFilter;
+
+	/*
+	Alpha test reference the Coverage Preserving filter keeps the coverage of, usually the opacity mask clip value of the material.
+	Default is 0.5
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Mips", meta = (EditCondition = "bGenerateMipsPerChannel", ClampMin = "0.0", ClampMax = "1.0"))
+	float MipCoverageThreshold;
+
+	/*
+	How the values of the mixer and splitter inputs are encoded. sRGB inputs are decoded to linear before packing.
+	Pack slots left on From Texture follow this setting. Image files are read as linear unless this is sRGB.
+	Default is From Texture
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Color Space")
+	EMaskColorSpace InputColorSpace;
+
+	/*
+	Encoding of split channels. From Texture keeps the encoding of the source, so splitting never alters its values.
+	Only 8 bit channels can be stored as sRGB, wider ones are always linear. Packed masks are always linear.
+	Default is From Texture
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Color Space")
+	EMaskColorSpace SplitColorSpace;
+
 	/*
 	Sample
 	*/
@@ -90,10 +209,136 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Texture Splitter")
 	EResizeMethod SplitterResizeMethod;
 
+	/*
+	What resizing reads past the edges of split textures, Wrap keeps tiling textures seamless.
+	Default is Clamp
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Texture Splitter")
+	EMaskEdgeMode SplitterEdgeMode;
+
 	/*
 	Defines if Split Channels will attempt to search for completely black channels in splitted textures
 	and will avoid try to export them
 	*/
 	UPROPERTY(EditAnywhere, config, Category = "Texture Splitter")
 	bool bDiscardEmptyChannels;
+
+	/*
+	Exports a channel holding exactly the same values as a previous one only once, as in grayscale textures stored as RGB.
+	Default is true
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Texture Splitter")
+	bool bSkipDuplicateChannels;
+
+	/*
+	Leaves a redirector to the first identical channel in place of each skipped duplicate, so its name still resolves.
+	An output an earlier split wrote for that channel is replaced by the redirector, its references moved to the first channel.
+	Otherwise such a stale output is deleted when nothing references it.
+	Default is false
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Texture Splitter", meta = (EditCondition = "bSkipDuplicateChannels"))
+	bool bRedirectDuplicateChannels;
+
+	/*
+	Regenerates the mask recipes and split outputs that use a texture when it is imported or reimported.
+	Default is true
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Auto Rebuild")
+	bool bAutoRebuildOnReimport;
+
+	/*
+	Seconds without new imports before the dependent masks are regenerated, so a burst is handled in one batch.
+	Default is 2
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Auto Rebuild", meta = (ClampMin = "0", EditCondition = "bAutoRebuildOnReimport"))
+	float AutoRebuildDelay;
+
+	/*
+	Whether the mixer export and the splitter create texture assets, image files on disk, or both.
+	Default is Texture Asset
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Image Files")
+	EMaskExportTarget ExportTarget;
+
+	/*
+	File format and bit depth of exported image files.
+	Default is PNG 8 bit
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Image Files", meta = (EditCondition = "ExportTarget != EMaskExportTarget::Asset"))
+	EMaskFileFormat ImageFileFormat;
+
+	/*
+	Folder image files are written to, mirroring the content folders of the assets they come from.
+	Default is Saved/MaskTools/Export when empty
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Image Files", meta = (EditCondition = "ExportTarget != EMaskExportTarget::Asset"))
+	FDirectoryPath ImageFileDirectory;
+
+	/*
+	Keeps the decoded and resized channels in Saved/MaskToolsCache, so repeating an operation on unchanged sources skips the decode.
+	Default is true
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Cache")
+	bool bEnableDiskCache;
+
+	/*
+	Size the cache folder may grow to before the least recently used entries are deleted, in megabytes.
+	Default is 2048
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Cache", meta = (ClampMin = "0", EditCondition = "bEnableDiskCache"))
+	int32 DiskCacheMaxSizeMB;
+
+	/*
+	Memory the textures of a batch split may hold at once, in megabytes. Each texture is estimated from its size, format, mips and additional resolutions,
+	and fewer textures are split in parallel when large ones would go over it. 0 uses half of the physical memory.
+	Default is 0
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "0"))
+	int32 MemoryBudgetMB;
+
+	/*
+	Textures a batch split or rebuild works on at once, each holding its source image and channel planes.
+	The memory budget can lower it further for large sources.
+	Default is 4
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxTexturesInFlight;
+
+	/*
+	Decodes and resizes the channels of a pixel data split in separate MaskToolsWorker processes, so a decode that crashes
+	or runs out of memory only skips its texture. Sources are still loaded and outputs still created in the editor.
+	Requires building the MaskToolsWorker program target.
+	Default is false
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance")
+	bool bUseWorkerProcesses;
+
+	/*
+	Worker processes a split may run at once.
+	Default is 2
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "1", EditCondition = "bUseWorkerProcesses"))
+	int32 NumWorkerProcesses;
+
+	/*
+	Seconds a worker process may spend on one texture before it is terminated and the texture skipped. 0 waits forever.
+	Default is 300
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "0", EditCondition = "bUseWorkerProcesses"))
+	int32 WorkerTaskTimeoutSeconds;
+
+	/*
+	Percentage a benchmark timing may grow over its baseline before MaskTools.Perf fails.
+	Can be overridden with -MaskToolsPerfThreshold=
+	Default is 10
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "0"))
+	float PerfTimeRegressionThreshold;
+
+	/*
+	Percentage the benchmark peak memory may grow over its baseline before MaskTools.Perf fails.
+	Default is 10
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "0"))
+	float PerfMemoryRegressionThreshold;
 };
@@ -12,6 +12,15 @@ enum class EMaskCreationMethod : uint8
 	Material = 1 UMETA(DisplayName = "Material Based")
 };
 
+UENUM(BlueprintType)
+enum class EMaskTextureChannel : uint8
+{
+	Red UMETA(DisplayName = "Red"),
+	Green UMETA(DisplayName = "Green"),
+	Blue UMETA(DisplayName = "Blue"),
+	Alpha UMETA(DisplayName = "Alpha")
+};
+
 UENUM()
 enum class EMaskResolutions : uint8
 {
@@ -23,11 +32,15 @@ enum class EMaskResolutions : uint8
 	OneThousandTwentyFour UMETA(DisplayName = "1024"),
 	TwoThousandFortyEight UMETA(DisplayName = "2048"),
 	FourThousandNinetySix UMETA(DisplayName = "4096"),
-	EightThousandOneHundredNinetyTwo UMETA(DisplayName = "8192")
+	EightThousandOneHundredNinetyTwo UMETA(DisplayName = "8192"),
+	SixteenThousandThreeHundredEightyFour UMETA(DisplayName = "16384"),
+	// Any width and height, set next to the resolution
+	Custom UMETA(DisplayName = "Custom")
 };
 
-UENUM()
-enum class EResizeMethod : uint32
+// uint8 so Blueprints can use it, the wrap flags still fit
+UENUM(BlueprintType)
+enum class EResizeMethod : uint8
 {
 	Default = 0, // uses a good default filter; = AdaptiveSharp
 	PointSample,
@@ -40,7 +53,62 @@ enum class EResizeMethod : uint32
 	AdaptiveSharp,  // sharper adaptive filter; uses CubicSharp for upsample and CubicMitchell for downsample, nop for same size
 	AdaptiveSmooth,  // smoother adaptive filter; uses CubicMitchell for upsample and CubicGaussian for downsample, nop for same size
 
-	WithoutFlagsMask = 63,
-	Flag_WrapX = 64,  // default edge mode is clamp; set these to wrap instead
-	Flag_WrapY = 128
+	WithoutFlagsMask = 63 UMETA(Hidden),
+	Flag_WrapX = 64 UMETA(Hidden),  // default edge mode is clamp; set these to wrap instead
+	Flag_WrapY = 128 UMETA(Hidden)
+};
+
+/*
+* What resizing reads past the edges of a texture, combined with a resize method into its wrap flags.
+*/
+UENUM(BlueprintType)
+enum class EMaskEdgeMode : uint8
+{
+	Clamp UMETA(DisplayName = "Clamp"),
+	WrapX UMETA(DisplayName = "Wrap Horizontally"),
+	WrapY UMETA(DisplayName = "Wrap Vertically"),
+	// Tiling textures, seamless once resized
+	Wrap UMETA(DisplayName = "Wrap")
+};
+
+UENUM(BlueprintType)
+enum class EMaskFileFormat : uint8
+{
+	PNG8 UMETA(DisplayName = "PNG 8 bit"),
+	PNG16 UMETA(DisplayName = "PNG 16 bit"),
+	TGA UMETA(DisplayName = "TGA"),
+	EXR UMETA(DisplayName = "EXR half float")
+};
+
+UENUM(BlueprintType)
+enum class EMaskPrecision : uint8
+{
+	EightBit UMETA(DisplayName = "8 bit"),
+	SixteenBit UMETA(DisplayName = "16 bit"),
+	Float UMETA(DisplayName = "Float", ToolTip = "Processed as 32 bit float, stored as half float")
+};
+
+UENUM(BlueprintType)
+enum class EMaskColorSpace : uint8
+{
+	FromTexture UMETA(DisplayName = "From Texture", ToolTip = "Follows the sRGB setting of the texture. Image files are read as linear data"),
+	Linear UMETA(DisplayName = "Linear"),
+	SRGB UMETA(DisplayName = "sRGB")
+};
+
+UENUM(BlueprintType)
+enum class EMaskMipFilter : uint8
+{
+	Average UMETA(DisplayName = "Average", ToolTip = "Averages every 2x2 block, as the engine does"),
+	Max UMETA(DisplayName = "Max", ToolTip = "Keeps thin bright features such as foliage opacity"),
+	Min UMETA(DisplayName = "Min", ToolTip = "Keeps thin dark features such as cavity"),
+	Coverage UMETA(DisplayName = "Coverage Preserving", ToolTip = "Keeps the share of texels over the coverage threshold, for alpha tested masks")
+};
+
+UENUM()
+enum class EMaskExportTarget : uint8
+{
+	Asset UMETA(DisplayName = "Texture Asset"),
+	ImageFile UMETA(DisplayName = "Image File"),
+	AssetAndImageFile UMETA(DisplayName = "Texture Asset and Image File")
 };
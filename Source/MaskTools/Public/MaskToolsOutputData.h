@@ -0,0 +1,31 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "MaskToolsOutputData.generated.h"
+
+/**
+ * Attached to the textures written by the mask tools, records what was last written
+ * so an identical rewrite can be skipped without decoding the texture source.
+ * Its presence is also what allows an output to be updated in place. Editor only, stripped on cook.
+ */
+UCLASS()
+class MASKTOOLS_API UMaskToolsOutputData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool IsEditorOnly() const override { return true; }
+
+	// Hash of the pixels and compression settings last written
+	UPROPERTY(VisibleAnywhere, Category = "Mask Tools")
+	FString ContentHash;
+
+	// Source id right after that write, a different id means the texture was edited by something else since
+	UPROPERTY(VisibleAnywhere, Category = "Mask Tools")
+	FGuid SourceId;
+};
@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FMaskToolsProgress;
+class SNotificationItem;
+
+/**
+ * Non modal notification following the progress of a batch, with a Cancel button that cancels it and then hides.
+ * Refreshed from the core ticker, so the progress can be updated from any thread. Game thread only.
+ */
+class MASKTOOLS_API FMaskToolsProgressNotification : public TSharedFromThis<FMaskToolsProgressNotification>
+{
+public:
+    // Title names the batch, such as "Splitting textures"
+    static TSharedRef<FMaskToolsProgressNotification> Open(const FText& InTitle, const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& InProgress);
+
+    ~FMaskToolsProgressNotification();
+
+    // Shows the batch as cancelled if it was, otherwise as succeeded when NumFailed is 0, and fades out
+    void Close(int32 NumFailed);
+
+private:
+    FMaskToolsProgressNotification(const FText& InTitle, const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe>& InProgress);
+
+    bool Tick(float DeltaTime);
+    void OnCancelClicked();
+    FText GetProgressText() const;
+
+    const FText Title;
+    const TSharedRef<FMaskToolsProgress, ESPMode::ThreadSafe> Progress;
+    TWeakPtr<SNotificationItem> Item;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -5,9 +5,47 @@
 
 #include "CoreMinimal.h"
 #include "ImageCore.h"
+#include "MaskPlane.h"
+#include "MaskToolsImageFiles.h"
 #include "MaskToolsEnums.h"
 #include "MaskToolsUtils.generated.h"
 
+class FMaskToolsProgress;
+
+class UObjectRedirector;
+
+/**
+ * Summary of the values stored in a single channel, normalized to 0-1.
+ */
+USTRUCT(BlueprintType)
+struct MASKTOOLS_API FMaskChannelStats
+{
+    GENERATED_BODY()
+
+    FMaskChannelStats() = default;
+    explicit FMaskChannelStats(const FMaskPlaneStats& PlaneStats);
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    float Min = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    float Max = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    float Mean = 0.f;
+
+    // True if at least one value is neither fully black nor fully white
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    bool bHasData = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    bool bIsConstant = true;
+
+    // Earlier channel, in RGBA order, holding exactly the same values. -1 if this channel is unique
+    UPROPERTY(BlueprintReadOnly, Category = "Mask Tools")
+    int32 DuplicateOfChannel = INDEX_NONE;
+};
+
 /**
  * 
  */
@@ -17,24 +55,211 @@ struct MASKTOOLS_API FMaskToolsUtils
 
     GENERATED_BODY()
     
-    static void ForceTextureCompilation(UTexture2D* Texture);
+    /*
+    * Waits for the texture to finish compiling. Progress, when given, reports which texture is waited for.
+    */
+    static void ForceTextureCompilation(UTexture2D* Texture, FMaskToolsProgress* Progress = nullptr);
 
     static TArray<UTexture2D*> SyncronousLoadCBTextures(TArray<FAssetData>& LoadedAssetData);
     
-    static UTexture2D* LoadTextureFromAssetData(const FAssetData& AssetData);
+    static UTexture2D* LoadTextureFromAssetData(const FAssetData& AssetData, FMaskToolsProgress* Progress = nullptr);
 
     static FString GetCleanPathName(UObject* OuterObject);
 
-    static bool GetTexturePixelData(UTexture2D* Texture, int32 DestinationSize, EResizeMethod ResizeMethod, TArray<FLinearColor>& OutData);
-
     static UTexture2D* CreateStaticTextureEditorOnly(UTexture2D* TransientTexture, FString InName, TextureCompressionSettings InCompressionSettings, TextureMipGenSettings InMipSettings);
 
+    /*
+    * Copies the LOD, streaming and cook settings of a source texture to a generated one.
+    * Must be wrapped in PreEditChange / PostEditChange by the caller.
+    */
+    static void CopyTextureSettings(const UTexture2D* SourceTexture, UTexture2D* DestinationTexture);
+
+    /*
+    * Copies the best available top mip of a texture. Game thread only.
+    */
+    static bool GetTextureSourceImage(UTexture2D* Texture, FImage& OutImage);
+
+    /*
+    * Creates a transient texture whose source is a copy of Image, sRGB when Image is.
+    * Mips, in the format of Image, are stored after it as the rest of the source mip chain.
+    */
+    static UTexture2D* CreateTransientTexture(const FImageView& Image, TextureCompressionSettings InCompressionSettings, TextureMipGenSettings InMipSettings,
+        bool bCompressionNoAlpha = false, TConstArrayView<FImage> Mips = {});
+
+    /*
+    * Replaces the source of an existing texture asset with Image and marks its package dirty.
+    * The compression settings of the texture are kept as the user set them. sRGB follows the encoding of Image,
+    * since it decides how the new pixels are read. Virtual texture streaming is left as is, with a warning when Image is over 8192.
+    * Given Mips are kept with Leave Existing Mips, without them the mip settings of the texture are left as they are.
+    */
+    static void UpdateTextureSource(UTexture2D* Texture, const FImageView& Image, TConstArrayView<FImage> Mips = {});
+
+    /*
+    * Identifies the source art of a texture, changes whenever it is reimported or edited. Empty without source.
+    */
+    static FString GetTextureContentHash(const UTexture2D* Texture);
+
+    /*
+    * Hash of the pixels of an image, their encoding and the compression they are stored with.
+    */
+    static FString GetImageContentHash(const FImageView& Image, TextureCompressionSettings InCompressionSettings, bool bCompressionNoAlpha = false,
+        TConstArrayView<FImage> Mips = {});
+
+    /*
+    * Texture asset saved at PackageName, if any. Loads it.
+    */
+    static UTexture2D* FindTextureAsset(const FString& PackageName);
+
+    /*
+    * Writes Image to ExistingTexture when given, otherwise to the texture at PackageName if UpdateOutputsInPlace is set
+    * and that texture was written by the mask tools, otherwise to a new uniquely named asset copying the settings of SettingsSource.
+    * An existing texture keeps its compression settings, BlockFormat only applies to new assets.
+    * A texture that already holds the same pixels is returned as is, bOutUnchanged tells when that happened.
+    * Mips built by the plugin are stored along with Image instead of letting the engine generate them.
+    */
+    static UTexture2D* WriteOutputTexture(const FImageView& Image, const FString& PackageName, EMaskBlockFormat BlockFormat,
+        const UTexture2D* SettingsSource = nullptr, UTexture2D* ExistingTexture = nullptr, bool* bOutUnchanged = nullptr, TConstArrayView<FImage> Mips = {});
+
+    /*
+    * Bytes splitting the texture of AssetData into Format planes is expected to hold at its peak, mips and the copies
+    * at AdditionalOutputResolutions included. Read from the texture source when loaded, otherwise from the registry
+    * dimensions as a 16 bit RGBA source, so the texture is not loaded just to be estimated. 0 when the size is unknown.
+    */
+    static int64 EstimateSplitMemory(const FAssetData& AssetData, EMaskPlaneFormat Format, bool bWithMips = false,
+        TConstArrayView<EMaskResolutions> AdditionalOutputResolutions = {});
+
+    /*
+    * Image file an output saved at PackageName is exported to, under the configured folder.
+    */
+    static FString GetImageFilePath(const FString& PackageName);
+
+    /*
+    * Creates a redirector at PackageName pointing to Destination, or returns the one already there.
+    * Fails if another asset already exists there.
+    */
+    static UObjectRedirector* CreateRedirector(const FString& PackageName, UObject* Destination);
+
+    /*
+    * Handles the output name of a duplicate channel that is not exported. An output an earlier split wrote there is stale:
+    * with bRedirect its references are moved to Original and it becomes a redirector, otherwise it is deleted unless
+    * something still references it. Textures not written by the mask tools are left alone.
+    */
+    static void ReplaceDuplicateOutput(const FString& PackageName, UTexture2D* Original, bool bRedirect);
+
+    /*
+    * Logs the channels of a split texture that duplicate another one, and whether the texture is grayscale stored as RGB.
+    */
+    static void ReportDuplicateChannels(const UTexture2D* Texture, TConstArrayView<int32> DuplicateOf);
+
+    /*
+    * Disk cache key of one channel of a texture read as SourceGamma, resized to SizeX by SizeY and stored as Format in Gamma.
+    * Empty if the texture has no source, which disables the cache for it.
+    */
+    static FString GetPlaneCacheKey(const UTexture2D* Texture, EMaskChannel Channel, int32 SizeX, int32 SizeY,
+        EResizeMethod ResizeMethod, EMaskPlaneFormat Format, EGammaSpace Gamma, EGammaSpace SourceGamma);
+
+};
+
+/**
+ * Per channel mip generation, copied from the project settings on the game thread for the workers.
+ */
+struct FMaskMipSettings
+{
+    bool bEnabled = false;
+    // In RGBA order
+    EMaskMipReduction Reductions[4] = { EMaskMipReduction::Average, EMaskMipReduction::Average, EMaskMipReduction::Average, EMaskMipReduction::Average };
+    float CoverageThreshold = 0.5f;
 };
 
 struct MASKTOOLS_API FMaskToolsPrivateHelpers
 {
+    // Keeps the wrap flags of Method along with its filter
     static FImageCore::EResizeImageFilter FindResizeMethod(EResizeMethod Method);
 
+    // Method with the wrap flags of EdgeMode added
+    static EResizeMethod CombineResizeMethod(EResizeMethod Method, EMaskEdgeMode EdgeMode);
+
+    // Replaces a Default filter with the one of DefaultMethod, the wrap flags of both are kept
+    static EResizeMethod ResolveResizeMethod(EResizeMethod Method, EResizeMethod DefaultMethod);
+
+    // Filter of Method without its wrap flags
+    static EResizeMethod FindBaseResizeMethod(EResizeMethod Method);
+
+    static EMaskEdgeMode FindEdgeMode(EResizeMethod Method);
+
+    static EMaskChannel FindMaskChannel(EMaskTextureChannel Channel);
+
+    static EMaskImageFileFormat FindImageFileFormat(EMaskFileFormat Format);
+
+    static TextureCompressionSettings FindCompressionSettings(EMaskBlockFormat Format, bool& bOutCompressionNoAlpha);
+
+    /*
+    * Block format of a packed mask from the stats of its channels in RGBA order and their storage.
+    * Without bChooseFromChannels, BC3 for 8 bit masks, RGBA32F for 16 bit and RGBA16F for float.
+    */
+    static EMaskBlockFormat FindMaskBlockFormat(TArrayView<const FMaskPlaneStats> ChannelStats, EMaskPlaneFormat Format, bool bChooseFromChannels);
+
+    static EMaskPlaneFormat FindPlaneFormat(EMaskPrecision Precision);
+
+    static EMaskMipReduction FindMipReduction(EMaskMipFilter Filter);
+
+    // Mip settings of the project. Game thread only
+    static FMaskMipSettings FindMipSettings();
+
+    // Gamma space values are encoded in, NativeGammaSpace being the one of the texture or image file
+    static EGammaSpace FindGammaSpace(EMaskColorSpace ColorSpace, EGammaSpace NativeGammaSpace);
+
+    /*
+    * Gamma space of a pack input. A slot left on From Texture follows the project Input Color Space,
+    * which itself falls back to NativeGammaSpace.
+    */
+    static EGammaSpace FindInputGammaSpace(EMaskColorSpace SlotColorSpace, EMaskColorSpace ProjectColorSpace, EGammaSpace NativeGammaSpace);
+
+    // sRGB only for 8 bit sources with sRGB enabled, the engine reads every other source as linear
+    static EGammaSpace FindTextureGammaSpace(const UTexture2D* Texture);
+
+    /*
+    * Gamma spaces a texture is read as and its channels are split to, from the color space project settings.
+    * Game thread only.
+    */
+    static void FindSplitGammaSpaces(const UTexture2D* Texture, EMaskPlaneFormat Format, EGammaSpace& OutSourceGamma, EGammaSpace& OutPlaneGamma);
+
+    // Custom has no size of its own and gives the default 512
+    static int32 FindResolution(EMaskResolutions Resolution);
+
+    // Width and height of a resolution, CustomSize is used for Custom and clamped to the supported sizes
+    static FIntPoint FindResolutionSize(EMaskResolutions Resolution, FIntPoint CustomSize);
+
+    // Resolution matching a square power of two size, Custom for any other size
+    static EMaskResolutions FindMaskResolution(int32 SizeX, int32 SizeY);
+
+    /*
+    * Sizes of the smaller copies of an output of the given size, largest first, one per resolution under its longest side.
+    * Each resolution sets the longest side of its copy, the other side keeps the aspect ratio.
+    */
+    static TArray<FIntPoint> FindAdditionalOutputSizes(FIntPoint Size, TConstArrayView<EMaskResolutions> Resolutions);
+
+    // Name of the copy of the output at PackageName with the given size
+    static FString GetResizedOutputName(const FString& PackageName, FIntPoint Size);
+
+    // True if both sides are within 1 and FMaskPlane::MaxSize
+    static bool IsValidMaskSize(int32 SizeX, int32 SizeY);
+
+    // Outputs over 8192 are streamed as virtual textures, ignored by projects without virtual texturing
+    static bool NeedsVirtualTexture(int32 SizeX, int32 SizeY);
+
     static UMaterialInterface* LoadPluginMaterial(const FString& MaterialName);
+
+    /*
+    * True if Texture already holds the pixels ContentHash was computed from.
+    * Decodes the source only when the texture was not last written by the mask tools.
+    */
+    static bool IsOutputUpToDate(UTexture2D* Texture, const FString& ContentHash);
+
+    /*
+    * True if Texture was written by the mask tools, the only textures they update in place.
+    */
+    static bool IsMaskToolsOutput(UTexture2D* Texture);
+
     
 };
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformProcess.h"
+
+struct FMaskToolsSplitTask;
+struct FMaskToolsSplitResult;
+
+enum class EMaskWorkerTaskResult : uint8
+{
+    Succeeded,
+    // The worker crashed, timed out or could not read the task, the task must not be run in the editor either
+    Failed,
+    // No worker could be started, the caller runs the task itself
+    Unavailable
+};
+
+/**
+ * MaskToolsWorker processes the editor hands split decodes to, so a decode that runs out of memory, crashes or hangs
+ * only fails its own texture. Loading the source and writing the outputs still happen in the editor.
+ * Each worker runs one task at a time with its own thread pool, and is launched on demand up to the configured count.
+ */
+class MASKTOOLS_API FMaskToolsWorkerPool
+{
+public:
+    static FMaskToolsWorkerPool& Get();
+
+    /*
+    * Sets how many workers may run at once and how long one may take per task, 0 for no limit, launching none yet.
+    * Returns false when the worker program was not built. Game thread only.
+    */
+    bool Configure(int32 InMaxWorkers, int32 InTaskTimeoutSeconds = 0);
+
+    /*
+    * Runs Task in an idle worker and blocks until it answers, waiting for one if all are busy.
+    * A worker that does not answer within the task timeout is terminated and the task fails.
+    * Call it from a pool thread, never from the game thread.
+    */
+    EMaskWorkerTaskResult RunSplitTask(const FMaskToolsSplitTask& Task, FMaskToolsSplitResult& OutResult);
+
+    // Asks every worker to quit, terminates those that don't within a second and waits for busy ones to be released
+    void Shutdown();
+
+    // Built into the plugin binaries, or the engine ones as a fallback
+    static FString GetWorkerPath();
+
+private:
+    struct FWorker
+    {
+        FProcHandle Process;
+        FString WorkingDirectory;
+        bool bBusy = false;
+    };
+
+    // Returns an idle worker marked busy, or null when none can be launched
+    TSharedPtr<FWorker, ESPMode::ThreadSafe> AcquireWorker();
+    void ReleaseWorker(const TSharedPtr<FWorker, ESPMode::ThreadSafe>& Worker);
+
+    // Must hold Lock
+    TSharedPtr<FWorker, ESPMode::ThreadSafe> LaunchWorker();
+
+    FCriticalSection Lock;
+    TArray<TSharedPtr<FWorker, ESPMode::ThreadSafe>> Workers;
+    FString WorkerPath;
+    int32 MaxWorkers = 0;
+    double TaskTimeoutSeconds = 0.0;
+    int32 NumLaunched = 0;
+    int32 NextTaskId = 0;
+};
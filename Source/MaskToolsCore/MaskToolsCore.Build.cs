@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+using UnrealBuildTool;
+
+public class MaskToolsCore : ModuleRules
+{
+	public MaskToolsCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"ImageCore"
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"ImageWrapper"
+			}
+			);
+	}
+}
@@ -0,0 +1,6 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "Logging.h"
+
+DEFINE_LOG_CATEGORY(LogMaskToolsCore);
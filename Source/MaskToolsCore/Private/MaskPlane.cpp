@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskPlane.h"
+
+const TCHAR* LexToString(EMaskBlockFormat Format)
+{
+    switch (Format)
+    {
+    case EMaskBlockFormat::BC4:
+        return TEXT("BC4");
+    case EMaskBlockFormat::BC1:
+        return TEXT("BC1");
+    case EMaskBlockFormat::BC3:
+        return TEXT("BC3");
+    case EMaskBlockFormat::BC7:
+        return TEXT("BC7");
+    case EMaskBlockFormat::G16:
+        return TEXT("G16");
+    case EMaskBlockFormat::R16F:
+        return TEXT("R16F");
+    case EMaskBlockFormat::RGBA16F:
+        return TEXT("RGBA16F");
+    case EMaskBlockFormat::RGBA32F:
+        return TEXT("RGBA32F");
+    default:
+        return TEXT("Unknown");
+    }
+}
+
+FMaskPlane::FMaskPlane(int32 InSizeX, int32 InSizeY, EMaskPlaneFormat InFormat)
+{
+    Init(InSizeX, InSizeY, InFormat);
+}
+
+void FMaskPlane::Init(int32 InSizeX, int32 InSizeY, EMaskPlaneFormat InFormat)
+{
+    SizeX = InSizeX;
+    SizeY = InSizeY;
+    Format = InFormat;
+    RawData.Empty();
+    RawData.SetNumUninitialized(GetNumPixels() * GetBytesPerPixel());
+}
+
+int32 FMaskPlane::GetBytesPerPixel(EMaskPlaneFormat InFormat)
+{
+    switch (InFormat)
+    {
+    case EMaskPlaneFormat::U8:
+        return 1;
+    case EMaskPlaneFormat::U16:
+        return 2;
+    case EMaskPlaneFormat::F32:
+        return 4;
+    default:
+        check(false);
+        return 1;
+    }
+}
+
+ERawImageFormat::Type FMaskPlane::GetRawImageFormat(EMaskPlaneFormat InFormat)
+{
+    switch (InFormat)
+    {
+    case EMaskPlaneFormat::U8:
+        return ERawImageFormat::G8;
+    case EMaskPlaneFormat::U16:
+        return ERawImageFormat::G16;
+    case EMaskPlaneFormat::F32:
+        return ERawImageFormat::R32F;
+    default:
+        check(false);
+        return ERawImageFormat::G8;
+    }
+}
+
+TArrayView64<uint8> FMaskPlane::AsU8()
+{
+    check(Format == EMaskPlaneFormat::U8);
+    return TArrayView64<uint8>(RawData.GetData(), GetNumPixels());
+}
+
+TArrayView64<const uint8> FMaskPlane::AsU8() const
+{
+    check(Format == EMaskPlaneFormat::U8);
+    return TArrayView64<const uint8>(RawData.GetData(), GetNumPixels());
+}
+
+TArrayView64<uint16> FMaskPlane::AsU16()
+{
+    check(Format == EMaskPlaneFormat::U16);
+    return TArrayView64<uint16>(reinterpret_cast<uint16*>(RawData.GetData()), GetNumPixels());
+}
+
+TArrayView64<const uint16> FMaskPlane::AsU16() const
+{
+    check(Format == EMaskPlaneFormat::U16);
+    return TArrayView64<const uint16>(reinterpret_cast<const uint16*>(RawData.GetData()), GetNumPixels());
+}
+
+TArrayView64<float> FMaskPlane::AsF32()
+{
+    check(Format == EMaskPlaneFormat::F32);
+    return TArrayView64<float>(reinterpret_cast<float*>(RawData.GetData()), GetNumPixels());
+}
+
+TArrayView64<const float> FMaskPlane::AsF32() const
+{
+    check(Format == EMaskPlaneFormat::F32);
+    return TArrayView64<const float>(reinterpret_cast<const float*>(RawData.GetData()), GetNumPixels());
+}
+
+void FMaskPlane::MoveToImage(FImage& OutImage)
+{
+    OutImage.SizeX = SizeX;
+    OutImage.SizeY = SizeY;
+    OutImage.NumSlices = 1;
+    OutImage.Format = GetRawImageFormat(Format);
+    OutImage.GammaSpace = EGammaSpace::Linear;
+    OutImage.RawData = MoveTemp(RawData);
+
+    SizeX = 0;
+    SizeY = 0;
+}
+
+FImageView FMaskPlane::AsImageView() const
+{
+    return FImageView(const_cast<uint8*>(RawData.GetData()), SizeX, SizeY, 1, GetRawImageFormat(Format), EGammaSpace::Linear);
+}
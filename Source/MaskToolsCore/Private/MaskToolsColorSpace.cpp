@@ -0,0 +1,126 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsColorSpace.h"
+
+#include "Async/ParallelFor.h"
+#include "MaskToolsStats.h"
+
+namespace MaskToolsColorSpace
+{
+    // Values converted by a single task
+    constexpr int64 BlockSize = 64 * 1024;
+
+    template<typename T>
+    TArray<T> BuildTable(float (*Curve)(float))
+    {
+        constexpr int32 MaxValue = TNumericLimits<T>::Max();
+
+        TArray<T> Table;
+        Table.SetNumUninitialized(MaxValue + 1);
+        for (int32 Value = 0; Value <= MaxValue; ++Value)
+        {
+            const float Converted = Curve(static_cast<float>(Value) / MaxValue);
+            Table[Value] = static_cast<T>(FMath::Clamp(FMath::RoundToInt(Converted * MaxValue), 0, MaxValue));
+        }
+        return Table;
+    }
+
+    // Plain indexed loads over contiguous blocks, left for the compiler to unroll
+    template<typename T>
+    void ApplyTable(TArrayView64<T> Values, const T* RESTRICT Table)
+    {
+        const int64 NumValues = Values.Num();
+        const int32 NumBlocks = static_cast<int32>(FMath::DivideAndRoundUp(NumValues, BlockSize));
+
+        ParallelFor(NumBlocks, [&Values, Table, NumValues](int32 BlockIndex)
+            {
+                const int64 Start = BlockIndex * BlockSize;
+                const int64 End = FMath::Min(Start + BlockSize, NumValues);
+
+                T* RESTRICT Data = Values.GetData();
+                for (int64 Index = Start; Index < End; ++Index)
+                {
+                    Data[Index] = Table[Data[Index]];
+                }
+            });
+    }
+
+    void ApplyCurve(TArrayView64<float> Values, float (*Curve)(float))
+    {
+        const int64 NumValues = Values.Num();
+        const int32 NumBlocks = static_cast<int32>(FMath::DivideAndRoundUp(NumValues, BlockSize));
+
+        ParallelFor(NumBlocks, [&Values, Curve, NumValues](int32 BlockIndex)
+            {
+                const int64 Start = BlockIndex * BlockSize;
+                const int64 End = FMath::Min(Start + BlockSize, NumValues);
+
+                float* Data = Values.GetData();
+                for (int64 Index = Start; Index < End; ++Index)
+                {
+                    Data[Index] = Curve(Data[Index]);
+                }
+            });
+    }
+}
+
+void FMaskToolsColorSpace::ConvertPlane(FMaskPlane& Plane, EGammaSpace SourceGammaSpace, EGammaSpace DestGammaSpace)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsColorSpace::ConvertPlane);
+    LLM_SCOPE_BYTAG(MaskTools);
+    using namespace MaskToolsColorSpace;
+
+    check(SourceGammaSpace != EGammaSpace::Pow22 && DestGammaSpace != EGammaSpace::Pow22);
+    if (SourceGammaSpace == DestGammaSpace) return;
+
+    // Pixels are counted once by the kernel the plane comes from
+    const bool bToLinear = DestGammaSpace == EGammaSpace::Linear;
+
+    switch (Plane.Format)
+    {
+    case EMaskPlaneFormat::U8:
+        ApplyTable(Plane.AsU8(), bToLinear ? GetSRGBToLinearTable8() : GetLinearToSRGBTable8());
+        break;
+    case EMaskPlaneFormat::U16:
+        ApplyTable(Plane.AsU16(), bToLinear ? GetSRGBToLinearTable16() : GetLinearToSRGBTable16());
+        break;
+    case EMaskPlaneFormat::F32:
+        ApplyCurve(Plane.AsF32(), bToLinear ? &SRGBToLinear : &LinearToSRGB);
+        break;
+    }
+}
+
+const uint8* FMaskToolsColorSpace::GetSRGBToLinearTable8()
+{
+    static const TArray<uint8> Table = MaskToolsColorSpace::BuildTable<uint8>(&SRGBToLinear);
+    return Table.GetData();
+}
+
+const uint8* FMaskToolsColorSpace::GetLinearToSRGBTable8()
+{
+    static const TArray<uint8> Table = MaskToolsColorSpace::BuildTable<uint8>(&LinearToSRGB);
+    return Table.GetData();
+}
+
+const uint16* FMaskToolsColorSpace::GetSRGBToLinearTable16()
+{
+    static const TArray<uint16> Table = MaskToolsColorSpace::BuildTable<uint16>(&SRGBToLinear);
+    return Table.GetData();
+}
+
+const uint16* FMaskToolsColorSpace::GetLinearToSRGBTable16()
+{
+    static const TArray<uint16> Table = MaskToolsColorSpace::BuildTable<uint16>(&LinearToSRGB);
+    return Table.GetData();
+}
+
+float FMaskToolsColorSpace::SRGBToLinear(float Value)
+{
+    return Value <= 0.04045f ? Value / 12.92f : FMath::Pow((Value + 0.055f) / 1.055f, 2.4f);
+}
+
+float FMaskToolsColorSpace::LinearToSRGB(float Value)
+{
+    return Value <= 0.0031308f ? Value * 12.92f : 1.055f * FMath::Pow(Value, 1.f / 2.4f) - 0.055f;
+}
@@ -0,0 +1,18 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsCore.h"
+
+#define LOCTEXT_NAMESPACE "FMaskToolsCoreModule"
+
+void FMaskToolsCoreModule::StartupModule()
+{
+}
+
+void FMaskToolsCoreModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FMaskToolsCoreModule, MaskToolsCore)
@@ -0,0 +1,284 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsDiskCache.h"
+
+#include "HAL/FileManager.h"
+#include "Logging.h"
+#include "MaskToolsStats.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+
+namespace MaskToolsDiskCache
+{
+    constexpr uint32 EntryMagic = 0x4B53414D;
+    // Bump when the entry layout or the plane encoding changes
+    constexpr uint32 EntryVersion = 1;
+
+    // Evict below the cap so a full cache is not scanned again on every store
+    constexpr double EvictionTarget = 0.8;
+
+    const TCHAR* EntryExtension = TEXT(".plane");
+
+    struct FEntryHeader
+    {
+        uint32 Magic = EntryMagic;
+        uint32 Version = EntryVersion;
+        int32 SizeX = 0;
+        int32 SizeY = 0;
+        uint8 Format = 0;
+        float Min = 0.f;
+        float Max = 0.f;
+        float Mean = 0.f;
+        bool bHasData = false;
+        bool bIsConstant = true;
+        int64 UncompressedSize = 0;
+        int64 CompressedSize = 0;
+
+        friend FArchive& operator<<(FArchive& Ar, FEntryHeader& Header)
+        {
+            Ar << Header.Magic << Header.Version << Header.SizeX << Header.SizeY << Header.Format;
+            Ar << Header.Min << Header.Max << Header.Mean << Header.bHasData << Header.bIsConstant;
+            Ar << Header.UncompressedSize << Header.CompressedSize;
+            return Ar;
+        }
+    };
+}
+
+FMaskToolsDiskCache& FMaskToolsDiskCache::Get()
+{
+    static FMaskToolsDiskCache Instance;
+    return Instance;
+}
+
+FMaskToolsDiskCache::FMaskToolsDiskCache(const FString& InCacheDir)
+    : CacheDir(InCacheDir)
+{
+}
+
+void FMaskToolsDiskCache::Configure(bool bInEnabled, int64 InMaxSizeBytes)
+{
+    bEnabled = bInEnabled;
+    MaxSizeBytes = FMath::Max<int64>(InMaxSizeBytes, 0);
+}
+
+FString FMaskToolsDiskCache::MakeKey(const FString& SourceHash, const FString& Parameters)
+{
+    if (SourceHash.IsEmpty()) return FString();
+
+    return FMD5::HashAnsiString(*FString::Printf(TEXT("%s|k%u|%s"), *SourceHash, KernelVersion, *Parameters));
+}
+
+bool FMaskToolsDiskCache::Load(const FString& Key, FMaskPlane& OutPlane, FMaskPlaneStats* OutStats)
+{
+    using namespace MaskToolsDiskCache;
+
+    if (!bEnabled || Key.IsEmpty()) return false;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsDiskCache::Load);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    const FString EntryPath = GetEntryPath(Key);
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*EntryPath, FILEREAD_Silent));
+    if (!Reader)
+    {
+        INC_DWORD_STAT(STAT_MaskToolsCacheMisses);
+        return false;
+    }
+
+    FEntryHeader Header;
+    *Reader << Header;
+
+    const bool bValidHeader = !Reader->IsError()
+        && Header.Magic == EntryMagic
+        && Header.Version == EntryVersion
+        && Header.Format <= static_cast<uint8>(EMaskPlaneFormat::F32)
+        && Header.SizeX > 0 && Header.SizeY > 0
+        && Header.UncompressedSize == static_cast<int64>(Header.SizeX) * Header.SizeY * FMaskPlane::GetBytesPerPixel(static_cast<EMaskPlaneFormat>(Header.Format))
+        && Header.CompressedSize > 0 && Header.CompressedSize <= Reader->TotalSize() - Reader->Tell();
+
+    bool bLoaded = false;
+    if (bValidHeader)
+    {
+        TArray64<uint8> CompressedData;
+        CompressedData.SetNumUninitialized(Header.CompressedSize);
+        Reader->Serialize(CompressedData.GetData(), Header.CompressedSize);
+
+        OutPlane.Init(Header.SizeX, Header.SizeY, static_cast<EMaskPlaneFormat>(Header.Format));
+        bLoaded = !Reader->IsError() && FCompression::UncompressMemory(NAME_Oodle, OutPlane.RawData.GetData(), static_cast<int32>(Header.UncompressedSize),
+            CompressedData.GetData(), static_cast<int32>(Header.CompressedSize));
+    }
+    Reader.Reset();
+
+    if (!bLoaded)
+    {
+        // Truncated or written by another version, recompute and overwrite it
+        UE_LOG(LogMaskToolsCore, Verbose, TEXT("Discarding unreadable cache entry %s"), *EntryPath);
+        IFileManager::Get().Delete(*EntryPath, false, false, true);
+        OutPlane = FMaskPlane();
+        INC_DWORD_STAT(STAT_MaskToolsCacheMisses);
+        return false;
+    }
+
+    if (OutStats)
+    {
+        OutStats->Min = Header.Min;
+        OutStats->Max = Header.Max;
+        OutStats->Mean = Header.Mean;
+        OutStats->bHasData = Header.bHasData;
+        OutStats->bIsConstant = Header.bIsConstant;
+    }
+
+    // The timestamp is what eviction sorts on, so a read counts as a use
+    IFileManager::Get().SetTimeStamp(*EntryPath, FDateTime::UtcNow());
+
+    INC_DWORD_STAT(STAT_MaskToolsCacheHits);
+    return true;
+}
+
+void FMaskToolsDiskCache::Store(const FString& Key, const FMaskPlane& Plane, const FMaskPlaneStats& Stats)
+{
+    using namespace MaskToolsDiskCache;
+
+    if (!bEnabled || Key.IsEmpty() || !Plane.IsValid() || Plane.RawData.Num() > MAX_int32) return;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsDiskCache::Store);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    const int32 UncompressedSize = static_cast<int32>(Plane.RawData.Num());
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+
+    TArray64<uint8> CompressedData;
+    CompressedData.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Oodle, CompressedData.GetData(), CompressedSize, Plane.RawData.GetData(), UncompressedSize))
+    {
+        UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to compress cache entry %s"), *Key);
+        return;
+    }
+
+    FEntryHeader Header;
+    Header.SizeX = Plane.SizeX;
+    Header.SizeY = Plane.SizeY;
+    Header.Format = static_cast<uint8>(Plane.Format);
+    Header.Min = Stats.Min;
+    Header.Max = Stats.Max;
+    Header.Mean = Stats.Mean;
+    Header.bHasData = Stats.bHasData;
+    Header.bIsConstant = Stats.bIsConstant;
+    Header.UncompressedSize = UncompressedSize;
+    Header.CompressedSize = CompressedSize;
+
+    // Write aside and move in place, so readers never see a partial entry
+    const FString EntryPath = GetEntryPath(Key);
+    const int64 ReplacedSize = IFileManager::Get().FileSize(*EntryPath);
+    const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(EntryPath), *Key, TEXT(".tmp"));
+    {
+        TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath, FILEWRITE_Silent));
+        if (!Writer)
+        {
+            UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to write cache entry %s"), *TempPath);
+            return;
+        }
+
+        *Writer << Header;
+        Writer->Serialize(CompressedData.GetData(), CompressedSize);
+        if (!Writer->Close())
+        {
+            IFileManager::Get().Delete(*TempPath, false, false, true);
+            return;
+        }
+    }
+
+    if (!IFileManager::Get().Move(*EntryPath, *TempPath, true, true, false, true))
+    {
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        return;
+    }
+
+    {
+        FScopeLock Lock(&SizeLock);
+        if (CurrentSizeBytes >= 0)
+        {
+            // Overwriting an entry only changes the size by the difference, FileSize is -1 when there was none
+            CurrentSizeBytes += IFileManager::Get().FileSize(*EntryPath) - FMath::Max<int64>(ReplacedSize, 0);
+        }
+    }
+
+    EvictIfNeeded();
+}
+
+void FMaskToolsDiskCache::Clear()
+{
+    FScopeLock Lock(&SizeLock);
+
+    IFileManager::Get().DeleteDirectory(*GetCacheDir(), false, true);
+    CurrentSizeBytes = 0;
+}
+
+FString FMaskToolsDiskCache::GetCacheDir() const
+{
+    return CacheDir.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("MaskToolsCache") : CacheDir;
+}
+
+FString FMaskToolsDiskCache::GetEntryPath(const FString& Key) const
+{
+    // Two level fan out keeps folders small on big projects
+    return GetCacheDir() / Key.Left(2) / Key + MaskToolsDiskCache::EntryExtension;
+}
+
+void FMaskToolsDiskCache::EvictIfNeeded()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsDiskCache::EvictIfNeeded);
+
+    FScopeLock Lock(&SizeLock);
+
+    const int64 MaxBytes = MaxSizeBytes;
+    if (CurrentSizeBytes >= 0 && CurrentSizeBytes <= MaxBytes)
+    {
+        return;
+    }
+
+    struct FEntry
+    {
+        FString Path;
+        int64 Size;
+        FDateTime LastUse;
+    };
+
+    TArray<FEntry> Entries;
+    int64 TotalBytes = 0;
+    IFileManager::Get().IterateDirectoryStatRecursively(*GetCacheDir(), [&Entries, &TotalBytes](const TCHAR* Path, const FFileStatData& StatData)
+        {
+            if (!StatData.bIsDirectory && FStringView(Path).EndsWith(MaskToolsDiskCache::EntryExtension))
+            {
+                Entries.Add({ Path, StatData.FileSize, StatData.ModificationTime });
+                TotalBytes += StatData.FileSize;
+            }
+            return true;
+        });
+
+    CurrentSizeBytes = TotalBytes;
+    if (CurrentSizeBytes <= MaxBytes)
+    {
+        return;
+    }
+
+    Entries.Sort([](const FEntry& A, const FEntry& B) { return A.LastUse < B.LastUse; });
+
+    const int64 TargetBytes = static_cast<int64>(MaxBytes * MaskToolsDiskCache::EvictionTarget);
+    int32 EvictedEntries = 0;
+    for (const FEntry& Entry : Entries)
+    {
+        if (CurrentSizeBytes <= TargetBytes) break;
+
+        if (IFileManager::Get().Delete(*Entry.Path, false, false, true))
+        {
+            CurrentSizeBytes -= Entry.Size;
+            EvictedEntries++;
+        }
+    }
+
+    UE_LOG(LogMaskToolsCore, Log, TEXT("Evicted %d cache entries, cache is now %.1f MB"), EvictedEntries, CurrentSizeBytes / (1024.0 * 1024.0));
+}
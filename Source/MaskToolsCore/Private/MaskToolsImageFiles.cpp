@@ -0,0 +1,230 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsImageFiles.h"
+
+#include "Async/ParallelFor.h"
+#include "IImageWrapperModule.h"
+#include "Logging.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsStats.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+
+#include <atomic>
+
+namespace MaskToolsImageFiles
+{
+    EImageFormat GetImageFormat(EMaskImageFileFormat Format)
+    {
+        switch (Format)
+        {
+        case EMaskImageFileFormat::TGA:
+            return EImageFormat::TGA;
+        case EMaskImageFileFormat::EXR:
+            return EImageFormat::EXR;
+        case EMaskImageFileFormat::PNG8:
+        case EMaskImageFileFormat::PNG16:
+        default:
+            return EImageFormat::PNG;
+        }
+    }
+
+    // Single channel images keep a single channel whenever the file format can store it
+    ERawImageFormat::Type GetRawFormat(const FImageView& Image, EMaskImageFileFormat Format)
+    {
+        const bool bGrayscale = Image.Format == ERawImageFormat::G8 || Image.Format == ERawImageFormat::G16
+            || Image.Format == ERawImageFormat::R16F || Image.Format == ERawImageFormat::R32F;
+
+        switch (Format)
+        {
+        case EMaskImageFileFormat::PNG16:
+            return bGrayscale ? ERawImageFormat::G16 : ERawImageFormat::RGBA16;
+        case EMaskImageFileFormat::EXR:
+            return bGrayscale ? ERawImageFormat::R16F : ERawImageFormat::RGBA16F;
+        case EMaskImageFileFormat::TGA:
+            return ERawImageFormat::BGRA8;
+        case EMaskImageFileFormat::PNG8:
+        default:
+            return bGrayscale ? ERawImageFormat::G8 : ERawImageFormat::BGRA8;
+        }
+    }
+
+    IImageWrapperModule& GetImageWrapperModule()
+    {
+        // Loading modules is only allowed on the game thread, workers expect SaveImages to have done it
+        return IsInGameThread()
+            ? FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"))
+            : FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    }
+}
+
+const TCHAR* FMaskToolsImageFiles::GetExtension(EMaskImageFileFormat Format)
+{
+    switch (Format)
+    {
+    case EMaskImageFileFormat::TGA:
+        return TEXT(".tga");
+    case EMaskImageFileFormat::EXR:
+        return TEXT(".exr");
+    case EMaskImageFileFormat::PNG8:
+    case EMaskImageFileFormat::PNG16:
+    default:
+        return TEXT(".png");
+    }
+}
+
+bool FMaskToolsImageFiles::SaveImage(const FImageView& Image, const FString& FilePath, EMaskImageFileFormat Format)
+{
+    using namespace MaskToolsImageFiles;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::SaveImage);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    // 8 bit channels are written as they are displayed, wider ones as linear values
+    const ERawImageFormat::Type RawFormat = GetRawFormat(Image, Format);
+    const EGammaSpace GammaSpace = ERawImageFormat::GetFormatNeedsGammaSpace(RawFormat) ? Image.GammaSpace : EGammaSpace::Linear;
+
+    FImage ConvertedImage;
+    FImageView EncodedImage = Image;
+    if (Image.Format != RawFormat || Image.GammaSpace != GammaSpace)
+    {
+        FMaskToolsKernels::ConvertImage(Image, RawFormat, GammaSpace, ConvertedImage);
+        EncodedImage = ConvertedImage;
+    }
+
+    TArray64<uint8> EncodedData;
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::Encode);
+        if (!GetImageWrapperModule().CompressImage(EncodedData, GetImageFormat(Format), EncodedImage))
+        {
+            UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to encode %s"), *FilePath);
+            return false;
+        }
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::Write);
+    if (!FFileHelper::SaveArrayToFile(EncodedData, *FilePath))
+    {
+        UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+int32 FMaskToolsImageFiles::SaveImages(TArrayView<const FImageView> Images, TArrayView<const FString> FilePaths, EMaskImageFileFormat Format)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::SaveImages);
+    check(Images.Num() == FilePaths.Num());
+
+    MaskToolsImageFiles::GetImageWrapperModule();
+
+    // Encoding dominates, one image per worker keeps every core busy on big batches
+    std::atomic<int32> SavedImages { 0 };
+    ParallelFor(Images.Num(), [&Images, &FilePaths, Format, &SavedImages](int32 ImageIndex)
+        {
+            if (SaveImage(Images[ImageIndex], FilePaths[ImageIndex], Format))
+            {
+                SavedImages++;
+            }
+        });
+
+    return SavedImages;
+}
+
+bool FMaskToolsImageFiles::LoadImage(const FString& FilePath, FImage& OutImage)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::LoadImage);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    TArray64<uint8> FileData;
+    if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+    {
+        UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to read %s"), *FilePath);
+        return false;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::Decode);
+    if (!MaskToolsImageFiles::GetImageWrapperModule().DecompressImage(FileData.GetData(), FileData.Num(), OutImage))
+    {
+        UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to decode %s"), *FilePath);
+        return false;
+    }
+
+    // The wrapper assumes 8 bit files are sRGB colors, mask files hold data
+    OutImage.GammaSpace = EGammaSpace::Linear;
+
+    INC_DWORD_STAT_BY(STAT_MaskToolsBytesAllocatedTotal, OutImage.RawData.Num());
+    FMaskToolsPeakMemoryTracker::SampleAll();
+    return true;
+}
+
+int32 FMaskToolsImageFiles::LoadImages(TArrayView<const FString> FilePaths, TArray<FImage>& OutImages)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsImageFiles::LoadImages);
+
+    MaskToolsImageFiles::GetImageWrapperModule();
+
+    OutImages.Reset();
+    OutImages.SetNum(FilePaths.Num());
+
+    std::atomic<int32> LoadedImages { 0 };
+    ParallelFor(FilePaths.Num(), [&FilePaths, &OutImages, &LoadedImages](int32 FileIndex)
+        {
+            if (LoadImage(FilePaths[FileIndex], OutImages[FileIndex]))
+            {
+                LoadedImages++;
+            }
+            else
+            {
+                OutImages[FileIndex] = FImage();
+            }
+        });
+
+    return LoadedImages;
+}
+
+FMaskToolsImageFileBatch::FMaskToolsImageFileBatch(EMaskImageFileFormat InFormat, int64 InMaxQueuedBytes)
+    : Format(InFormat)
+    , MaxQueuedBytes(InMaxQueuedBytes)
+{
+}
+
+FMaskToolsImageFileBatch::~FMaskToolsImageFileBatch()
+{
+    Flush();
+}
+
+void FMaskToolsImageFileBatch::Add(FImage&& Image, const FString& FilePath)
+{
+    QueuedBytes += Image.RawData.Num();
+    QueuedImages.Add(MoveTemp(Image));
+    QueuedPaths.Add(FilePath);
+
+    if (QueuedBytes >= MaxQueuedBytes)
+    {
+        Flush();
+    }
+}
+
+int32 FMaskToolsImageFileBatch::Flush()
+{
+    if (QueuedImages.Num() == 0) return 0;
+
+    TArray<FImageView> Views;
+    for (const FImage& Image : QueuedImages)
+    {
+        Views.Add(Image);
+    }
+
+    const int32 Saved = FMaskToolsImageFiles::SaveImages(Views, QueuedPaths, Format);
+    NumSaved += Saved;
+    NumFailed += QueuedImages.Num() - Saved;
+
+    QueuedImages.Empty();
+    QueuedPaths.Empty();
+    QueuedBytes = 0;
+    return Saved;
+}
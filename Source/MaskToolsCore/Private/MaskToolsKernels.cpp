@@ -0,0 +1,717 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsKernels.h"
+
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "Logging.h"
+#include "MaskToolsColorSpace.h"
+#include "MaskToolsMemory.h"
+#include "MaskToolsResampler.h"
+#include "MaskToolsStats.h"
+
+namespace MaskToolsKernels
+{
+    // Interleaved layout a plane format is extracted from and packed to
+    ERawImageFormat::Type GetInterleavedFormat(EMaskPlaneFormat Format)
+    {
+        switch (Format)
+        {
+        case EMaskPlaneFormat::U16:
+            return ERawImageFormat::RGBA16;
+        case EMaskPlaneFormat::F32:
+            return ERawImageFormat::RGBA32F;
+        case EMaskPlaneFormat::U8:
+        default:
+            return ERawImageFormat::BGRA8;
+        }
+    }
+
+    // Element offset of a channel inside an interleaved pixel
+    int32 GetChannelOffset(ERawImageFormat::Type InterleavedFormat, EMaskChannel Channel)
+    {
+        static const int32 BGRAOffsets[4] = { 2, 1, 0, 3 };
+        const int32 ChannelIndex = static_cast<int32>(Channel);
+        return InterleavedFormat == ERawImageFormat::BGRA8 ? BGRAOffsets[ChannelIndex] : ChannelIndex;
+    }
+
+    /*
+    * Brings an image to the interleaved layout of a plane format, widening or narrowing its values without decoding them.
+    * Returns the gamma space the interleaved values are still encoded in, converted afterwards with the tables.
+    */
+    EGammaSpace PrepareInterleaved(const FImageView& Image, EMaskPlaneFormat Format, FImage& ConvertedImage, FImageView& OutSource)
+    {
+        const ERawImageFormat::Type InterleavedFormat = GetInterleavedFormat(Format);
+        OutSource = Image;
+
+        // There is no table for Pow22, the image core decodes it
+        if (Image.GammaSpace == EGammaSpace::Pow22)
+        {
+            FMaskToolsKernels::ConvertImage(Image, InterleavedFormat, EGammaSpace::Linear, ConvertedImage);
+            OutSource = ConvertedImage;
+            return EGammaSpace::Linear;
+        }
+
+        // Skip the conversion copy when the image already has the right layout
+        if (Image.Format != InterleavedFormat)
+        {
+            FImageView RawImage = Image;
+            RawImage.GammaSpace = EGammaSpace::Linear;
+            FMaskToolsKernels::ConvertImage(RawImage, InterleavedFormat, EGammaSpace::Linear, ConvertedImage);
+            OutSource = ConvertedImage;
+        }
+
+        OutSource.GammaSpace = Image.GammaSpace;
+        return Image.GammaSpace;
+    }
+
+    void TrackImage(const FImage& Image)
+    {
+        INC_DWORD_STAT_BY(STAT_MaskToolsPixelsProcessed, Image.GetNumPixels());
+        INC_DWORD_STAT_BY(STAT_MaskToolsBytesAllocatedTotal, Image.RawData.Num());
+        FMaskToolsPeakMemoryTracker::SampleAll();
+    }
+
+    void TrackPlane(const FMaskPlane& Plane)
+    {
+        INC_DWORD_STAT_BY(STAT_MaskToolsPixelsProcessed, Plane.GetNumPixels());
+        INC_DWORD_STAT_BY(STAT_MaskToolsBytesAllocatedTotal, Plane.RawData.Num());
+        FMaskToolsPeakMemoryTracker::SampleAll();
+    }
+
+    template<typename T>
+    T GetMaxValue()
+    {
+        return static_cast<T>(TNumericLimits<T>::Max());
+    }
+
+    template<>
+    float GetMaxValue<float>()
+    {
+        return 1.f;
+    }
+
+    template<typename T>
+    void Deinterleave(const T* Source, int32 SizeX, int32 SizeY, int32 ChannelOffset, T* Destination)
+    {
+        ParallelFor(SizeY, [Source, SizeX, ChannelOffset, Destination](int32 Y)
+            {
+                const int64 RowStart = static_cast<int64>(Y) * SizeX;
+                const T* SourceRow = Source + RowStart * 4 + ChannelOffset;
+                T* DestinationRow = Destination + RowStart;
+
+                for (int32 X = 0; X < SizeX; ++X)
+                {
+                    DestinationRow[X] = SourceRow[X * 4];
+                }
+            });
+    }
+
+    template<typename T>
+    void Interleave(TArrayView<const FMaskPlane* const> Planes, const int32 (&ChannelOffsets)[4], int32 SizeX, int32 SizeY, T* Destination)
+    {
+        const T* Sources[4];
+        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+        {
+            const FMaskPlane* Plane = Planes.IsValidIndex(ChannelIndex) ? Planes[ChannelIndex] : nullptr;
+            Sources[ChannelIndex] = Plane ? reinterpret_cast<const T*>(Plane->RawData.GetData()) : nullptr;
+        }
+
+        // Missing channels are black, missing alpha is opaque
+        const T Defaults[4] = { T(0), T(0), T(0), GetMaxValue<T>() };
+
+        ParallelFor(SizeY, [&Sources, &ChannelOffsets, &Defaults, SizeX, Destination](int32 Y)
+            {
+                const int64 RowStart = static_cast<int64>(Y) * SizeX;
+                T* DestinationRow = Destination + RowStart * 4;
+
+                for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+                {
+                    T* DestinationChannel = DestinationRow + ChannelOffsets[ChannelIndex];
+                    if (const T* Source = Sources[ChannelIndex])
+                    {
+                        const T* SourceRow = Source + RowStart;
+                        for (int32 X = 0; X < SizeX; ++X)
+                        {
+                            DestinationChannel[X * 4] = SourceRow[X];
+                        }
+                    }
+                    else
+                    {
+                        for (int32 X = 0; X < SizeX; ++X)
+                        {
+                            DestinationChannel[X * 4] = Defaults[ChannelIndex];
+                        }
+                    }
+                }
+            });
+    }
+
+    template<typename T>
+    FMaskPlaneStats ComputeStats(TArrayView64<const T> Values)
+    {
+        FMaskPlaneStats Stats;
+        if (Values.Num() == 0) return Stats;
+
+        const T MaxValue = GetMaxValue<T>();
+        T Min = Values[0];
+        T Max = Values[0];
+        double Sum = 0.0;
+
+        for (const T Value : Values)
+        {
+            Min = FMath::Min(Min, Value);
+            Max = FMath::Max(Max, Value);
+            Sum += Value;
+            Stats.bHasData |= Value != T(0) && Value != MaxValue;
+        }
+
+        const double Scale = 1.0 / static_cast<double>(MaxValue);
+        Stats.Min = static_cast<float>(Min * Scale);
+        Stats.Max = static_cast<float>(Max * Scale);
+        Stats.Mean = static_cast<float>(Sum / Values.Num() * Scale);
+        Stats.bIsConstant = Min == Max;
+        return Stats;
+    }
+
+    template<typename T>
+    T Average4(T A, T B, T C, T D)
+    {
+        return static_cast<T>((static_cast<uint32>(A) + B + C + D + 2) >> 2);
+    }
+
+    template<>
+    float Average4<float>(float A, float B, float C, float D)
+    {
+        return (A + B + C + D) * 0.25f;
+    }
+
+    template<typename T>
+    void ReduceMip(const FMaskPlane& Source, EMaskMipReduction Reduction, FMaskPlane& Destination)
+    {
+        const T* SourceValues = reinterpret_cast<const T*>(Source.RawData.GetData());
+        T* DestinationValues = reinterpret_cast<T*>(Destination.RawData.GetData());
+        const int32 SourceX = Source.SizeX;
+        const int32 SourceY = Source.SizeY;
+        const int32 DestX = Destination.SizeX;
+
+        // The last mips are a few texels, not worth waking the workers for
+        const EParallelForFlags Flags = Destination.GetNumPixels() < 16384 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+        ParallelFor(Destination.SizeY, [SourceValues, DestinationValues, SourceX, SourceY, DestX, Reduction](int32 Y)
+            {
+                const T* Row0 = SourceValues + static_cast<int64>(FMath::Min(Y * 2, SourceY - 1)) * SourceX;
+                const T* Row1 = SourceValues + static_cast<int64>(FMath::Min(Y * 2 + 1, SourceY - 1)) * SourceX;
+                T* DestinationRow = DestinationValues + static_cast<int64>(Y) * DestX;
+
+                for (int32 X = 0; X < DestX; ++X)
+                {
+                    const int32 X0 = FMath::Min(X * 2, SourceX - 1);
+                    const int32 X1 = FMath::Min(X * 2 + 1, SourceX - 1);
+
+                    switch (Reduction)
+                    {
+                    case EMaskMipReduction::Max:
+                        DestinationRow[X] = FMath::Max(FMath::Max(Row0[X0], Row0[X1]), FMath::Max(Row1[X0], Row1[X1]));
+                        break;
+                    case EMaskMipReduction::Min:
+                        DestinationRow[X] = FMath::Min(FMath::Min(Row0[X0], Row0[X1]), FMath::Min(Row1[X0], Row1[X1]));
+                        break;
+                    default:
+                        DestinationRow[X] = Average4(Row0[X0], Row0[X1], Row1[X0], Row1[X1]);
+                        break;
+                    }
+                }
+            }, Flags);
+    }
+
+    // Share of values that reach Threshold once multiplied by Scale
+    template<typename T>
+    double ComputeCoverage(TArrayView64<const T> Values, float Scale, float Threshold)
+    {
+        int64 Covered = 0;
+        for (const T Value : Values)
+        {
+            Covered += Value * Scale >= Threshold ? 1 : 0;
+        }
+        return Values.Num() > 0 ? static_cast<double>(Covered) / Values.Num() : 0.0;
+    }
+
+    /*
+    * Scales the values of a mip so their coverage matches TargetCoverage, as closely as its texel count allows.
+    * Starts from the unscaled mip and keeps it when it already matches. Otherwise coverage only grows with the scale,
+    * so the scale is found by bisection, stopping at the first one that matches.
+    */
+    template<typename T>
+    void ScaleToCoverage(TArrayView64<T> Values, double TargetCoverage, float Threshold)
+    {
+        // Nothing or everything covered, as in constant masks, is already kept by the average
+        if (Values.Num() == 0 || TargetCoverage <= 0.0 || TargetCoverage >= 1.0) return;
+
+        // Half a texel of coverage, the closest a mip can get to the target
+        const double Tolerance = 0.5 / Values.Num();
+        const double UnscaledCoverage = ComputeCoverage(TArrayView64<const T>(Values), 1.f, Threshold);
+        if (FMath::Abs(UnscaledCoverage - TargetCoverage) <= Tolerance) return;
+
+        float LowScale = UnscaledCoverage < TargetCoverage ? 1.f : 0.f;
+        float HighScale = UnscaledCoverage < TargetCoverage ? 4.f : 1.f;
+        for (int32 Iteration = 0; Iteration < 12; ++Iteration)
+        {
+            const float Scale = (LowScale + HighScale) * 0.5f;
+            const double Coverage = ComputeCoverage(TArrayView64<const T>(Values), Scale, Threshold);
+            if (FMath::Abs(Coverage - TargetCoverage) <= Tolerance)
+            {
+                HighScale = Scale;
+                break;
+            }
+
+            if (Coverage < TargetCoverage)
+            {
+                LowScale = Scale;
+            }
+            else
+            {
+                HighScale = Scale;
+            }
+        }
+
+        const float MaxValue = static_cast<float>(GetMaxValue<T>());
+        for (T& Value : Values)
+        {
+            const float Scaled = Value * HighScale;
+            Value = TIsFloatingPoint<T>::Value ? static_cast<T>(Scaled) : static_cast<T>(FMath::Min(FMath::RoundToFloat(Scaled), MaxValue));
+        }
+    }
+
+    template<typename T>
+    void BuildMipChain(const FMaskPlane& Plane, EMaskMipReduction Reduction, float CoverageThreshold, TArray<FMaskPlane>& OutMips)
+    {
+        OutMips.SetNum(FMath::FloorLog2(static_cast<uint32>(FMath::Max(Plane.SizeX, Plane.SizeY))));
+
+        const FMaskPlane* Previous = &Plane;
+        for (FMaskPlane& Mip : OutMips)
+        {
+            Mip.Init(FMath::Max(1, Previous->SizeX >> 1), FMath::Max(1, Previous->SizeY >> 1), Plane.Format);
+            ReduceMip<T>(*Previous, Reduction, Mip);
+            Previous = &Mip;
+        }
+
+        if (Reduction != EMaskMipReduction::Coverage) return;
+
+        // Each mip was averaged from the unscaled one above it, so scaling errors don't add up down the chain
+        const float Threshold = CoverageThreshold * GetMaxValue<T>();
+        const TArrayView64<const T> TopValues(reinterpret_cast<const T*>(Plane.RawData.GetData()), Plane.GetNumPixels());
+        const double TargetCoverage = ComputeCoverage(TopValues, 1.f, Threshold);
+
+        ParallelFor(OutMips.Num(), [&OutMips, TargetCoverage, Threshold](int32 MipIndex)
+            {
+                FMaskPlane& Mip = OutMips[MipIndex];
+                ScaleToCoverage(TArrayView64<T>(reinterpret_cast<T*>(Mip.RawData.GetData()), Mip.GetNumPixels()), TargetCoverage, Threshold);
+            });
+    }
+}
+
+void FMaskToolsKernels::ConvertImage(const FImageView& Image, ERawImageFormat::Type DestFormat, EGammaSpace DestGammaSpace, FImage& OutImage)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ConvertImage);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    // Only 8 bit formats can be stored in sRGB
+    const EGammaSpace GammaSpace = ERawImageFormat::GetFormatNeedsGammaSpace(DestFormat) ? DestGammaSpace : EGammaSpace::Linear;
+
+    OutImage.Init(Image.SizeX, Image.SizeY, Image.NumSlices, DestFormat, GammaSpace);
+    FImageCore::CopyImage(Image, OutImage);
+    MaskToolsKernels::TrackImage(OutImage);
+}
+
+void FMaskToolsKernels::ResizeImage(const FImageView& Image, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FImage& OutImage)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ResizeImage);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    OutImage.Init(DestSizeX, DestSizeY, Image.Format, Image.GammaSpace);
+    FImageCore::ResizeImage(Image, OutImage, Filter);
+    MaskToolsKernels::TrackImage(OutImage);
+}
+
+void FMaskToolsKernels::ResizePlane(const FMaskPlane& Plane, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ResizePlane);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(&Plane != &OutPlane);
+
+    FMaskToolsResampler::Get().Resize(Plane, DestSizeX, DestSizeY, Filter, OutPlane);
+    MaskToolsKernels::TrackPlane(OutPlane);
+}
+
+void FMaskToolsKernels::ResizePlaneChain(const FMaskPlane& Plane, TConstArrayView<FIntPoint> Sizes, FImageCore::EResizeImageFilter Filter, TArray<FMaskPlane>& OutPlanes)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ResizePlaneChain);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    OutPlanes.Reset();
+    OutPlanes.SetNum(Sizes.Num());
+
+    TArray<int32> Order;
+    for (int32 SizeIndex = 0; SizeIndex < Sizes.Num(); ++SizeIndex)
+    {
+        Order.Add(SizeIndex);
+    }
+    Order.StableSort([Sizes](int32 A, int32 B)
+        {
+            return static_cast<int64>(Sizes[A].X) * Sizes[A].Y > static_cast<int64>(Sizes[B].X) * Sizes[B].Y;
+        });
+
+    for (int32 Level = 0; Level < Order.Num(); ++Level)
+    {
+        const FIntPoint Size = Sizes[Order[Level]];
+
+        // Later levels are smaller, the first covering one found walking back is the cheapest source
+        const FMaskPlane* Source = &Plane;
+        for (int32 Previous = Level - 1; Previous >= 0; --Previous)
+        {
+            const FMaskPlane& Candidate = OutPlanes[Order[Previous]];
+            if (Candidate.SizeX >= Size.X && Candidate.SizeY >= Size.Y)
+            {
+                Source = &Candidate;
+                break;
+            }
+        }
+
+        ResizePlane(*Source, Size.X, Size.Y, Filter, OutPlanes[Order[Level]]);
+    }
+}
+
+void FMaskToolsKernels::ExtractPlane(const FImageView& Image, EMaskChannel Channel, EMaskPlaneFormat Format, EGammaSpace GammaSpace, FMaskPlane& OutPlane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ExtractPlane);
+    LLM_SCOPE_BYTAG(MaskTools);
+    using namespace MaskToolsKernels;
+
+    const ERawImageFormat::Type InterleavedFormat = GetInterleavedFormat(Format);
+
+    FImage ConvertedImage;
+    FImageView Source;
+    const EGammaSpace SourceGammaSpace = PrepareInterleaved(Image, Format, ConvertedImage, Source);
+
+    OutPlane.Init(Source.SizeX, Source.SizeY, Format);
+    const int32 ChannelOffset = GetChannelOffset(InterleavedFormat, Channel);
+
+    switch (Format)
+    {
+    case EMaskPlaneFormat::U8:
+        Deinterleave(static_cast<const uint8*>(Source.RawData), Source.SizeX, Source.SizeY, ChannelOffset, OutPlane.AsU8().GetData());
+        break;
+    case EMaskPlaneFormat::U16:
+        Deinterleave(static_cast<const uint16*>(Source.RawData), Source.SizeX, Source.SizeY, ChannelOffset, OutPlane.AsU16().GetData());
+        break;
+    case EMaskPlaneFormat::F32:
+        Deinterleave(static_cast<const float*>(Source.RawData), Source.SizeX, Source.SizeY, ChannelOffset, OutPlane.AsF32().GetData());
+        break;
+    }
+
+    // Values are decoded or encoded at the plane precision, leaving the ones already in GammaSpace untouched
+    FMaskToolsColorSpace::ConvertPlane(OutPlane, SourceGammaSpace, GammaSpace);
+
+    TrackPlane(OutPlane);
+}
+
+void FMaskToolsKernels::ExtractResizedPlane(const FImageView& Image, EMaskChannel Channel, EMaskPlaneFormat Format, EGammaSpace GammaSpace,
+    int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ExtractResizedPlane);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    if (Image.SizeX == DestSizeX && Image.SizeY == DestSizeY)
+    {
+        ExtractPlane(Image, Channel, Format, GammaSpace, OutPlane);
+        return;
+    }
+
+    // Decoded into float and quantized last, an sRGB source decoded to linear 8 bit loses most of its darks before they are filtered
+    FMaskPlane SourcePlane;
+    ExtractPlane(Image, Channel, EMaskPlaneFormat::F32, GammaSpace, SourcePlane);
+
+    if (Format == EMaskPlaneFormat::F32)
+    {
+        ResizePlane(SourcePlane, DestSizeX, DestSizeY, Filter, OutPlane);
+        return;
+    }
+
+    FMaskPlane ResizedPlane;
+    ResizePlane(SourcePlane, DestSizeX, DestSizeY, Filter, ResizedPlane);
+    SourcePlane = FMaskPlane();
+    ConvertPlane(ResizedPlane, Format, OutPlane);
+}
+
+void FMaskToolsKernels::Unpack(const FImageView& Image, EMaskPlaneFormat Format, EGammaSpace GammaSpace, TArray<FMaskPlane>& OutPlanes)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::Unpack);
+    LLM_SCOPE_BYTAG(MaskTools);
+    using namespace MaskToolsKernels;
+
+    // Convert the layout once and deinterleave every channel from the same copy
+    FImage ConvertedImage;
+    FImageView Source;
+    PrepareInterleaved(Image, Format, ConvertedImage, Source);
+
+    OutPlanes.SetNum(4);
+    for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+    {
+        ExtractPlane(Source, static_cast<EMaskChannel>(ChannelIndex), Format, GammaSpace, OutPlanes[ChannelIndex]);
+    }
+}
+
+bool FMaskToolsKernels::Pack(TArrayView<const FMaskPlane* const> Planes, FImage& OutImage)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::Pack);
+    LLM_SCOPE_BYTAG(MaskTools);
+    using namespace MaskToolsKernels;
+
+    const FMaskPlane* Reference = nullptr;
+    for (const FMaskPlane* Plane : Planes)
+    {
+        if (!Plane) continue;
+
+        if (!Reference)
+        {
+            Reference = Plane;
+        }
+        else if (Plane->SizeX != Reference->SizeX || Plane->SizeY != Reference->SizeY || Plane->Format != Reference->Format)
+        {
+            UE_LOG(LogMaskToolsCore, Warning, TEXT("Can't pack planes with different sizes or formats"));
+            return false;
+        }
+    }
+
+    if (!Reference)
+    {
+        UE_LOG(LogMaskToolsCore, Warning, TEXT("Can't pack an image without any plane"));
+        return false;
+    }
+
+    const ERawImageFormat::Type InterleavedFormat = GetInterleavedFormat(Reference->Format);
+    OutImage.Init(Reference->SizeX, Reference->SizeY, InterleavedFormat, EGammaSpace::Linear);
+
+    int32 ChannelOffsets[4];
+    for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+    {
+        ChannelOffsets[ChannelIndex] = GetChannelOffset(InterleavedFormat, static_cast<EMaskChannel>(ChannelIndex));
+    }
+
+    switch (Reference->Format)
+    {
+    case EMaskPlaneFormat::U8:
+        Interleave(Planes, ChannelOffsets, OutImage.SizeX, OutImage.SizeY, OutImage.RawData.GetData());
+        break;
+    case EMaskPlaneFormat::U16:
+        Interleave(Planes, ChannelOffsets, OutImage.SizeX, OutImage.SizeY, reinterpret_cast<uint16*>(OutImage.RawData.GetData()));
+        break;
+    case EMaskPlaneFormat::F32:
+        Interleave(Planes, ChannelOffsets, OutImage.SizeX, OutImage.SizeY, reinterpret_cast<float*>(OutImage.RawData.GetData()));
+        break;
+    }
+
+    TrackImage(OutImage);
+    return true;
+}
+
+void FMaskToolsKernels::ConvertPlane(const FMaskPlane& Plane, EMaskPlaneFormat DestFormat, FMaskPlane& OutPlane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ConvertPlane);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(&Plane != &OutPlane);
+
+    OutPlane.Init(Plane.SizeX, Plane.SizeY, DestFormat);
+    FImageCore::CopyImage(Plane.AsImageView(), OutPlane.AsImageView());
+    MaskToolsKernels::TrackPlane(OutPlane);
+}
+
+FMaskPlaneStats FMaskToolsKernels::ComputeStats(const FMaskPlane& Plane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::ComputeStats);
+    LLM_SCOPE_BYTAG(MaskTools);
+    INC_DWORD_STAT_BY(STAT_MaskToolsPixelsProcessed, Plane.GetNumPixels());
+
+    switch (Plane.Format)
+    {
+    case EMaskPlaneFormat::U16:
+        return MaskToolsKernels::ComputeStats(Plane.AsU16());
+    case EMaskPlaneFormat::F32:
+        return MaskToolsKernels::ComputeStats(Plane.AsF32());
+    case EMaskPlaneFormat::U8:
+    default:
+        return MaskToolsKernels::ComputeStats(Plane.AsU8());
+    }
+}
+
+void FMaskToolsKernels::BuildMipChain(const FMaskPlane& Plane, EMaskMipReduction Reduction, float CoverageThreshold, TArray<FMaskPlane>& OutMips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::BuildMipChain);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    OutMips.Reset();
+    if (!Plane.IsValid()) return;
+
+    switch (Plane.Format)
+    {
+    case EMaskPlaneFormat::U16:
+        MaskToolsKernels::BuildMipChain<uint16>(Plane, Reduction, CoverageThreshold, OutMips);
+        break;
+    case EMaskPlaneFormat::F32:
+        MaskToolsKernels::BuildMipChain<float>(Plane, Reduction, CoverageThreshold, OutMips);
+        break;
+    case EMaskPlaneFormat::U8:
+    default:
+        MaskToolsKernels::BuildMipChain<uint8>(Plane, Reduction, CoverageThreshold, OutMips);
+        break;
+    }
+
+    for (const FMaskPlane& Mip : OutMips)
+    {
+        MaskToolsKernels::TrackPlane(Mip);
+    }
+}
+
+bool FMaskToolsKernels::BuildMipImages(TArrayView<const FMaskPlane* const> Planes, TArrayView<const EMaskMipReduction> Reductions, float CoverageThreshold,
+    TArray<FImage>& OutMips)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::BuildMipImages);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    OutMips.Reset();
+    if (Planes.Num() == 0 || Planes.Num() > 4) return false;
+
+    // Channels are independent, each chain runs on its own worker
+    TArray<FMaskPlane> Chains[4];
+    ParallelFor(Planes.Num(), [&Planes, &Reductions, &Chains, CoverageThreshold](int32 PlaneIndex)
+        {
+            if (!Planes[PlaneIndex]) return;
+
+            const EMaskMipReduction Reduction = Reductions.IsValidIndex(PlaneIndex) ? Reductions[PlaneIndex] : EMaskMipReduction::Average;
+            BuildMipChain(*Planes[PlaneIndex], Reduction, CoverageThreshold, Chains[PlaneIndex]);
+        });
+
+    int32 NumMips = 0;
+    for (int32 PlaneIndex = 0; PlaneIndex < Planes.Num(); ++PlaneIndex)
+    {
+        NumMips = FMath::Max(NumMips, Chains[PlaneIndex].Num());
+    }
+
+    OutMips.SetNum(NumMips);
+    for (int32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+    {
+        if (Planes.Num() == 1)
+        {
+            Chains[0][MipIndex].MoveToImage(OutMips[MipIndex]);
+            continue;
+        }
+
+        const FMaskPlane* MipPlanes[4] = {};
+        for (int32 PlaneIndex = 0; PlaneIndex < Planes.Num(); ++PlaneIndex)
+        {
+            MipPlanes[PlaneIndex] = Chains[PlaneIndex].IsValidIndex(MipIndex) ? &Chains[PlaneIndex][MipIndex] : nullptr;
+        }
+
+        if (!Pack(MakeArrayView(MipPlanes, Planes.Num()), OutMips[MipIndex]))
+        {
+            OutMips.Reset();
+            return false;
+        }
+    }
+    return true;
+}
+
+EMaskBlockFormat FMaskToolsKernels::ChooseBlockFormat(TArrayView<const FMaskPlaneStats> ChannelStats, EMaskPlaneFormat Format)
+{
+    auto GetSingleChannelFormat = [Format]()
+    {
+        switch (Format)
+        {
+        case EMaskPlaneFormat::U16:
+            return EMaskBlockFormat::G16;
+        case EMaskPlaneFormat::F32:
+            return EMaskBlockFormat::R16F;
+        case EMaskPlaneFormat::U8:
+        default:
+            return EMaskBlockFormat::BC4;
+        }
+    };
+
+    if (ChannelStats.Num() <= 1)
+    {
+        return GetSingleChannelFormat();
+    }
+
+    auto CarriesData = [&ChannelStats](EMaskChannel Channel)
+    {
+        const int32 ChannelIndex = static_cast<int32>(Channel);
+        return ChannelStats.IsValidIndex(ChannelIndex) && !ChannelStats[ChannelIndex].bIsConstant;
+    };
+
+    auto IsZero = [&ChannelStats](EMaskChannel Channel)
+    {
+        const int32 ChannelIndex = static_cast<int32>(Channel);
+        return !ChannelStats.IsValidIndex(ChannelIndex) || (ChannelStats[ChannelIndex].bIsConstant && ChannelStats[ChannelIndex].Max <= 0.f);
+    };
+
+    // A missing alpha is packed as white. A constant green or blue other than 0 is a value the mask means to keep
+    const bool bOpaque = !ChannelStats.IsValidIndex(3) || (ChannelStats[3].bIsConstant && ChannelStats[3].Min >= 1.f);
+    if (bOpaque && IsZero(EMaskChannel::Green) && IsZero(EMaskChannel::Blue))
+    {
+        return GetSingleChannelFormat();
+    }
+
+    // Half floats only have an 11 bit mantissa
+    if (Format == EMaskPlaneFormat::U16)
+    {
+        return EMaskBlockFormat::RGBA32F;
+    }
+    if (Format == EMaskPlaneFormat::F32)
+    {
+        return EMaskBlockFormat::RGBA16F;
+    }
+
+    // BC5 would keep two channels better, but it takes as much memory as BC7
+    if (bOpaque)
+    {
+        return EMaskBlockFormat::BC1;
+    }
+
+    const bool bAllChannelsCarryData = CarriesData(EMaskChannel::Red) && CarriesData(EMaskChannel::Green)
+        && CarriesData(EMaskChannel::Blue) && CarriesData(EMaskChannel::Alpha);
+    return bAllChannelsCarryData ? EMaskBlockFormat::BC7 : EMaskBlockFormat::BC3;
+}
+
+void FMaskToolsKernels::FindDuplicatePlanes(TArrayView<const FMaskPlane> Planes, TArray<int32>& OutDuplicateOf)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsKernels::FindDuplicatePlanes);
+
+    TArray<uint64> Hashes;
+    Hashes.SetNumZeroed(Planes.Num());
+    ParallelFor(Planes.Num(), [&Planes, &Hashes](int32 PlaneIndex)
+        {
+            const FMaskPlane& Plane = Planes[PlaneIndex];
+            Hashes[PlaneIndex] = FXxHash64::HashBuffer(Plane.RawData.GetData(), Plane.RawData.Num()).Hash;
+        });
+
+    OutDuplicateOf.Init(INDEX_NONE, Planes.Num());
+    for (int32 PlaneIndex = 1; PlaneIndex < Planes.Num(); ++PlaneIndex)
+    {
+        const FMaskPlane& Plane = Planes[PlaneIndex];
+        for (int32 OtherIndex = 0; OtherIndex < PlaneIndex; ++OtherIndex)
+        {
+            const FMaskPlane& Other = Planes[OtherIndex];
+            if (OutDuplicateOf[OtherIndex] != INDEX_NONE || Hashes[OtherIndex] != Hashes[PlaneIndex]) continue;
+
+            if (Plane.SizeX == Other.SizeX && Plane.SizeY == Other.SizeY && Plane.Format == Other.Format
+                && Plane.RawData.Num() == Other.RawData.Num()
+                && FMemory::Memcmp(Plane.RawData.GetData(), Other.RawData.GetData(), Plane.RawData.Num()) == 0)
+            {
+                OutDuplicateOf[PlaneIndex] = OtherIndex;
+                break;
+            }
+        }
+    }
+}
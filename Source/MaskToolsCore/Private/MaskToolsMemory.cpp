@@ -0,0 +1,114 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsMemory.h"
+
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace MaskToolsMemory
+{
+    // Between two kernel allocations, the ticker only has to catch what other code allocates
+    constexpr float TickerSampleInterval = 0.25f;
+
+    FCriticalSection ActiveTrackersLock;
+    TArray<FMaskToolsPeakMemoryTracker*> ActiveTrackers;
+    std::atomic<int32> NumActiveTrackers { 0 };
+}
+
+FMaskToolsPeakMemoryTracker::FMaskToolsPeakMemoryTracker()
+    : Baseline(FPlatformMemory::GetStats().UsedPhysical)
+    , Peak(Baseline)
+    , StartTime(FPlatformTime::Seconds())
+{
+    {
+        FScopeLock Lock(&MaskToolsMemory::ActiveTrackersLock);
+        MaskToolsMemory::ActiveTrackers.Add(this);
+        ++MaskToolsMemory::NumActiveTrackers;
+    }
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+        {
+            Sample(FPlatformMemory::GetStats().UsedPhysical);
+            return true;
+        }), MaskToolsMemory::TickerSampleInterval);
+}
+
+FMaskToolsPeakMemoryTracker::~FMaskToolsPeakMemoryTracker()
+{
+    Stop();
+}
+
+int64 FMaskToolsPeakMemoryTracker::Stop()
+{
+    if (!bStopped)
+    {
+        bStopped = true;
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+        {
+            FScopeLock Lock(&MaskToolsMemory::ActiveTrackersLock);
+            MaskToolsMemory::ActiveTrackers.RemoveSingleSwap(this);
+            --MaskToolsMemory::NumActiveTrackers;
+        }
+
+        Sample(FPlatformMemory::GetStats().UsedPhysical);
+        StopTime = FPlatformTime::Seconds();
+    }
+
+    return static_cast<int64>(Peak.load() - Baseline);
+}
+
+double FMaskToolsPeakMemoryTracker::GetElapsedSeconds() const
+{
+    return (bStopped ? StopTime : FPlatformTime::Seconds()) - StartTime;
+}
+
+void FMaskToolsPeakMemoryTracker::SampleAll()
+{
+    if (MaskToolsMemory::NumActiveTrackers.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+    FScopeLock Lock(&MaskToolsMemory::ActiveTrackersLock);
+    for (FMaskToolsPeakMemoryTracker* Tracker : MaskToolsMemory::ActiveTrackers)
+    {
+        Tracker->Sample(UsedPhysical);
+    }
+}
+
+void FMaskToolsPeakMemoryTracker::Sample(uint64 UsedPhysical)
+{
+    uint64 CurrentPeak = Peak.load();
+    while (UsedPhysical > CurrentPeak && !Peak.compare_exchange_weak(CurrentPeak, UsedPhysical))
+    {
+    }
+}
+
+int64 FMaskToolsMemory::GetDefaultBudget()
+{
+    return static_cast<int64>(FPlatformMemory::GetConstants().TotalPhysical / 2);
+}
+
+int64 FMaskToolsMemory::EstimateSplitMemory(int32 SizeX, int32 SizeY, int32 SourceBytesPerPixel, EMaskPlaneFormat Format,
+    bool bWithMips, TConstArrayView<FIntPoint> ResizedSizes)
+{
+    const int64 ChannelsBytesPerPixel = 4 * FMaskPlane::GetBytesPerPixel(Format);
+    const int64 NumPixels = static_cast<int64>(FMath::Max(SizeX, 0)) * FMath::Max(SizeY, 0);
+    const int64 PlanesBytes = NumPixels * ChannelsBytesPerPixel;
+
+    int64 ResizedBytes = 0;
+    for (const FIntPoint& Size : ResizedSizes)
+    {
+        ResizedBytes += static_cast<int64>(FMath::Max(Size.X, 0)) * FMath::Max(Size.Y, 0) * ChannelsBytesPerPixel;
+    }
+
+    // A full mip chain adds a third of its top mip
+    const int64 MipsBytes = bWithMips ? (PlanesBytes + ResizedBytes) / 3 : 0;
+
+    return NumPixels * SourceBytesPerPixel + PlanesBytes * 2 + ResizedBytes + MipsBytes;
+}
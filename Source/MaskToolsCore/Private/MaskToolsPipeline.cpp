@@ -0,0 +1,336 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsPipeline.h"
+
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Logging.h"
+#include "MaskToolsProgress.h"
+#include "MaskToolsStats.h"
+
+namespace MaskToolsPipeline
+{
+    // Game thread time spent on stages per editor frame
+    constexpr double FrameBudgetSeconds = 0.008;
+
+    // Longest a waiting game thread sleeps before checking its stages again
+    constexpr uint32 WaitMilliseconds = 5;
+}
+
+FMaskToolsPipeline::FMaskToolsPipeline(const FString& InName, int32 InMaxInFlight)
+    : Name(InName)
+    , MaxInFlight(FMath::Max(1, InMaxInFlight))
+{
+    WorkerEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FMaskToolsPipeline::~FMaskToolsPipeline()
+{
+    FPlatformProcess::ReturnSynchEventToPool(WorkerEvent);
+    WorkerEvent = nullptr;
+}
+
+void FMaskToolsPipeline::AddStage(const FString& StageName, EMaskPipelineThread Thread, FStageFunction Function, int32 Capacity)
+{
+    check(!bStarted);
+
+    FStage& Stage = Stages.AddDefaulted_GetRef();
+    Stage.Name = StageName;
+    Stage.Thread = Thread;
+    Stage.Function = MoveTemp(Function);
+    Stage.Capacity = FMath::Max(1, Capacity);
+}
+
+void FMaskToolsPipeline::SetMemoryBudget(int64 InMemoryBudget)
+{
+    check(!bStarted);
+    MemoryBudget = FMath::Max<int64>(0, InMemoryBudget);
+}
+
+void FMaskToolsPipeline::SetProgress(TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> InProgress)
+{
+    check(!bStarted);
+    Progress = MoveTemp(InProgress);
+}
+
+void FMaskToolsPipeline::AddJob(TUniquePtr<FMaskToolsPipelineJob> Job, int64 MemoryCost)
+{
+    check(IsInGameThread());
+    if (!Job) return;
+
+    Job->MemoryCost = FMath::Max<int64>(0, MemoryCost);
+    if (Progress)
+    {
+        Progress->AddTotalWork(1);
+    }
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        PendingJobs.Add(MoveTemp(Job));
+    }
+
+    if (bStarted)
+    {
+        Schedule();
+    }
+}
+
+void FMaskToolsPipeline::Start(TFunction<void()> InOnCompleted)
+{
+    check(IsInGameThread());
+    check(!bStarted && Stages.Num() > 0);
+    TRACE_BOOKMARK(TEXT("MaskTools Pipeline %s"), *Name);
+
+    bStarted = true;
+    OnCompleted = MoveTemp(InOnCompleted);
+    SelfReference = AsShared();
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FMaskToolsPipeline::Tick));
+    Schedule();
+}
+
+void FMaskToolsPipeline::Wait()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsPipeline::Wait);
+    check(IsInGameThread());
+
+    // Keeps the pipeline alive through Finish, which releases the self reference
+    const TSharedRef<FMaskToolsPipeline, ESPMode::ThreadSafe> KeepAlive = AsShared();
+
+    if (!bStarted)
+    {
+        Start();
+    }
+
+    while (!IsDone())
+    {
+        if (!PumpGameThread(FPlatformTime::Seconds() + MaskToolsPipeline::FrameBudgetSeconds))
+        {
+            WorkerEvent->Wait(MaskToolsPipeline::WaitMilliseconds);
+        }
+    }
+
+    Finish();
+}
+
+bool FMaskToolsPipeline::IsDone() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NextPendingJob == PendingJobs.Num() && NumInFlight == 0;
+}
+
+int32 FMaskToolsPipeline::GetNumCompleted() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumCompleted;
+}
+
+int32 FMaskToolsPipeline::GetNumDropped() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumDropped;
+}
+
+int32 FMaskToolsPipeline::GetNumCancelled() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumCancelled;
+}
+
+bool FMaskToolsPipeline::CanStart(int32 StageIndex) const
+{
+    const FStage& Stage = Stages[StageIndex];
+    if (Stage.Queue.Num() == 0) return false;
+    if (StageIndex == Stages.Num() - 1) return true;
+
+    // Jobs running in this stage will all land in the next queue
+    const FStage& NextStage = Stages[StageIndex + 1];
+    return Stage.NumRunning + NextStage.Queue.Num() < NextStage.Capacity;
+}
+
+void FMaskToolsPipeline::Schedule()
+{
+    TArray<TPair<int32, TUniquePtr<FMaskToolsPipelineJob>>> WorkerJobs;
+    {
+        FScopeLock ScopeLock(&Lock);
+
+        // Jobs in flight carry on to their last stage, so none leaves its outputs half written
+        if (Progress && Progress->IsCancelled())
+        {
+            while (NextPendingJob < PendingJobs.Num())
+            {
+                RetiredJobs.Add(MoveTemp(PendingJobs[NextPendingJob++]));
+                ++NumCancelled;
+                Progress->AddCompletedWork(1);
+            }
+        }
+
+        while (NextPendingJob < PendingJobs.Num() && NumInFlight < MaxInFlight && Stages[0].Queue.Num() < Stages[0].Capacity)
+        {
+            // Jobs are admitted in order, a large one waits for memory instead of letting smaller ones pass it
+            const int64 MemoryCost = PendingJobs[NextPendingJob]->MemoryCost;
+            if (MemoryBudget > 0 && NumInFlight > 0 && MemoryInFlight + MemoryCost > MemoryBudget)
+            {
+                ++NumMemoryDeferrals;
+                break;
+            }
+
+            Stages[0].Queue.Add(MoveTemp(PendingJobs[NextPendingJob++]));
+            ++NumInFlight;
+            MemoryInFlight += MemoryCost;
+            PeakMemoryInFlight = FMath::Max(PeakMemoryInFlight, MemoryInFlight);
+        }
+
+        // Later stages first, so jobs close to the end free their memory before new ones start
+        for (int32 StageIndex = Stages.Num() - 1; StageIndex >= 0; --StageIndex)
+        {
+            FStage& Stage = Stages[StageIndex];
+            if (Stage.Thread != EMaskPipelineThread::Worker) continue;
+
+            while (CanStart(StageIndex))
+            {
+                ++Stage.NumRunning;
+                WorkerJobs.Emplace(StageIndex, MoveTemp(Stage.Queue[0]));
+                Stage.Queue.RemoveAt(0);
+            }
+        }
+    }
+
+    for (TPair<int32, TUniquePtr<FMaskToolsPipelineJob>>& WorkerJob : WorkerJobs)
+    {
+        Async(EAsyncExecution::ThreadPool, [Pipeline = AsShared(), StageIndex = WorkerJob.Key, Job = MoveTemp(WorkerJob.Value)]() mutable
+            {
+                LLM_SCOPE_BYTAG(MaskTools);
+                TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Pipeline->Stages[StageIndex].Name);
+
+                const bool bKeep = Pipeline->Stages[StageIndex].Function(*Job);
+                Pipeline->CompleteStage(StageIndex, MoveTemp(Job), bKeep);
+                Pipeline->WorkerEvent->Trigger();
+            });
+    }
+}
+
+bool FMaskToolsPipeline::PumpGameThread(double Deadline)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsPipeline::PumpGameThread);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(IsInGameThread());
+
+    // A stage that ticks the editor, such as one showing a slow task dialog, must not run stages from inside itself
+    if (bPumping) return false;
+    TGuardValue<bool> PumpingGuard(bPumping, true);
+
+    Schedule();
+
+    bool bAnyRan = false;
+    bool bRan = true;
+    while (bRan && FPlatformTime::Seconds() < Deadline)
+    {
+        bRan = false;
+        for (int32 StageIndex = Stages.Num() - 1; StageIndex >= 0; --StageIndex)
+        {
+            FStage& Stage = Stages[StageIndex];
+            if (Stage.Thread != EMaskPipelineThread::GameThread) continue;
+
+            TUniquePtr<FMaskToolsPipelineJob> Job;
+            {
+                FScopeLock ScopeLock(&Lock);
+                if (!CanStart(StageIndex)) continue;
+
+                ++Stage.NumRunning;
+                Job = MoveTemp(Stage.Queue[0]);
+                Stage.Queue.RemoveAt(0);
+            }
+
+            bool bKeep = false;
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Stage.Name);
+                bKeep = Stage.Function(*Job);
+            }
+            CompleteStage(StageIndex, MoveTemp(Job), bKeep);
+            bRan = true;
+        }
+        bAnyRan |= bRan;
+    }
+
+    TArray<TUniquePtr<FMaskToolsPipelineJob>> JobsToDestroy;
+    {
+        FScopeLock ScopeLock(&Lock);
+        JobsToDestroy = MoveTemp(RetiredJobs);
+    }
+    return bAnyRan;
+}
+
+void FMaskToolsPipeline::CompleteStage(int32 StageIndex, TUniquePtr<FMaskToolsPipelineJob> Job, bool bKeep)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        --Stages[StageIndex].NumRunning;
+
+        if (bKeep && StageIndex < Stages.Num() - 1)
+        {
+            Stages[StageIndex + 1].Queue.Add(MoveTemp(Job));
+        }
+        else
+        {
+            --NumInFlight;
+            MemoryInFlight -= Job->MemoryCost;
+            (bKeep ? NumCompleted : NumDropped)++;
+            if (Progress)
+            {
+                Progress->AddCompletedWork(1);
+            }
+            RetiredJobs.Add(MoveTemp(Job));
+        }
+    }
+
+    Schedule();
+}
+
+bool FMaskToolsPipeline::Tick(float DeltaTime)
+{
+    PumpGameThread(FPlatformTime::Seconds() + MaskToolsPipeline::FrameBudgetSeconds);
+
+    if (!IsDone())
+    {
+        return true;
+    }
+
+    Finish();
+    return false;
+}
+
+void FMaskToolsPipeline::Finish()
+{
+    check(IsInGameThread());
+    if (bFinished) return;
+    bFinished = true;
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    TArray<TUniquePtr<FMaskToolsPipelineJob>> JobsToDestroy;
+    {
+        FScopeLock ScopeLock(&Lock);
+        JobsToDestroy = MoveTemp(RetiredJobs);
+    }
+    JobsToDestroy.Empty();
+
+    UE_LOG(LogMaskToolsCore, Verbose, TEXT("Pipeline %s finished, %d jobs completed, %d dropped and %d cancelled"), *Name, NumCompleted, NumDropped, NumCancelled);
+    if (NumMemoryDeferrals > 0)
+    {
+        UE_LOG(LogMaskToolsCore, Log, TEXT("Pipeline %s ran fewer jobs at once to stay under its %.0f MB memory budget, peak estimate %.0f MB"),
+            *Name, MemoryBudget / (1024.0 * 1024.0), PeakMemoryInFlight / (1024.0 * 1024.0));
+    }
+
+    if (OnCompleted)
+    {
+        OnCompleted();
+        OnCompleted = nullptr;
+    }
+
+    // May destroy the pipeline, nothing can follow
+    SelfReference.Reset();
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsProgress.h"
+
+#include "Misc/ScopeLock.h"
+
+FMaskToolsProgress::FMaskToolsProgress(int64 InTotalWork)
+    : TotalWork(FMath::Max<int64>(0, InTotalWork))
+{
+}
+
+void FMaskToolsProgress::AddTotalWork(int64 Work)
+{
+    TotalWork += Work;
+}
+
+void FMaskToolsProgress::AddCompletedWork(int64 Work)
+{
+    CompletedWork += Work;
+}
+
+void FMaskToolsProgress::SetStatus(const FString& InStatus)
+{
+    FScopeLock ScopeLock(&StatusLock);
+    Status = InStatus;
+}
+
+FString FMaskToolsProgress::GetStatus() const
+{
+    FScopeLock ScopeLock(&StatusLock);
+    return Status;
+}
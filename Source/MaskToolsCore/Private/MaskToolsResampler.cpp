@@ -0,0 +1,397 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsResampler.h"
+
+#include "Async/ParallelFor.h"
+#include "MaskToolsStats.h"
+#include "Misc/ScopeLock.h"
+
+namespace MaskToolsResampler
+{
+    // Distinct size pairs are few, the cache is simply emptied past this
+    constexpr int32 MaxCachedWeights = 64;
+
+    // Destination rows filtered by a single task, sharing one accumulation row
+    constexpr int32 RowsPerTask = 16;
+
+    enum class EFilterShape : uint8
+    {
+        Copy,
+        Point,
+        Box,
+        Triangle,
+        Cubic
+    };
+
+    struct FAxisFilter
+    {
+        EFilterShape Shape = EFilterShape::Copy;
+        // Mitchell-Netravali parameters of cubic filters
+        float B = 0.f;
+        float C = 0.f;
+    };
+
+    FAxisFilter MakeCubic(float B, float C)
+    {
+        return { EFilterShape::Cubic, B, C };
+    }
+
+    // Same choices as the image core, adaptive filters only resample axes that change size
+    FAxisFilter ResolveFilter(FImageCore::EResizeImageFilter Filter, int32 SourceSize, int32 DestSize)
+    {
+        using EFilter = FImageCore::EResizeImageFilter;
+
+        EFilter BaseFilter = static_cast<EFilter>(static_cast<uint32>(Filter) & static_cast<uint32>(EFilter::WithoutFlagsMask));
+        if (BaseFilter == EFilter::Default)
+        {
+            BaseFilter = EFilter::AdaptiveSharp;
+        }
+
+        const bool bAdaptive = BaseFilter == EFilter::AdaptiveSharp || BaseFilter == EFilter::AdaptiveSmooth;
+        if (SourceSize == DestSize && (bAdaptive || BaseFilter == EFilter::PointSample || BaseFilter == EFilter::Box))
+        {
+            return {};
+        }
+
+        const bool bUpsample = DestSize > SourceSize;
+        switch (BaseFilter)
+        {
+        case EFilter::PointSample:
+            return { EFilterShape::Point };
+        case EFilter::Box:
+            return { EFilterShape::Box };
+        case EFilter::Triangle:
+            return { EFilterShape::Triangle };
+        case EFilter::CubicGaussian:
+            return MakeCubic(1.f, 0.f);
+        case EFilter::CubicSharp:
+            return MakeCubic(0.f, 0.5f);
+        case EFilter::CubicMitchell:
+            return MakeCubic(1.f / 3.f, 1.f / 3.f);
+        case EFilter::AdaptiveSmooth:
+            return bUpsample ? MakeCubic(1.f / 3.f, 1.f / 3.f) : MakeCubic(1.f, 0.f);
+        case EFilter::AdaptiveSharp:
+        default:
+            return bUpsample ? MakeCubic(0.f, 0.5f) : MakeCubic(1.f / 3.f, 1.f / 3.f);
+        }
+    }
+
+    float GetSupport(const FAxisFilter& AxisFilter)
+    {
+        switch (AxisFilter.Shape)
+        {
+        case EFilterShape::Box:
+            return 0.5f;
+        case EFilterShape::Triangle:
+            return 1.f;
+        case EFilterShape::Cubic:
+            return 2.f;
+        default:
+            return 0.f;
+        }
+    }
+
+    float EvaluateFilter(const FAxisFilter& AxisFilter, float Distance)
+    {
+        const float X = FMath::Abs(Distance);
+        switch (AxisFilter.Shape)
+        {
+        case EFilterShape::Box:
+            return Distance >= -0.5f && Distance < 0.5f ? 1.f : 0.f;
+
+        case EFilterShape::Triangle:
+            return FMath::Max(1.f - X, 0.f);
+
+        case EFilterShape::Cubic:
+        {
+            const float B = AxisFilter.B;
+            const float C = AxisFilter.C;
+            if (X < 1.f)
+            {
+                return ((12.f - 9.f * B - 6.f * C) * X * X * X + (-18.f + 12.f * B + 6.f * C) * X * X + (6.f - 2.f * B)) / 6.f;
+            }
+            if (X < 2.f)
+            {
+                return ((-B - 6.f * C) * X * X * X + (6.f * B + 30.f * C) * X * X + (-12.f * B - 48.f * C) * X + (8.f * B + 24.f * C)) / 6.f;
+            }
+            return 0.f;
+        }
+
+        default:
+            return 0.f;
+        }
+    }
+
+    // Source pixel a tap reads, past the edges it folds onto the border or wraps around
+    FORCEINLINE int32 GetSourceIndex(int32 SourceIndex, int32 SourceSize, bool bWrap)
+    {
+        if (bWrap)
+        {
+            const int32 Wrapped = SourceIndex % SourceSize;
+            return Wrapped < 0 ? Wrapped + SourceSize : Wrapped;
+        }
+        return FMath::Clamp(SourceIndex, 0, SourceSize - 1);
+    }
+
+    TSharedRef<FMaskResampleWeights, ESPMode::ThreadSafe> BuildWeights(const FAxisFilter& AxisFilter, int32 SourceSize, int32 DestSize, bool bWrap)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(MaskToolsResampler::BuildWeights);
+
+        TSharedRef<FMaskResampleWeights, ESPMode::ThreadSafe> Weights = MakeShared<FMaskResampleWeights, ESPMode::ThreadSafe>();
+        const double Scale = static_cast<double>(SourceSize) / DestSize;
+
+        if (AxisFilter.Shape == EFilterShape::Point)
+        {
+            Weights->NumTaps = 1;
+            Weights->Indices.SetNumUninitialized(DestSize);
+            Weights->Weights.Init(1.f, DestSize);
+            for (int32 DestIndex = 0; DestIndex < DestSize; ++DestIndex)
+            {
+                Weights->Indices[DestIndex] = GetSourceIndex(FMath::FloorToInt32((DestIndex + 0.5) * Scale), SourceSize, bWrap);
+            }
+            return Weights;
+        }
+
+        // Downsampling stretches the filter over the source pixels each destination pixel covers
+        const double FilterScale = FMath::Max(Scale, 1.0);
+        const double Support = GetSupport(AxisFilter) * FilterScale;
+        const int32 NumTaps = FMath::CeilToInt32(Support * 2.0) + 1;
+
+        Weights->NumTaps = NumTaps;
+        Weights->Indices.SetNumZeroed(DestSize * NumTaps);
+        Weights->Weights.SetNumZeroed(DestSize * NumTaps);
+
+        for (int32 DestIndex = 0; DestIndex < DestSize; ++DestIndex)
+        {
+            const double Center = (DestIndex + 0.5) * Scale;
+            const int32 FirstSource = FMath::FloorToInt32(Center - Support);
+
+            int32* Indices = &Weights->Indices[DestIndex * NumTaps];
+            float* TapWeights = &Weights->Weights[DestIndex * NumTaps];
+
+            float WeightSum = 0.f;
+            for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+            {
+                const int32 SourceIndex = FirstSource + Tap;
+                const float Distance = static_cast<float>((SourceIndex + 0.5 - Center) / FilterScale);
+
+                Indices[Tap] = GetSourceIndex(SourceIndex, SourceSize, bWrap);
+                TapWeights[Tap] = EvaluateFilter(AxisFilter, Distance);
+                WeightSum += TapWeights[Tap];
+            }
+
+            if (WeightSum != 0.f)
+            {
+                for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+                {
+                    TapWeights[Tap] /= WeightSum;
+                }
+            }
+        }
+
+        return Weights;
+    }
+
+    template<typename T>
+    FORCEINLINE T StoreValue(float Value)
+    {
+        return static_cast<T>(FMath::Clamp(FMath::RoundToInt32(Value), 0, static_cast<int32>(TNumericLimits<T>::Max())));
+    }
+
+    // Float planes keep the overshoot of negative lobes, as the image core does
+    template<>
+    FORCEINLINE float StoreValue<float>(float Value)
+    {
+        return Value;
+    }
+
+    // Filters every row along X
+    template<typename TIn, typename TOut>
+    void FilterRows(const TIn* Source, int32 SourceSizeX, int32 NumRows, const FMaskResampleWeights& Weights, int32 DestSizeX, TOut* Dest)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(MaskToolsResampler::FilterRows);
+
+        const int32 NumTaps = Weights.NumTaps;
+        ParallelFor(NumRows, [Source, SourceSizeX, &Weights, DestSizeX, Dest, NumTaps](int32 Y)
+            {
+                const TIn* SourceRow = Source + static_cast<int64>(Y) * SourceSizeX;
+                TOut* DestRow = Dest + static_cast<int64>(Y) * DestSizeX;
+
+                const int32* Indices = Weights.Indices.GetData();
+                const float* TapWeights = Weights.Weights.GetData();
+
+                for (int32 X = 0; X < DestSizeX; ++X)
+                {
+                    float Sum = 0.f;
+                    for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+                    {
+                        Sum += TapWeights[Tap] * static_cast<float>(SourceRow[Indices[Tap]]);
+                    }
+                    DestRow[X] = StoreValue<TOut>(Sum);
+
+                    Indices += NumTaps;
+                    TapWeights += NumTaps;
+                }
+            });
+    }
+
+    // Filters every column along Y, accumulating whole rows so memory is read in order
+    template<typename TIn, typename TOut>
+    void FilterColumns(const TIn* Source, int32 SizeX, const FMaskResampleWeights& Weights, int32 DestSizeY, TOut* Dest)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(MaskToolsResampler::FilterColumns);
+
+        const int32 NumTaps = Weights.NumTaps;
+        const int32 NumTasks = FMath::DivideAndRoundUp(DestSizeY, RowsPerTask);
+
+        ParallelFor(NumTasks, [Source, SizeX, &Weights, DestSizeY, Dest, NumTaps](int32 TaskIndex)
+            {
+                TArray<float> Accumulator;
+                Accumulator.SetNumUninitialized(SizeX);
+
+                const int32 FirstRow = TaskIndex * RowsPerTask;
+                const int32 LastRow = FMath::Min(FirstRow + RowsPerTask, DestSizeY);
+                for (int32 Y = FirstRow; Y < LastRow; ++Y)
+                {
+                    FMemory::Memzero(Accumulator.GetData(), SizeX * sizeof(float));
+
+                    for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+                    {
+                        const float Weight = Weights.Weights[Y * NumTaps + Tap];
+                        if (Weight == 0.f) continue;
+
+                        const TIn* SourceRow = Source + static_cast<int64>(Weights.Indices[Y * NumTaps + Tap]) * SizeX;
+                        for (int32 X = 0; X < SizeX; ++X)
+                        {
+                            Accumulator[X] += Weight * static_cast<float>(SourceRow[X]);
+                        }
+                    }
+
+                    TOut* DestRow = Dest + static_cast<int64>(Y) * SizeX;
+                    for (int32 X = 0; X < SizeX; ++X)
+                    {
+                        DestRow[X] = StoreValue<TOut>(Accumulator[X]);
+                    }
+                }
+            });
+    }
+
+    template<typename T>
+    void Resize(const T* Source, int32 SourceSizeX, int32 SourceSizeY, const FMaskResampleWeights* WeightsX, const FMaskResampleWeights* WeightsY,
+        int32 DestSizeX, int32 DestSizeY, T* Dest)
+    {
+        if (WeightsX && !WeightsY)
+        {
+            FilterRows(Source, SourceSizeX, SourceSizeY, *WeightsX, DestSizeX, Dest);
+            return;
+        }
+
+        if (WeightsY && !WeightsX)
+        {
+            FilterColumns(Source, SourceSizeX, *WeightsY, DestSizeY, Dest);
+            return;
+        }
+
+        // Both axes go through a float intermediate, filtered first along the axis that leaves it smallest
+        const int64 RowsFirstCost = static_cast<int64>(SourceSizeY) * DestSizeX * WeightsX->NumTaps + static_cast<int64>(DestSizeY) * DestSizeX * WeightsY->NumTaps;
+        const int64 ColumnsFirstCost = static_cast<int64>(DestSizeY) * SourceSizeX * WeightsY->NumTaps + static_cast<int64>(DestSizeY) * DestSizeX * WeightsX->NumTaps;
+
+        TArray64<float> Intermediate;
+        if (RowsFirstCost <= ColumnsFirstCost)
+        {
+            Intermediate.SetNumUninitialized(static_cast<int64>(DestSizeX) * SourceSizeY);
+            FilterRows(Source, SourceSizeX, SourceSizeY, *WeightsX, DestSizeX, Intermediate.GetData());
+            FilterColumns(Intermediate.GetData(), DestSizeX, *WeightsY, DestSizeY, Dest);
+        }
+        else
+        {
+            Intermediate.SetNumUninitialized(static_cast<int64>(SourceSizeX) * DestSizeY);
+            FilterColumns(Source, SourceSizeX, *WeightsY, DestSizeY, Intermediate.GetData());
+            FilterRows(Intermediate.GetData(), SourceSizeX, DestSizeY, *WeightsX, DestSizeX, Dest);
+        }
+    }
+}
+
+FMaskToolsResampler& FMaskToolsResampler::Get()
+{
+    static FMaskToolsResampler Instance;
+    return Instance;
+}
+
+void FMaskToolsResampler::Resize(const FMaskPlane& Plane, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsResampler::Resize);
+    LLM_SCOPE_BYTAG(MaskTools);
+    check(&Plane != &OutPlane);
+    check(Plane.IsValid() && DestSizeX > 0 && DestSizeY > 0);
+
+    using EFilter = FImageCore::EResizeImageFilter;
+    const bool bWrapX = (static_cast<uint32>(Filter) & static_cast<uint32>(EFilter::Flag_WrapX)) != 0;
+    const bool bWrapY = (static_cast<uint32>(Filter) & static_cast<uint32>(EFilter::Flag_WrapY)) != 0;
+
+    const TSharedPtr<const FMaskResampleWeights, ESPMode::ThreadSafe> WeightsX = GetWeights(Plane.SizeX, DestSizeX, Filter, bWrapX);
+    const TSharedPtr<const FMaskResampleWeights, ESPMode::ThreadSafe> WeightsY = GetWeights(Plane.SizeY, DestSizeY, Filter, bWrapY);
+
+    if (!WeightsX && !WeightsY)
+    {
+        OutPlane = Plane;
+        return;
+    }
+
+    OutPlane.Init(DestSizeX, DestSizeY, Plane.Format);
+
+    switch (Plane.Format)
+    {
+    case EMaskPlaneFormat::U8:
+        MaskToolsResampler::Resize(Plane.AsU8().GetData(), Plane.SizeX, Plane.SizeY, WeightsX.Get(), WeightsY.Get(), DestSizeX, DestSizeY, OutPlane.AsU8().GetData());
+        break;
+    case EMaskPlaneFormat::U16:
+        MaskToolsResampler::Resize(Plane.AsU16().GetData(), Plane.SizeX, Plane.SizeY, WeightsX.Get(), WeightsY.Get(), DestSizeX, DestSizeY, OutPlane.AsU16().GetData());
+        break;
+    case EMaskPlaneFormat::F32:
+        MaskToolsResampler::Resize(Plane.AsF32().GetData(), Plane.SizeX, Plane.SizeY, WeightsX.Get(), WeightsY.Get(), DestSizeX, DestSizeY, OutPlane.AsF32().GetData());
+        break;
+    }
+}
+
+void FMaskToolsResampler::ClearWeights()
+{
+    FScopeLock Lock(&WeightsLock);
+    CachedWeights.Empty();
+}
+
+TSharedPtr<const FMaskResampleWeights, ESPMode::ThreadSafe> FMaskToolsResampler::GetWeights(int32 SourceSize, int32 DestSize, FImageCore::EResizeImageFilter Filter, bool bWrap)
+{
+    using namespace MaskToolsResampler;
+
+    const FAxisFilter AxisFilter = ResolveFilter(Filter, SourceSize, DestSize);
+    if (AxisFilter.Shape == EFilterShape::Copy)
+    {
+        return nullptr;
+    }
+
+    // Filters are told apart by shape and cubic parameters, so adaptive ones share the weights of the filter they resolve to
+    const uint32 FilterKey = static_cast<uint32>(AxisFilter.Shape) | (static_cast<uint32>(AxisFilter.B * 6.f) << 4) | (static_cast<uint32>(AxisFilter.C * 6.f) << 8)
+        | (bWrap ? 1u << 12 : 0u);
+    const uint64 Key = (static_cast<uint64>(SourceSize) << 40) | (static_cast<uint64>(DestSize) << 16) | FilterKey;
+
+    {
+        FScopeLock Lock(&WeightsLock);
+        if (const FWeightsRef* Found = CachedWeights.Find(Key))
+        {
+            return *Found;
+        }
+    }
+
+    // Built outside the lock, two threads asking for the same weights at once only waste a little work
+    FWeightsRef Weights = BuildWeights(AxisFilter, SourceSize, DestSize, bWrap);
+
+    FScopeLock Lock(&WeightsLock);
+    if (CachedWeights.Num() >= MaxCachedWeights)
+    {
+        CachedWeights.Empty();
+    }
+    CachedWeights.Add(Key, Weights);
+    return Weights;
+}
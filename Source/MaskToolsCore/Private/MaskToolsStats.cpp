@@ -0,0 +1,13 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsStats.h"
+
+DEFINE_STAT(STAT_MaskToolsPixelsProcessed);
+DEFINE_STAT(STAT_MaskToolsBytesAllocatedTotal);
+DEFINE_STAT(STAT_MaskToolsCacheHits);
+DEFINE_STAT(STAT_MaskToolsCacheMisses);
+DEFINE_STAT(STAT_MaskToolsTexturesCreated);
+DEFINE_STAT(STAT_MaskToolsTexturesUnchanged);
+
+LLM_DEFINE_TAG(MaskTools);
@@ -0,0 +1,184 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "MaskToolsWorkerProtocol.h"
+
+#include "HAL/FileManager.h"
+#include "Logging.h"
+#include "MaskToolsKernels.h"
+#include "MaskToolsStats.h"
+#include "Misc/Paths.h"
+
+namespace MaskToolsWorkerProtocol
+{
+    constexpr uint32 FileMagic = 0x574B544D;
+    // Bump when the layout of tasks or results changes, editor and worker must match
+    constexpr uint32 FileVersion = 1;
+
+    void SerializeImage(FArchive& Ar, FImage& Image)
+    {
+        int32 Format = static_cast<int32>(Image.Format);
+        int32 GammaSpace = static_cast<int32>(Image.GammaSpace);
+        Ar << Image.SizeX << Image.SizeY << Image.NumSlices << Format << GammaSpace;
+        Image.Format = static_cast<ERawImageFormat::Type>(Format);
+        Image.GammaSpace = static_cast<EGammaSpace>(GammaSpace);
+        Ar << Image.RawData;
+    }
+
+    void SerializePlane(FArchive& Ar, FMaskPlane& Plane)
+    {
+        uint8 Format = static_cast<uint8>(Plane.Format);
+        Ar << Plane.SizeX << Plane.SizeY << Format;
+        Plane.Format = static_cast<EMaskPlaneFormat>(Format);
+        Ar << Plane.RawData;
+    }
+
+    void SerializeStats(FArchive& Ar, FMaskPlaneStats& Stats)
+    {
+        Ar << Stats.Min << Stats.Max << Stats.Mean << Stats.bHasData << Stats.bIsConstant;
+    }
+
+    void SerializeTask(FArchive& Ar, FMaskToolsSplitTask& Task)
+    {
+        uint8 PlaneFormat = static_cast<uint8>(Task.PlaneFormat);
+        uint8 PlaneGamma = static_cast<uint8>(Task.PlaneGamma);
+        // Wider than the filter values, it also carries the wrap flags
+        uint32 Filter = static_cast<uint32>(Task.Filter);
+        SerializeImage(Ar, Task.Image);
+        Ar << PlaneFormat << PlaneGamma << Task.SizeX << Task.SizeY << Filter;
+        Task.PlaneFormat = static_cast<EMaskPlaneFormat>(PlaneFormat);
+        Task.PlaneGamma = static_cast<EGammaSpace>(PlaneGamma);
+        Task.Filter = static_cast<FImageCore::EResizeImageFilter>(Filter);
+    }
+
+    void SerializeResult(FArchive& Ar, FMaskToolsSplitResult& Result)
+    {
+        int32 NumPlanes = Result.Planes.Num();
+        Ar << NumPlanes;
+        if (Ar.IsLoading())
+        {
+            if (NumPlanes < 0 || NumPlanes > 4)
+            {
+                Ar.SetError();
+                return;
+            }
+            Result.Planes.SetNum(NumPlanes);
+            Result.Stats.SetNum(NumPlanes);
+        }
+
+        for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; ++PlaneIndex)
+        {
+            SerializePlane(Ar, Result.Planes[PlaneIndex]);
+            SerializeStats(Ar, Result.Stats[PlaneIndex]);
+        }
+    }
+
+    template<typename T>
+    bool SaveFile(const FString& FilePath, T& Value, void (*Serialize)(FArchive&, T&))
+    {
+        const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(FilePath), *FPaths::GetBaseFilename(FilePath), TEXT(".tmp"));
+        {
+            TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath, FILEWRITE_Silent));
+            if (!Writer)
+            {
+                UE_LOG(LogMaskToolsCore, Warning, TEXT("Failed to write %s"), *TempPath);
+                return false;
+            }
+
+            uint32 Magic = FileMagic;
+            uint32 Version = FileVersion;
+            *Writer << Magic << Version;
+            Serialize(*Writer, Value);
+            if (!Writer->Close())
+            {
+                IFileManager::Get().Delete(*TempPath, false, false, true);
+                return false;
+            }
+        }
+
+        if (!IFileManager::Get().Move(*FilePath, *TempPath, true, true, false, true))
+        {
+            IFileManager::Get().Delete(*TempPath, false, false, true);
+            return false;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool LoadFile(const FString& FilePath, T& OutValue, void (*Serialize)(FArchive&, T&))
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent));
+        if (!Reader) return false;
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        *Reader << Magic << Version;
+        if (Magic != FileMagic || Version != FileVersion)
+        {
+            UE_LOG(LogMaskToolsCore, Warning, TEXT("%s was written by another version of MaskToolsWorker"), *FilePath);
+            return false;
+        }
+
+        Serialize(*Reader, OutValue);
+        return Reader->Close() && !Reader->IsError();
+    }
+}
+
+const TCHAR* FMaskToolsWorkerProtocol::TaskExtension = TEXT(".mtask");
+const TCHAR* FMaskToolsWorkerProtocol::ResultExtension = TEXT(".mresult");
+const TCHAR* FMaskToolsWorkerProtocol::QuitFileName = TEXT("Quit");
+
+bool FMaskToolsWorkerProtocol::SaveTask(const FString& FilePath, const FMaskToolsSplitTask& Task)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerProtocol::SaveTask);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    // Saving only reads through the archive
+    return MaskToolsWorkerProtocol::SaveFile(FilePath, const_cast<FMaskToolsSplitTask&>(Task), &MaskToolsWorkerProtocol::SerializeTask);
+}
+
+bool FMaskToolsWorkerProtocol::LoadTask(const FString& FilePath, FMaskToolsSplitTask& OutTask)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerProtocol::LoadTask);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    return MaskToolsWorkerProtocol::LoadFile(FilePath, OutTask, &MaskToolsWorkerProtocol::SerializeTask);
+}
+
+bool FMaskToolsWorkerProtocol::SaveResult(const FString& FilePath, const FMaskToolsSplitResult& Result)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerProtocol::SaveResult);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    return MaskToolsWorkerProtocol::SaveFile(FilePath, const_cast<FMaskToolsSplitResult&>(Result), &MaskToolsWorkerProtocol::SerializeResult);
+}
+
+bool FMaskToolsWorkerProtocol::LoadResult(const FString& FilePath, FMaskToolsSplitResult& OutResult)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerProtocol::LoadResult);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    return MaskToolsWorkerProtocol::LoadFile(FilePath, OutResult, &MaskToolsWorkerProtocol::SerializeResult);
+}
+
+void FMaskToolsWorkerProtocol::RunSplitTask(const FMaskToolsSplitTask& Task, FMaskToolsSplitResult& OutResult)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMaskToolsWorkerProtocol::RunSplitTask);
+    LLM_SCOPE_BYTAG(MaskTools);
+
+    FMaskToolsKernels::Unpack(Task.Image, Task.PlaneFormat, Task.PlaneGamma, OutResult.Planes);
+
+    OutResult.Stats.SetNum(OutResult.Planes.Num());
+    for (int32 ChannelIndex = 0; ChannelIndex < OutResult.Planes.Num(); ++ChannelIndex)
+    {
+        // Match the built texture size, the source can be bigger when MaxTextureSize or LODBias are set
+        if (Task.Image.SizeX != Task.SizeX || Task.Image.SizeY != Task.SizeY)
+        {
+            FMaskPlane ResizedPlane;
+            FMaskToolsKernels::ResizePlane(OutResult.Planes[ChannelIndex], Task.SizeX, Task.SizeY, Task.Filter, ResizedPlane);
+            OutResult.Planes[ChannelIndex] = MoveTemp(ResizedPlane);
+        }
+
+        OutResult.Stats[ChannelIndex] = FMaskToolsKernels::ComputeStats(OutResult.Planes[ChannelIndex]);
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+
+/**
+ * Storage of a single channel plane.
+ */
+enum class EMaskPlaneFormat : uint8
+{
+    U8,
+    U16,
+    F32
+};
+
+/**
+ * Channel of an interleaved RGBA image, in RGBA order.
+ */
+enum class EMaskChannel : uint8
+{
+    Red = 0,
+    Green = 1,
+    Blue = 2,
+    Alpha = 3
+};
+
+/**
+ * How every 2x2 block of a mip is reduced into a texel of the next one.
+ */
+enum class EMaskMipReduction : uint8
+{
+    // Box filter, same as the engine mips
+    Average,
+    // Keeps thin bright features, such as foliage opacity
+    Max,
+    // Keeps thin dark features, such as cavity
+    Min,
+    // Average scaled so as many texels pass the coverage threshold as in the top mip, for alpha tested masks
+    Coverage
+};
+
+/**
+ * GPU block compression an output texture is stored with, from cheapest to most complete.
+ */
+enum class EMaskBlockFormat : uint8
+{
+    // Single channel, 4 bits per pixel
+    BC4,
+    // Opaque RGB, 4 bits per pixel
+    BC1,
+    // RGBA with a simpler alpha, 8 bits per pixel
+    BC3,
+    // Full quality RGBA, 8 bits per pixel
+    BC7,
+    // Uncompressed, for data that can't survive 8 bit quantization
+    // 16 bit single channel
+    G16,
+    // Half float single channel
+    R16F,
+    // Half float RGBA
+    RGBA16F,
+    // Float RGBA, the only RGBA format that keeps 16 bit masks exact, at twice the memory of RGBA16F
+    RGBA32F
+};
+
+MASKTOOLSCORE_API const TCHAR* LexToString(EMaskBlockFormat Format);
+
+/**
+ * A single grayscale channel with its own storage.
+ * Planes always hold data values, so they are viewed as linear images.
+ */
+struct MASKTOOLSCORE_API FMaskPlane
+{
+    // Largest width or height of a mask, the biggest texture the engine can build
+    static constexpr int32 MaxSize = 16384;
+
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    EMaskPlaneFormat Format = EMaskPlaneFormat::U8;
+    TArray64<uint8> RawData;
+
+    FMaskPlane() = default;
+    FMaskPlane(int32 InSizeX, int32 InSizeY, EMaskPlaneFormat InFormat);
+
+    void Init(int32 InSizeX, int32 InSizeY, EMaskPlaneFormat InFormat);
+
+    bool IsValid() const { return SizeX > 0 && SizeY > 0 && RawData.Num() == GetNumPixels() * GetBytesPerPixel(); }
+
+    int64 GetNumPixels() const { return static_cast<int64>(SizeX) * SizeY; }
+
+    int32 GetBytesPerPixel() const { return GetBytesPerPixel(Format); }
+
+    static int32 GetBytesPerPixel(EMaskPlaneFormat InFormat);
+
+    // Single channel raw image format matching a plane format
+    static ERawImageFormat::Type GetRawImageFormat(EMaskPlaneFormat InFormat);
+
+    TArrayView64<uint8> AsU8();
+    TArrayView64<const uint8> AsU8() const;
+
+    TArrayView64<uint16> AsU16();
+    TArrayView64<const uint16> AsU16() const;
+
+    TArrayView64<float> AsF32();
+    TArrayView64<const float> AsF32() const;
+
+    // Moves the plane storage into a single channel image without copying, leaves the plane empty
+    void MoveToImage(FImage& OutImage);
+
+    // Image views don't carry constness, callers must not write through the view of a const plane
+    FImageView AsImageView() const;
+};
+
+/**
+ * Summary of the values stored in a plane, normalized to 0-1.
+ */
+struct MASKTOOLSCORE_API FMaskPlaneStats
+{
+    float Min = 0.f;
+    float Max = 0.f;
+    float Mean = 0.f;
+
+    // True if at least one value is neither fully black nor fully white
+    bool bHasData = false;
+
+    bool bIsConstant = true;
+};
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+#include "MaskPlane.h"
+
+/**
+ * Conversions between linear and sRGB encoded plane values.
+ * 8 and 16 bit values go through lookup tables built once on first use, so a conversion is a single load per value.
+ * Thread safe.
+ */
+struct MASKTOOLSCORE_API FMaskToolsColorSpace
+{
+    /*
+    * Re-encodes every value of a plane from SourceGammaSpace to DestGammaSpace, in place.
+    * Only linear and sRGB are supported, Pow22 images must be converted with the image core beforehand.
+    */
+    static void ConvertPlane(FMaskPlane& Plane, EGammaSpace SourceGammaSpace, EGammaSpace DestGammaSpace);
+
+    // 256 entry tables, indexed by the encoded value
+    static const uint8* GetSRGBToLinearTable8();
+    static const uint8* GetLinearToSRGBTable8();
+
+    // 65536 entry tables, indexed by the encoded value
+    static const uint16* GetSRGBToLinearTable16();
+    static const uint16* GetLinearToSRGBTable16();
+
+    // Exact curves on normalized values, used to build the tables and for float planes
+    static float SRGBToLinear(float Value);
+    static float LinearToSRGB(float Value);
+};
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "MaskPlane.h"
+
+#include <atomic>
+
+/**
+ * Content addressed cache of computed planes in Saved/MaskToolsCache.
+ * Keys are built from the source content hash and every parameter that affects the plane,
+ * so identical work done on another branch or in another session is read back instead of recomputed.
+ * Entries are compressed, the least recently used ones are evicted once the cache is over its size cap.
+ * Thread safe.
+ */
+class MASKTOOLSCORE_API FMaskToolsDiskCache
+{
+public:
+    static FMaskToolsDiskCache& Get();
+
+    /*
+    * A cache in its own folder, Saved/MaskToolsCache when InCacheDir is empty as for the shared one. Used by the tests.
+    */
+    explicit FMaskToolsDiskCache(const FString& InCacheDir = FString());
+
+    /*
+    * Version of the kernels that compute cached planes, part of every key.
+    * Bump it whenever a change to the conversion, resize or unpack kernels changes the planes they produce,
+    * so entries computed by older kernels are never read back.
+    */
+    static constexpr uint32 KernelVersion = 4;
+
+    /*
+    * Disabling keeps the existing entries on disk, MaxSizeBytes is enforced on the next store.
+    */
+    void Configure(bool bInEnabled, int64 InMaxSizeBytes);
+
+    bool IsEnabled() const { return bEnabled; }
+
+    /*
+    * Builds a key from a source content hash, the kernel version and a description of the operation parameters.
+    * Returns an empty key when SourceHash is empty, which every other call treats as uncacheable.
+    */
+    static FString MakeKey(const FString& SourceHash, const FString& Parameters);
+
+    bool Load(const FString& Key, FMaskPlane& OutPlane, FMaskPlaneStats* OutStats = nullptr);
+
+    void Store(const FString& Key, const FMaskPlane& Plane, const FMaskPlaneStats& Stats);
+
+    // Deletes every entry
+    void Clear();
+
+    FString GetCacheDir() const;
+
+private:
+    FString GetEntryPath(const FString& Key) const;
+
+    void EvictIfNeeded();
+
+    std::atomic<bool> bEnabled { true };
+    std::atomic<int64> MaxSizeBytes { 2048ll * 1024 * 1024 };
+
+    FString CacheDir;
+
+    // Estimated size of the cache folder, -1 until scanned
+    int64 CurrentSizeBytes = -1;
+    FCriticalSection SizeLock;
+};
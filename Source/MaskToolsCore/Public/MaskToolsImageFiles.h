@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+
+/**
+ * Image file format and bit depth masks are written to outside of the content browser.
+ */
+enum class EMaskImageFileFormat : uint8
+{
+    PNG8,
+    PNG16,
+    TGA,
+    // Half float
+    EXR
+};
+
+/**
+ * Reads and writes images straight from and to disk through the image wrapper module, without any asset.
+ */
+struct MASKTOOLSCORE_API FMaskToolsImageFiles
+{
+    // Extension including the dot
+    static const TCHAR* GetExtension(EMaskImageFileFormat Format);
+
+    /*
+    * Converts Image to the bit depth of Format, encodes it and writes it to FilePath, creating the folders.
+    * Thread safe once the image wrapper module is loaded, see SaveImages.
+    */
+    static bool SaveImage(const FImageView& Image, const FString& FilePath, EMaskImageFileFormat Format);
+
+    /*
+    * Encodes and writes every image concurrently on the task graph workers.
+    * Images and FilePaths are matched by index. Returns the number of files written.
+    */
+    static int32 SaveImages(TArrayView<const FImageView> Images, TArrayView<const FString> FilePaths, EMaskImageFileFormat Format);
+
+    /*
+    * Reads and decodes any format the image wrapper module knows. Thread safe under the same conditions as SaveImage.
+    * Files are read as linear data whatever their bit depth, set the gamma space of OutImage for color files.
+    */
+    static bool LoadImage(const FString& FilePath, FImage& OutImage);
+
+    /*
+    * Reads and decodes every file concurrently. OutImages matches FilePaths, failed files are left empty.
+    * Returns the number of files decoded.
+    */
+    static int32 LoadImages(TArrayView<const FString> FilePaths, TArray<FImage>& OutImages);
+};
+
+/**
+ * Queues images and writes them concurrently once enough memory is held, on Flush, or when destroyed.
+ * Lets a long batch encode many files at once without keeping every image alive until the end.
+ */
+class MASKTOOLSCORE_API FMaskToolsImageFileBatch
+{
+public:
+    explicit FMaskToolsImageFileBatch(EMaskImageFileFormat InFormat, int64 InMaxQueuedBytes = 512ll * 1024 * 1024);
+    ~FMaskToolsImageFileBatch();
+
+    void Add(FImage&& Image, const FString& FilePath);
+
+    // Writes every queued image, returns the number written
+    int32 Flush();
+
+    int32 GetNumSaved() const { return NumSaved; }
+    int32 GetNumFailed() const { return NumFailed; }
+
+private:
+    EMaskImageFileFormat Format;
+    int64 MaxQueuedBytes;
+    int64 QueuedBytes = 0;
+
+    TArray<FImage> QueuedImages;
+    TArray<FString> QueuedPaths;
+
+    int32 NumSaved = 0;
+    int32 NumFailed = 0;
+};
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+#include "MaskPlane.h"
+
+/**
+ * Pixel kernels working on image views and planes only.
+ * None of them touch UObjects or editor state, so they are safe to call from any thread.
+ */
+struct MASKTOOLSCORE_API FMaskToolsKernels
+{
+    /*
+    * Converts an image to another raw format and gamma space.
+    */
+    static void ConvertImage(const FImageView& Image, ERawImageFormat::Type DestFormat, EGammaSpace DestGammaSpace, FImage& OutImage);
+
+    /*
+    * Resizes an image to the given size keeping its format and gamma space.
+    */
+    static void ResizeImage(const FImageView& Image, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FImage& OutImage);
+
+    /*
+    * Resizes a plane to the given size keeping its format, with the separable resampler of FMaskToolsResampler.
+    */
+    static void ResizePlane(const FMaskPlane& Plane, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane);
+
+    /*
+    * Resizes a plane to several sizes at once, OutPlanes[i] holding Sizes[i].
+    * Sizes are computed from the largest down, each from the smallest level already computed that covers it,
+    * so a 4096, 1024 and 512 chain costs little more than the 4096 alone.
+    */
+    static void ResizePlaneChain(const FMaskPlane& Plane, TConstArrayView<FIntPoint> Sizes, FImageCore::EResizeImageFilter Filter, TArray<FMaskPlane>& OutPlanes);
+
+    /*
+    * Copies one channel of an image into a plane, encoded in GammaSpace.
+    * Values are decoded from the gamma space of the image with lookup tables at the plane precision,
+    * and copied untouched when both spaces match. A linear source therefore survives a split and pack round trip exactly,
+    * while an sRGB one is decoded to linear by the pack and only comes back within the 8 bit rounding of the curve.
+    */
+    static void ExtractPlane(const FImageView& Image, EMaskChannel Channel, EMaskPlaneFormat Format, EGammaSpace GammaSpace, FMaskPlane& OutPlane);
+
+    /*
+    * Copies one channel of an image into a plane of the given size.
+    * Only that channel is resized, after it is decoded, instead of the whole RGBA image.
+    * The channel is decoded and resized in float and only quantized to Format once resized.
+    */
+    static void ExtractResizedPlane(const FImageView& Image, EMaskChannel Channel, EMaskPlaneFormat Format, EGammaSpace GammaSpace,
+        int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane);
+
+    /*
+    * Copies every channel of an image into its own plane encoded in GammaSpace, in RGBA order.
+    */
+    static void Unpack(const FImageView& Image, EMaskPlaneFormat Format, EGammaSpace GammaSpace, TArray<FMaskPlane>& OutPlanes);
+
+    /*
+    * Interleaves up to four planes of the same size and format into an RGBA image.
+    * Null planes are filled with black, or white for alpha. 8 bit planes produce BGRA8,
+    * 16 bit planes RGBA16 and float planes RGBA32F.
+    */
+    static bool Pack(TArrayView<const FMaskPlane* const> Planes, FImage& OutImage);
+
+    /*
+    * Converts a plane to another storage format.
+    */
+    static void ConvertPlane(const FMaskPlane& Plane, EMaskPlaneFormat DestFormat, FMaskPlane& OutPlane);
+
+    static FMaskPlaneStats ComputeStats(const FMaskPlane& Plane);
+
+    /*
+    * Builds the mips of a plane down to 1x1, the top mip excluded, each one halving the previous with Reduction.
+    * Mip sizes follow the engine, odd sides drop their last row or column.
+    * CoverageThreshold, from 0 to 1, is only used by Coverage.
+    */
+    static void BuildMipChain(const FMaskPlane& Plane, EMaskMipReduction Reduction, float CoverageThreshold, TArray<FMaskPlane>& OutMips);
+
+    /*
+    * Builds the mips of up to four planes of the same size in parallel, with the reduction of each plane,
+    * and interleaves every mip like Pack. A single plane gives single channel mips instead.
+    */
+    static bool BuildMipImages(TArrayView<const FMaskPlane* const> Planes, TArrayView<const EMaskMipReduction> Reductions, float CoverageThreshold,
+        TArray<FImage>& OutMips);
+
+    /*
+    * Cheapest block format that keeps every channel carrying data, from the stats of the channels in RGBA order.
+    * A single channel format is only chosen when green and blue are exactly 0 and alpha opaque, BC1 drops an opaque alpha.
+    * 16 bit and float planes always get an uncompressed format: G16 or RGBA32F for 16 bit, which keep every value exact,
+    * R16F or RGBA16F for float.
+    */
+    static EMaskBlockFormat ChooseBlockFormat(TArrayView<const FMaskPlaneStats> ChannelStats, EMaskPlaneFormat Format = EMaskPlaneFormat::U8);
+
+    /*
+    * For every plane, index of the first earlier plane holding exactly the same values, or INDEX_NONE.
+    * Planes are compared by hash and confirmed byte for byte.
+    */
+    static void FindDuplicatePlanes(TArrayView<const FMaskPlane> Planes, TArray<int32>& OutDuplicateOf);
+};
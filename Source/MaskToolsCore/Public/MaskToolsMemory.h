@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "MaskPlane.h"
+
+#include <atomic>
+
+/**
+ * Keeps the highest growth of the process working set over the value it started with, for the peak memory
+ * of operation summaries and benchmarks. Samples are taken on the core ticker at a coarse interval and every
+ * time a MaskTools kernel allocates an image or plane, which is where the working set grows, so no thread
+ * has to poll in the background.
+ */
+class MASKTOOLSCORE_API FMaskToolsPeakMemoryTracker
+{
+public:
+    FMaskToolsPeakMemoryTracker();
+    ~FMaskToolsPeakMemoryTracker();
+
+    FMaskToolsPeakMemoryTracker(const FMaskToolsPeakMemoryTracker&) = delete;
+    FMaskToolsPeakMemoryTracker& operator=(const FMaskToolsPeakMemoryTracker&) = delete;
+
+    /*
+    * Stops sampling and returns the peak growth in bytes. Calling it again returns the same value.
+    */
+    int64 Stop();
+
+    // Seconds since the tracker started, frozen once stopped
+    double GetElapsedSeconds() const;
+
+    /*
+    * Samples the working set into every running tracker. Called from any thread right after a large allocation,
+    * costs nothing while no tracker is running.
+    */
+    static void SampleAll();
+
+private:
+    void Sample(uint64 UsedPhysical);
+
+    const uint64 Baseline;
+    std::atomic<uint64> Peak;
+    const double StartTime;
+    double StopTime = 0.0;
+    bool bStopped = false;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
+
+/**
+ * Working set estimates used to keep large batches under a memory budget.
+ */
+struct MASKTOOLSCORE_API FMaskToolsMemory
+{
+    /*
+    * Half of the physical memory of the machine.
+    */
+    static int64 GetDefaultBudget();
+
+    /*
+    * Peak bytes held while splitting a SizeX by SizeY source of SourceBytesPerPixel into Format planes:
+    * the source, its interleaved copy in the plane format, the four planes, the four channels of each of ResizedSizes
+    * and, with bWithMips, the mip chains of every one of them, a third of their size.
+    */
+    static int64 EstimateSplitMemory(int32 SizeX, int32 SizeY, int32 SourceBytesPerPixel, EMaskPlaneFormat Format,
+        bool bWithMips = false, TConstArrayView<FIntPoint> ResizedSizes = {});
+};
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+
+class FEvent;
+class FMaskToolsProgress;
+
+/**
+ * Base of the jobs flowing through a pipeline, derived by each operation to carry its own state between stages.
+ * Jobs are always destroyed on the game thread, so they can hold UObject references.
+ */
+struct FMaskToolsPipelineJob
+{
+    virtual ~FMaskToolsPipelineJob() = default;
+
+    // Bytes the job is expected to hold at its peak, set by AddJob
+    int64 MemoryCost = 0;
+};
+
+enum class EMaskPipelineThread : uint8
+{
+    // Loading, package creation and PostEditChange, run between editor frames or while waiting
+    GameThread,
+    // Pixel work, run on the thread pool
+    Worker
+};
+
+/**
+ * Runs jobs through stages connected by bounded queues, so game thread stages and worker stages of different jobs
+ * overlap. A stage only takes a job when the queue in front of the next stage has room, and no more than MaxInFlight
+ * jobs are admitted at once, which bounds the large images held in memory whatever the size of the batch.
+ * With a memory budget, jobs are also only admitted while the cost of the jobs in flight fits in it, so batches
+ * of large sources run fewer jobs at once instead of swapping.
+ * A stage returning false drops its job. Jobs leave in completion order, not in the order they were added.
+ * Must be created with MakeShared, it keeps itself alive until every job left.
+ */
+class MASKTOOLSCORE_API FMaskToolsPipeline : public TSharedFromThis<FMaskToolsPipeline, ESPMode::ThreadSafe>
+{
+public:
+    using FStageFunction = TFunction<bool(FMaskToolsPipelineJob&)>;
+
+    explicit FMaskToolsPipeline(const FString& InName, int32 InMaxInFlight = 4);
+    ~FMaskToolsPipeline();
+
+    FMaskToolsPipeline(const FMaskToolsPipeline&) = delete;
+    FMaskToolsPipeline& operator=(const FMaskToolsPipeline&) = delete;
+
+    // Appends a stage. Capacity bounds the jobs waiting in front of it. Before Start only
+    void AddStage(const FString& StageName, EMaskPipelineThread Thread, FStageFunction Function, int32 Capacity = 2);
+
+    /*
+    * Bytes the jobs in flight may hold together, 0 for no limit. A job costing more than the whole budget
+    * still runs, alone. Before Start only
+    */
+    void SetMemoryBudget(int64 InMemoryBudget);
+
+    /*
+    * Counts one unit of work per job, completed when the job leaves the pipeline.
+    * Once cancelled, jobs not admitted yet are dropped and the pipeline completes as soon as the others left.
+    * Before Start only
+    */
+    void SetProgress(TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> InProgress);
+
+    // Queues a job, admitted as soon as the in flight and memory limits allow. Game thread only
+    void AddJob(TUniquePtr<FMaskToolsPipelineJob> Job, int64 MemoryCost = 0);
+
+    /*
+    * Runs the game thread stages from the core ticker, a few milliseconds per frame so the editor stays responsive.
+    * OnCompleted runs on the game thread once every job left the pipeline.
+    */
+    void Start(TFunction<void()> InOnCompleted = nullptr);
+
+    // Runs the game thread stages until every job left the pipeline, starting it if needed. Game thread only
+    void Wait();
+
+    bool IsDone() const;
+
+    // Jobs that went through every stage
+    int32 GetNumCompleted() const;
+
+    // Jobs a stage returned false for
+    int32 GetNumDropped() const;
+
+    // Jobs never admitted because the progress was cancelled
+    int32 GetNumCancelled() const;
+
+private:
+    struct FStage
+    {
+        FString Name;
+        EMaskPipelineThread Thread = EMaskPipelineThread::Worker;
+        FStageFunction Function;
+        int32 Capacity = 2;
+        TArray<TUniquePtr<FMaskToolsPipelineJob>> Queue;
+        int32 NumRunning = 0;
+    };
+
+    // Admits pending jobs and launches the worker stages that have room. Any thread
+    void Schedule();
+
+    // Runs game thread stages until Deadline or until none can run, returns false if none ran
+    bool PumpGameThread(double Deadline);
+
+    // Hands a job to the next stage, or retires it
+    void CompleteStage(int32 StageIndex, TUniquePtr<FMaskToolsPipelineJob> Job, bool bKeep);
+
+    // Must hold Lock
+    bool CanStart(int32 StageIndex) const;
+
+    bool Tick(float DeltaTime);
+    void Finish();
+
+    const FString Name;
+    const int32 MaxInFlight;
+
+    TArray<FStage> Stages;
+    TArray<TUniquePtr<FMaskToolsPipelineJob>> PendingJobs;
+    int32 NextPendingJob = 0;
+    int32 NumInFlight = 0;
+    int64 MemoryBudget = 0;
+    int64 MemoryInFlight = 0;
+    int64 PeakMemoryInFlight = 0;
+    // Admissions held back by the memory budget while the in flight limit had room
+    int32 NumMemoryDeferrals = 0;
+    int32 NumCompleted = 0;
+    int32 NumDropped = 0;
+    int32 NumCancelled = 0;
+
+    // Retired jobs, destroyed on the game thread
+    TArray<TUniquePtr<FMaskToolsPipelineJob>> RetiredJobs;
+
+    mutable FCriticalSection Lock;
+
+    // Wakes a waiting game thread when a worker stage finishes
+    FEvent* WorkerEvent = nullptr;
+
+    TSharedPtr<FMaskToolsProgress, ESPMode::ThreadSafe> Progress;
+    TFunction<void()> OnCompleted;
+    FTSTicker::FDelegateHandle TickerHandle;
+    TSharedPtr<FMaskToolsPipeline, ESPMode::ThreadSafe> SelfReference;
+    bool bStarted = false;
+    bool bPumping = false;
+    bool bFinished = false;
+};
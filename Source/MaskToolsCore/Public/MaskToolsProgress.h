@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include <atomic>
+
+/**
+ * Progress and cancellation of a batch, shared by every thread working on it.
+ * Work is counted in arbitrary units, usually one per texture. Anything can update it and poll IsCancelled,
+ * the editor shows it in a single notification per batch instead of one dialog per texture.
+ */
+class MASKTOOLSCORE_API FMaskToolsProgress
+{
+public:
+    explicit FMaskToolsProgress(int64 InTotalWork = 0);
+
+    void AddTotalWork(int64 Work);
+    void AddCompletedWork(int64 Work);
+
+    int64 GetTotalWork() const { return TotalWork.load(); }
+    int64 GetCompletedWork() const { return CompletedWork.load(); }
+
+    // What is being worked on, such as the texture being split
+    void SetStatus(const FString& InStatus);
+    FString GetStatus() const;
+
+    /*
+    * Asks the operation to stop. Work already started finishes, so no output is left half written,
+    * but nothing new is started.
+    */
+    void Cancel() { bCancelled = true; }
+    bool IsCancelled() const { return bCancelled.load(); }
+
+private:
+    std::atomic<int64> TotalWork { 0 };
+    std::atomic<int64> CompletedWork { 0 };
+    std::atomic<bool> bCancelled { false };
+
+    mutable FCriticalSection StatusLock;
+    FString Status;
+};
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ImageCore.h"
+#include "MaskPlane.h"
+
+/**
+ * Filter taps of every destination pixel along one axis, NumTaps per pixel.
+ * Source indices are already clamped or wrapped, unused taps have a zero weight.
+ */
+struct FMaskResampleWeights
+{
+    int32 NumTaps = 0;
+    TArray<int32> Indices;
+    TArray<float> Weights;
+};
+
+/**
+ * Separable resampler for single channel planes.
+ * Rows and then columns are filtered in parallel with weights computed once per source size, destination size
+ * and filter, so resizing a channel costs a quarter of resizing the RGBA image it comes from.
+ * Follows the filters of FImageCore::ResizeImage, adaptive ones pick their filter per axis.
+ * Flag_WrapX and Flag_WrapY make taps past an edge read the opposite side, so tiling planes stay seamless
+ * without a padded copy.
+ * Thread safe.
+ */
+class MASKTOOLSCORE_API FMaskToolsResampler
+{
+public:
+    static FMaskToolsResampler& Get();
+
+    void Resize(const FMaskPlane& Plane, int32 DestSizeX, int32 DestSizeY, FImageCore::EResizeImageFilter Filter, FMaskPlane& OutPlane);
+
+    // Drops the cached weights
+    void ClearWeights();
+
+private:
+    using FWeightsRef = TSharedRef<const FMaskResampleWeights, ESPMode::ThreadSafe>;
+
+    // Null when the axis is copied untouched
+    TSharedPtr<const FMaskResampleWeights, ESPMode::ThreadSafe> GetWeights(int32 SourceSize, int32 DestSize, FImageCore::EResizeImageFilter Filter, bool bWrap);
+
+    // Keyed on source size, destination size, edge mode and the filter resolved for the axis
+    TMap<uint64, FWeightsRef> CachedWeights;
+    FCriticalSection WeightsLock;
+};
@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Stats/Stats.h"
+
+/*
+* Counters shared by every MaskTools module, visible with "stat MaskTools" and in Unreal Insights.
+* All of them are running totals for the editor session.
+*/
+DECLARE_STATS_GROUP(TEXT("MaskTools"), STATGROUP_MaskTools, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pixels Processed"), STAT_MaskToolsPixelsProcessed, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+// Cumulative, buffers are never subtracted when freed. The LLM tag below has the live amount
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Allocated (Cumulative)"), STAT_MaskToolsBytesAllocatedTotal, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cache Hits"), STAT_MaskToolsCacheHits, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cache Misses"), STAT_MaskToolsCacheMisses, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Textures Created"), STAT_MaskToolsTexturesCreated, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Textures Unchanged"), STAT_MaskToolsTexturesUnchanged, STATGROUP_MaskTools, MASKTOOLSCORE_API);
+
+/*
+* Low Level Memory tracker tag for everything allocated by the MaskTools modules.
+* Scope allocations with LLM_SCOPE_BYTAG(MaskTools) and inspect them with -llm.
+*/
+LLM_DECLARE_TAG_API(MaskTools, MASKTOOLSCORE_API);
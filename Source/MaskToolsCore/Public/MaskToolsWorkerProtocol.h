@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageCore.h"
+#include "MaskPlane.h"
+
+/**
+ * Decode of one texture to split: its four channels unpacked from Image and resized to SizeX by SizeY.
+ */
+struct MASKTOOLSCORE_API FMaskToolsSplitTask
+{
+    // Source pixels, read in their own gamma space
+    FImage Image;
+    EMaskPlaneFormat PlaneFormat = EMaskPlaneFormat::U8;
+    EGammaSpace PlaneGamma = EGammaSpace::Linear;
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    FImageCore::EResizeImageFilter Filter = FImageCore::EResizeImageFilter::Default;
+};
+
+struct MASKTOOLSCORE_API FMaskToolsSplitResult
+{
+    // Channel planes and their stats, in RGBA order
+    TArray<FMaskPlane> Planes;
+    TArray<FMaskPlaneStats> Stats;
+};
+
+/**
+ * Files exchanged with the MaskToolsWorker program, and the work it runs on them.
+ * The editor writes tasks into the working directory of a worker, which answers each one with a result file
+ * of the same name. Both are written aside and moved in place, so neither side ever reads a partial file.
+ */
+struct MASKTOOLSCORE_API FMaskToolsWorkerProtocol
+{
+    static const TCHAR* TaskExtension;
+    static const TCHAR* ResultExtension;
+
+    // Written by the editor into a working directory to stop its worker
+    static const TCHAR* QuitFileName;
+
+    static bool SaveTask(const FString& FilePath, const FMaskToolsSplitTask& Task);
+    static bool LoadTask(const FString& FilePath, FMaskToolsSplitTask& OutTask);
+
+    static bool SaveResult(const FString& FilePath, const FMaskToolsSplitResult& Result);
+    static bool LoadResult(const FString& FilePath, FMaskToolsSplitResult& OutResult);
+
+    /*
+    * Unpacks and resizes the channels of a split task and computes their stats.
+    * Run by the worker, or in the editor when no worker is used.
+    */
+    static void RunSplitTask(const FMaskToolsSplitTask& Task, FMaskToolsSplitResult& OutResult);
+};
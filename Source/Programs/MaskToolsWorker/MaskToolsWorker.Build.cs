@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+using UnrealBuildTool;
+
+public class MaskToolsWorker : ModuleRules
+{
+	public MaskToolsWorker(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateIncludePathModuleNames.Add("Launch");
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"ImageCore",
+				"Projects",
+				"MaskToolsCore"
+			}
+			);
+	}
+}
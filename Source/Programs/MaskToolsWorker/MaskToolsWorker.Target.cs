@@ -0,0 +1,29 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+using UnrealBuildTool;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class MaskToolsWorkerTarget : TargetRules
+{
+	public MaskToolsWorkerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "MaskToolsWorker";
+		DefaultBuildSettings = BuildSettingsVersion.Latest;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+
+		// Only Core, ImageCore and the plugin core module, no engine, editor or UI
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bBuildDeveloperTools = false;
+		bCompileICU = false;
+		bUsesSlate = false;
+		bIsBuildingConsoleApplication = true;
+		bUseLoggingInShipping = true;
+
+		EnablePlugins.Add("MaskTools");
+	}
+}
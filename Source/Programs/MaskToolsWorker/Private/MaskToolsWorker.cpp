@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Sora Mas
+// All rights reserved.
+
+#include "RequiredProgramMainCPPInclude.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "MaskToolsWorkerProtocol.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMaskToolsWorker, Log, All);
+
+IMPLEMENT_APPLICATION(MaskToolsWorker, "MaskToolsWorker");
+
+namespace MaskToolsWorker
+{
+    // How long an idle worker sleeps before looking for tasks again
+    constexpr float IdleSleepSeconds = 0.01f;
+
+    /*
+    * Runs every task found in WorkingDirectory, oldest first, until the editor writes the quit file or exits.
+    * A task is only deleted once its result is written, so a crash leaves it behind for the editor to report.
+    */
+    void Run(const FString& WorkingDirectory, uint32 ParentProcessId)
+    {
+        const FString QuitFilePath = WorkingDirectory / FMaskToolsWorkerProtocol::QuitFileName;
+
+        while (!IFileManager::Get().FileExists(*QuitFilePath) && (ParentProcessId == 0 || FPlatformProcess::IsApplicationRunning(ParentProcessId)))
+        {
+            TArray<FString> TaskFiles;
+            IFileManager::Get().FindFiles(TaskFiles, *(WorkingDirectory / TEXT("*") + FMaskToolsWorkerProtocol::TaskExtension), true, false);
+            if (TaskFiles.Num() == 0)
+            {
+                FPlatformProcess::Sleep(IdleSleepSeconds);
+                continue;
+            }
+
+            TaskFiles.Sort();
+            for (const FString& TaskFile : TaskFiles)
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(MaskToolsWorker::RunTask);
+
+                const FString TaskPath = WorkingDirectory / TaskFile;
+                const FString ResultPath = FPaths::ChangeExtension(TaskPath, FMaskToolsWorkerProtocol::ResultExtension);
+
+                FMaskToolsSplitTask Task;
+                FMaskToolsSplitResult Result;
+                if (FMaskToolsWorkerProtocol::LoadTask(TaskPath, Task))
+                {
+                    FMaskToolsWorkerProtocol::RunSplitTask(Task, Result);
+                }
+                else
+                {
+                    UE_LOG(LogMaskToolsWorker, Warning, TEXT("Failed to read task %s"), *TaskPath);
+                }
+
+                // An empty result tells the editor the task failed
+                FMaskToolsWorkerProtocol::SaveResult(ResultPath, Result);
+                IFileManager::Get().Delete(*TaskPath, false, false, true);
+            }
+        }
+    }
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    FTaskTagScope Scope(ETaskTag::EGameThread);
+    ON_SCOPE_EXIT
+    {
+        FEngineLoop::AppPreExit();
+        FModuleManager::Get().UnloadModulesAtShutdown();
+        FEngineLoop::AppExit();
+    };
+
+    if (GEngineLoop.PreInit(ArgC, ArgV) != 0)
+    {
+        return 1;
+    }
+
+    // MaskToolsWorker <WorkingDirectory> -ParentPID=<Id>
+    FString WorkingDirectory;
+    if (!FParse::Token(FCommandLine::Get(), WorkingDirectory, false) || !IFileManager::Get().DirectoryExists(*WorkingDirectory))
+    {
+        UE_LOG(LogMaskToolsWorker, Error, TEXT("Usage: MaskToolsWorker <WorkingDirectory> -ParentPID=<Id>"));
+        return 1;
+    }
+
+    uint32 ParentProcessId = 0;
+    FParse::Value(FCommandLine::Get(), TEXT("-ParentPID="), ParentProcessId);
+
+    UE_LOG(LogMaskToolsWorker, Display, TEXT("Waiting for tasks in %s"), *WorkingDirectory);
+    MaskToolsWorker::Run(WorkingDirectory, ParentProcessId);
+    return 0;
+}